@@ -42,6 +42,8 @@ protected:
     { std::cout << "Add order: " << order << std::endl; }
     void onUpdateOrder(const Order& order) override
     { std::cout << "Update order: " << order << std::endl; }
+    void onReplaceOrder(const Order& old_order, const Order& order) override
+    { std::cout << "Replace order: " << old_order << " with " << order << std::endl; }
     void onDeleteOrder(const Order& order) override
     { std::cout << "Delete order: " << order << std::endl; }
 
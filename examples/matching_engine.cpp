@@ -42,8 +42,12 @@ protected:
     { std::cout << "Add order: " << order << std::endl; }
     void onUpdateOrder(const Order& order) override
     { std::cout << "Update order: " << order << std::endl; }
+    void onReplaceOrder(const Order& old_order, const Order& order) override
+    { std::cout << "Replace order: " << old_order << " with " << order << std::endl; }
     void onDeleteOrder(const Order& order) override
     { std::cout << "Delete order: " << order << std::endl; }
+    void onDeleteOrders(const OrderBook& order_book, size_t orders, uint64_t volume) override
+    { std::cout << "Delete orders: " << order_book << " with count " << orders << " and volume " << volume << std::endl; }
 
     void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override
     { std::cout << "Execute order: " << order << " with price " << price << " and quantity " << quantity << std::endl; }
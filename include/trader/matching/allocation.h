@@ -0,0 +1,77 @@
+/*!
+    \file allocation.h
+    \brief Allocation policy definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_ALLOCATION_H
+#define CPPTRADER_MATCHING_ALLOCATION_H
+
+#include "types.h"
+
+#include "utility/iostream.h"
+
+#include <cstdint>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Allocation type
+/*!
+    Allocation type defines how the incoming order quantity is allocated
+    across orders of the matched price level when the price level volume
+    is greater than the incoming order quantity.
+
+    \li <b>FIFO</b> - Orders are filled in the price-time priority.
+    \li <b>Pro-rata</b> - Each order gets the integer part of the incoming
+        quantity proportional to its leaves quantity, the rounding residual is
+        allocated by one to orders with the largest remainders (ties in the time
+        priority). Residual of allocations less than the minimal quantity is
+        filled in the time priority.
+    \li <b>Size priority</b> - The largest order is filled first, orders with
+        the same size are filled in the time priority.
+*/
+enum class AllocationType : uint8_t
+{
+    FIFO,
+    PRO_RATA,
+    SIZE_PRIORITY
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, AllocationType type);
+
+//! Allocation policy
+/*!
+    Allocation policy of the order book.
+
+    Not thread-safe.
+*/
+struct Allocation
+{
+    //! Allocation type
+    AllocationType Type;
+    //! Fill the first order of the price level in time priority before the allocation
+    bool TopOrderPriority;
+    //! Minimal pro-rata allocation (smaller pro-rata allocations are moved to the residual)
+    quantity_t MinQuantity;
+
+    Allocation(AllocationType type = AllocationType::FIFO, bool top_order_priority = false, uint64_t min_quantity = 0) noexcept
+        : Type(type), TopOrderPriority(top_order_priority), MinQuantity(SaturateQuantity(min_quantity))
+    {}
+    Allocation(const Allocation&) noexcept = default;
+    Allocation(Allocation&&) noexcept = default;
+    ~Allocation() noexcept = default;
+
+    Allocation& operator=(const Allocation&) noexcept = default;
+    Allocation& operator=(Allocation&&) noexcept = default;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "allocation.inl"
+
+#endif // CPPTRADER_MATCHING_ALLOCATION_H
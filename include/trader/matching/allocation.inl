@@ -0,0 +1,34 @@
+/*!
+    \file allocation.inl
+    \brief Allocation policy inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, AllocationType type)
+{
+    switch (type)
+    {
+        case AllocationType::FIFO:
+            stream << "FIFO";
+            break;
+        case AllocationType::PRO_RATA:
+            stream << "PRO_RATA";
+            break;
+        case AllocationType::SIZE_PRIORITY:
+            stream << "SIZE_PRIORITY";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,54 @@
+/*!
+    \file auction.h
+    \brief Order book auction definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_AUCTION_H
+#define CPPTRADER_MATCHING_AUCTION_H
+
+#include "types.h"
+
+#include <cstdint>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Order book auction
+/*!
+    Order book auction is an indicative state of the call auction for the
+    crossed order book: equilibrium price which maximizes executable volume
+    and minimizes imbalance, executable volume and bid/ask volume eligible
+    for the execution at the equilibrium price.
+
+    Not thread-safe.
+*/
+struct Auction
+{
+    //! Equilibrium price (zero if the order book cannot be uncrossed)
+    price_t Price;
+    //! Executable volume at the equilibrium price
+    uint64_t Volume;
+    //! Bid volume at the equilibrium price or higher
+    uint64_t BidVolume;
+    //! Ask volume at the equilibrium price or lower
+    uint64_t AskVolume;
+
+    Auction() noexcept : Price(0), Volume(0), BidVolume(0), AskVolume(0) {}
+    Auction(const Auction&) noexcept = default;
+    Auction(Auction&&) noexcept = default;
+    ~Auction() noexcept = default;
+
+    Auction& operator=(const Auction&) noexcept = default;
+    Auction& operator=(Auction&&) noexcept = default;
+
+    //! Get the auction imbalance (positive for the buy side surplus, negative for the sell side surplus)
+    int64_t Imbalance() const noexcept { return (int64_t)BidVolume - (int64_t)AskVolume; }
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#endif // CPPTRADER_MATCHING_AUCTION_H
@@ -0,0 +1,127 @@
+/*!
+    \file bbo.h
+    \brief Order book best bid and offer definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_BBO_H
+#define CPPTRADER_MATCHING_BBO_H
+
+#include "types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Order book best bid and offer
+/*!
+    Best bid and offer snapshot of the order book: price, total volume and
+    orders count of the best bid and the best ask price levels. Empty side
+    of the order book has zero price, volume and orders count.
+*/
+struct BBO
+{
+    //! Best bid price
+    price_t BidPrice;
+    //! Best bid total volume
+    volume_t BidVolume;
+    //! Best bid orders count
+    size_t BidOrders;
+    //! Best ask price
+    price_t AskPrice;
+    //! Best ask total volume
+    volume_t AskVolume;
+    //! Best ask orders count
+    size_t AskOrders;
+
+    BBO() noexcept : BidPrice(0), BidVolume(0), BidOrders(0), AskPrice(0), AskVolume(0), AskOrders(0) {}
+    BBO(const BBO&) noexcept = default;
+    BBO(BBO&&) noexcept = default;
+    ~BBO() noexcept = default;
+
+    BBO& operator=(const BBO&) noexcept = default;
+    BBO& operator=(BBO&&) noexcept = default;
+
+    //! Is the best bid present?
+    bool IsBid() const noexcept { return BidVolume > 0; }
+    //! Is the best ask present?
+    bool IsAsk() const noexcept { return AskVolume > 0; }
+};
+
+//! Order book best bid and offer block
+/*!
+    Best bid and offer block is published by the order book owner thread
+    under the sequence lock each time the top of the order book is changed.
+    The block takes its own cache line, so readers from other threads poll
+    it without contention with the order book data and with each other.
+
+    Reader retries while the block is being published and returns the
+    consistent snapshot. Readers never block the publisher.
+
+    Thread-safe for one publisher and many readers.
+*/
+class alignas(64) BBOBlock
+{
+    friend class OrderBook;
+
+public:
+    BBOBlock() noexcept;
+    BBOBlock(const BBOBlock&) = delete;
+    BBOBlock(BBOBlock&&) = delete;
+    ~BBOBlock() = default;
+
+    BBOBlock& operator=(const BBOBlock&) = delete;
+    BBOBlock& operator=(BBOBlock&&) = delete;
+
+    //! Get the block version
+    /*!
+        Version is incremented by two with each publication and is odd while
+        the block is being published. Readers could poll the version to detect
+        changes before reading the snapshot.
+
+        \return Block version
+    */
+    uint64_t version() const noexcept { return _sequence.load(std::memory_order_acquire); }
+
+    //! Read the consistent best bid and offer snapshot
+    /*!
+        Spins while the block is being published.
+
+        \return Best bid and offer snapshot
+    */
+    BBO Read() const noexcept;
+    //! Try to read the consistent best bid and offer snapshot
+    /*!
+        \param bbo - Best bid and offer snapshot
+        \param attempts - Count of read attempts
+        \return 'true' if the consistent snapshot was read, 'false' if all attempts overlapped with the publisher
+    */
+    bool TryRead(BBO& bbo, size_t attempts = 1) const noexcept;
+
+private:
+    std::atomic<uint64_t> _sequence;
+    std::atomic<price_t> _bid_price;
+    std::atomic<volume_t> _bid_volume;
+    std::atomic<size_t> _bid_orders;
+    std::atomic<price_t> _ask_price;
+    std::atomic<volume_t> _ask_volume;
+    std::atomic<size_t> _ask_orders;
+
+    // Publish the best bid and offer snapshot
+    void Publish(const BBO& bbo) noexcept;
+
+    // Spin-wait hint
+    static void Pause() noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "bbo.inl"
+
+#endif // CPPTRADER_MATCHING_BBO_H
@@ -0,0 +1,92 @@
+/*!
+    \file bbo.inl
+    \brief Order book best bid and offer inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace CppTrader {
+namespace Matching {
+
+inline BBOBlock::BBOBlock() noexcept
+    : _sequence(0),
+      _bid_price(0),
+      _bid_volume(0),
+      _bid_orders(0),
+      _ask_price(0),
+      _ask_volume(0),
+      _ask_orders(0)
+{
+}
+
+inline BBO BBOBlock::Read() const noexcept
+{
+    BBO bbo;
+    while (!TryRead(bbo, 1))
+        Pause();
+    return bbo;
+}
+
+inline bool BBOBlock::TryRead(BBO& bbo, size_t attempts) const noexcept
+{
+    for (size_t i = 0; i < attempts; ++i)
+    {
+        // Skip the attempt while the block is being published
+        uint64_t sequence = _sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) != 0)
+        {
+            Pause();
+            continue;
+        }
+
+        bbo.BidPrice = _bid_price.load(std::memory_order_relaxed);
+        bbo.BidVolume = _bid_volume.load(std::memory_order_relaxed);
+        bbo.BidOrders = _bid_orders.load(std::memory_order_relaxed);
+        bbo.AskPrice = _ask_price.load(std::memory_order_relaxed);
+        bbo.AskVolume = _ask_volume.load(std::memory_order_relaxed);
+        bbo.AskOrders = _ask_orders.load(std::memory_order_relaxed);
+
+        // Check the block was not published during the read
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_sequence.load(std::memory_order_relaxed) == sequence)
+            return true;
+    }
+
+    return false;
+}
+
+inline void BBOBlock::Publish(const BBO& bbo) noexcept
+{
+    uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+
+    // Mark the block as being published
+    _sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _bid_price.store(bbo.BidPrice, std::memory_order_relaxed);
+    _bid_volume.store(bbo.BidVolume, std::memory_order_relaxed);
+    _bid_orders.store(bbo.BidOrders, std::memory_order_relaxed);
+    _ask_price.store(bbo.AskPrice, std::memory_order_relaxed);
+    _ask_volume.store(bbo.AskVolume, std::memory_order_relaxed);
+    _ask_orders.store(bbo.AskOrders, std::memory_order_relaxed);
+
+    // Mark the block as published
+    _sequence.store(sequence + 2, std::memory_order_release);
+}
+
+inline void BBOBlock::Pause() noexcept
+{
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+} // namespace Matching
+} // namespace CppTrader
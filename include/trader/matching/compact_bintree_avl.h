@@ -0,0 +1,184 @@
+/*!
+    \file compact_bintree_avl.h
+    \brief Compact intrusive AVL binary tree definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_COMPACT_BINTREE_AVL_H
+#define CPPTRADER_MATCHING_COMPACT_BINTREE_AVL_H
+
+#include "node_pool.h"
+
+#include <functional>
+#include <utility>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Compact intrusive AVL binary tree
+/*!
+    Compact intrusive AVL binary tree has the same interface as CppCommon::BinTreeAVL,
+    but links tree nodes with 32-bit compact node pointers. Tree nodes must be
+    allocated from the compact node pool (see NodePool).
+
+    Tree is rebalanced with rotations only along the path from the inserted or
+    erased node to the root, the node with both children is erased by replacing
+    it with its in-order successor.
+
+    Not thread-safe.
+*/
+template <typename T, typename TCompare = std::less<T>>
+class CompactBinTreeAVL
+{
+public:
+    //! Tree node
+    struct Node
+    {
+        CompactPtr<T> parent; //!< Pointer to the parent tree node
+        CompactPtr<T> left;   //!< Pointer to the left child tree node
+        CompactPtr<T> right;  //!< Pointer to the right child tree node
+        int32_t height;       //!< Height of the tree node subtree
+    };
+
+    //! Tree iterator
+    template <class TContainer, typename TNode, bool reverse>
+    class Iterator
+    {
+    public:
+        Iterator() noexcept : _container(nullptr), _node(nullptr) {}
+        Iterator(TContainer* container, TNode* node) noexcept : _container(container), _node(node) {}
+
+        TNode& operator*() const noexcept { return *_node; }
+        TNode* operator->() const noexcept { return _node; }
+
+        Iterator& operator++() noexcept { if (_node != nullptr) _node = reverse ? Prev(_node) : Next(_node); return *this; }
+        Iterator operator++(int) noexcept { Iterator result(*this); ++*this; return result; }
+
+        friend bool operator==(const Iterator& it1, const Iterator& it2) noexcept { return it1._node == it2._node; }
+        friend bool operator!=(const Iterator& it1, const Iterator& it2) noexcept { return it1._node != it2._node; }
+
+        explicit operator bool() const noexcept { return _node != nullptr; }
+
+    private:
+        TContainer* _container;
+        TNode* _node;
+
+        friend class CompactBinTreeAVL;
+    };
+
+    typedef Iterator<CompactBinTreeAVL, T, false> iterator;
+    typedef Iterator<const CompactBinTreeAVL, const T, false> const_iterator;
+    typedef Iterator<CompactBinTreeAVL, T, true> reverse_iterator;
+    typedef Iterator<const CompactBinTreeAVL, const T, true> const_reverse_iterator;
+
+    explicit CompactBinTreeAVL(const TCompare& compare = TCompare()) noexcept : _compare(compare), _size(0) {}
+    CompactBinTreeAVL(const CompactBinTreeAVL&) noexcept = default;
+    CompactBinTreeAVL(CompactBinTreeAVL&&) noexcept = default;
+    ~CompactBinTreeAVL() noexcept = default;
+
+    CompactBinTreeAVL& operator=(const CompactBinTreeAVL&) noexcept = default;
+    CompactBinTreeAVL& operator=(CompactBinTreeAVL&&) noexcept = default;
+
+    //! Check if the tree is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Is the tree empty?
+    bool empty() const noexcept { return _root == nullptr; }
+    //! Get the tree size
+    size_t size() const noexcept { return _size; }
+
+    //! Get the root tree item
+    T* root() noexcept { return _root; }
+    const T* root() const noexcept { return _root; }
+    //! Get the lowest tree item
+    T* lowest() noexcept { return Lowest(_root); }
+    const T* lowest() const noexcept { return Lowest(_root); }
+    //! Get the highest tree item
+    T* highest() noexcept { return Highest(_root); }
+    const T* highest() const noexcept { return Highest(_root); }
+
+    //! Compare two items using the tree compare functor
+    bool compare(const T& item1, const T& item2) const noexcept { return _compare(item1, item2); }
+
+    //! Get the begin tree iterator
+    iterator begin() noexcept { return iterator(this, Lowest(_root)); }
+    const_iterator begin() const noexcept { return const_iterator(this, Lowest(_root)); }
+    //! Get the end tree iterator
+    iterator end() noexcept { return iterator(this, nullptr); }
+    const_iterator end() const noexcept { return const_iterator(this, nullptr); }
+
+    //! Get the reverse begin tree iterator
+    reverse_iterator rbegin() noexcept { return reverse_iterator(this, Highest(_root)); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(this, Highest(_root)); }
+    //! Get the reverse end tree iterator
+    reverse_iterator rend() noexcept { return reverse_iterator(this, nullptr); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(this, nullptr); }
+
+    //! Find the iterator which points to the first equal item in the tree or return end iterator
+    iterator find(const T& item) noexcept { return iterator(this, FindNode(item)); }
+    const_iterator find(const T& item) const noexcept { return const_iterator(this, FindNode(item)); }
+
+    //! Find the iterator which points to the first item that not less than the given item in the tree or return end iterator
+    iterator lower_bound(const T& item) noexcept { return iterator(this, LowerBound(item)); }
+    const_iterator lower_bound(const T& item) const noexcept { return const_iterator(this, LowerBound(item)); }
+    //! Find the iterator which points to the first item that greater than the given item in the tree or return end iterator
+    iterator upper_bound(const T& item) noexcept { return iterator(this, UpperBound(item)); }
+    const_iterator upper_bound(const T& item) const noexcept { return const_iterator(this, UpperBound(item)); }
+
+    //! Insert a new item into the tree
+    /*!
+        \param item - Item to insert
+        \return Pair with the iterator to the inserted item and success flag
+    */
+    std::pair<iterator, bool> insert(T& item) noexcept;
+
+    //! Erase the given item from the tree
+    /*!
+        \param item - Item to erase
+        \return Erased item
+    */
+    T* erase(const T& item) noexcept;
+    //! Erase the item by the given iterator
+    /*!
+        \param it - Iterator to the erased item
+        \return Iterator to the next item
+    */
+    iterator erase(const iterator& it) noexcept;
+
+    //! Clear the tree
+    void clear() noexcept;
+
+private:
+    TCompare _compare;
+    size_t _size;
+    CompactPtr<T> _root;
+
+    static T* Lowest(T* node) noexcept;
+    static const T* Lowest(const T* node) noexcept;
+    static T* Highest(T* node) noexcept;
+    static const T* Highest(const T* node) noexcept;
+    static T* Next(T* node) noexcept;
+    static const T* Next(const T* node) noexcept;
+    static T* Prev(T* node) noexcept;
+    static const T* Prev(const T* node) noexcept;
+
+    T* FindNode(const T& item) const noexcept;
+    T* LowerBound(const T& item) const noexcept;
+    T* UpperBound(const T& item) const noexcept;
+
+    static int32_t Height(const T* node) noexcept { return (node != nullptr) ? node->height : 0; }
+    static void UpdateHeight(T* node) noexcept;
+    void Replace(T* node, T* replacement) noexcept;
+    T* RotateLeft(T* node) noexcept;
+    T* RotateRight(T* node) noexcept;
+    void Rebalance(T* node) noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "compact_bintree_avl.inl"
+
+#endif // CPPTRADER_MATCHING_COMPACT_BINTREE_AVL_H
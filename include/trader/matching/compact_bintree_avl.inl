@@ -0,0 +1,332 @@
+/*!
+    \file compact_bintree_avl.inl
+    \brief Compact intrusive AVL binary tree inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::Lowest(T* node) noexcept
+{
+    if (node != nullptr)
+        while (node->left != nullptr)
+            node = node->left;
+    return node;
+}
+
+template <typename T, typename TCompare>
+inline const T* CompactBinTreeAVL<T, TCompare>::Lowest(const T* node) noexcept
+{
+    return Lowest(const_cast<T*>(node));
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::Highest(T* node) noexcept
+{
+    if (node != nullptr)
+        while (node->right != nullptr)
+            node = node->right;
+    return node;
+}
+
+template <typename T, typename TCompare>
+inline const T* CompactBinTreeAVL<T, TCompare>::Highest(const T* node) noexcept
+{
+    return Highest(const_cast<T*>(node));
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::Next(T* node) noexcept
+{
+    if (node->right != nullptr)
+        return Lowest(node->right);
+
+    T* parent = node->parent;
+    while ((parent != nullptr) && (node == parent->right))
+    {
+        node = parent;
+        parent = parent->parent;
+    }
+    return parent;
+}
+
+template <typename T, typename TCompare>
+inline const T* CompactBinTreeAVL<T, TCompare>::Next(const T* node) noexcept
+{
+    return Next(const_cast<T*>(node));
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::Prev(T* node) noexcept
+{
+    if (node->left != nullptr)
+        return Highest(node->left);
+
+    T* parent = node->parent;
+    while ((parent != nullptr) && (node == parent->left))
+    {
+        node = parent;
+        parent = parent->parent;
+    }
+    return parent;
+}
+
+template <typename T, typename TCompare>
+inline const T* CompactBinTreeAVL<T, TCompare>::Prev(const T* node) noexcept
+{
+    return Prev(const_cast<T*>(node));
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::FindNode(const T& item) const noexcept
+{
+    T* node = _root;
+    while (node != nullptr)
+    {
+        if (_compare(item, *node))
+            node = node->left;
+        else if (_compare(*node, item))
+            node = node->right;
+        else
+            return node;
+    }
+    return nullptr;
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::LowerBound(const T& item) const noexcept
+{
+    T* node = _root;
+    T* result = nullptr;
+    while (node != nullptr)
+    {
+        if (!_compare(*node, item))
+        {
+            result = node;
+            node = node->left;
+        }
+        else
+            node = node->right;
+    }
+    return result;
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::UpperBound(const T& item) const noexcept
+{
+    T* node = _root;
+    T* result = nullptr;
+    while (node != nullptr)
+    {
+        if (_compare(item, *node))
+        {
+            result = node;
+            node = node->left;
+        }
+        else
+            node = node->right;
+    }
+    return result;
+}
+
+template <typename T, typename TCompare>
+inline std::pair<typename CompactBinTreeAVL<T, TCompare>::iterator, bool> CompactBinTreeAVL<T, TCompare>::insert(T& item) noexcept
+{
+    item.parent = nullptr;
+    item.left = nullptr;
+    item.right = nullptr;
+    item.height = 1;
+
+    // Insert the root item
+    if (_root == nullptr)
+    {
+        _root = &item;
+        ++_size;
+        return std::make_pair(iterator(this, &item), true);
+    }
+
+    // Find the parent of the inserted item
+    T* node = _root;
+    for (;;)
+    {
+        if (_compare(item, *node))
+        {
+            if (node->left == nullptr)
+            {
+                node->left = &item;
+                break;
+            }
+            node = node->left;
+        }
+        else if (_compare(*node, item))
+        {
+            if (node->right == nullptr)
+            {
+                node->right = &item;
+                break;
+            }
+            node = node->right;
+        }
+        else
+            return std::make_pair(iterator(this, node), false);
+    }
+
+    item.parent = node;
+    ++_size;
+
+    // Rebalance the tree up to the root
+    Rebalance(node);
+
+    return std::make_pair(iterator(this, &item), true);
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::erase(const T& item) noexcept
+{
+    T* node = FindNode(item);
+    if (node != nullptr)
+        erase(iterator(this, node));
+    return node;
+}
+
+template <typename T, typename TCompare>
+inline typename CompactBinTreeAVL<T, TCompare>::iterator CompactBinTreeAVL<T, TCompare>::erase(const iterator& it) noexcept
+{
+    T* node = it._node;
+    if (node == nullptr)
+        return end();
+
+    T* next = Next(node);
+    T* start;
+
+    if (node->left == nullptr)
+    {
+        start = node->parent;
+        Replace(node, node->right);
+    }
+    else if (node->right == nullptr)
+    {
+        start = node->parent;
+        Replace(node, node->left);
+    }
+    else
+    {
+        // Replace the node with its in-order successor
+        T* successor = Lowest(node->right);
+        if (successor->parent != node)
+        {
+            start = successor->parent;
+            Replace(successor, successor->right);
+            successor->right = node->right;
+            successor->right->parent = successor;
+        }
+        else
+            start = successor;
+        Replace(node, successor);
+        successor->left = node->left;
+        successor->left->parent = successor;
+    }
+
+    // Rebalance the tree up to the root
+    Rebalance(start);
+
+    node->parent = nullptr;
+    node->left = nullptr;
+    node->right = nullptr;
+    --_size;
+
+    return iterator(this, next);
+}
+
+template <typename T, typename TCompare>
+inline void CompactBinTreeAVL<T, TCompare>::clear() noexcept
+{
+    _size = 0;
+    _root = nullptr;
+}
+
+template <typename T, typename TCompare>
+inline void CompactBinTreeAVL<T, TCompare>::UpdateHeight(T* node) noexcept
+{
+    int32_t left = Height(node->left);
+    int32_t right = Height(node->right);
+    node->height = 1 + ((left > right) ? left : right);
+}
+
+template <typename T, typename TCompare>
+inline void CompactBinTreeAVL<T, TCompare>::Replace(T* node, T* replacement) noexcept
+{
+    T* parent = node->parent;
+    if (parent == nullptr)
+        _root = replacement;
+    else if (node == parent->left)
+        parent->left = replacement;
+    else
+        parent->right = replacement;
+    if (replacement != nullptr)
+        replacement->parent = parent;
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::RotateLeft(T* node) noexcept
+{
+    T* pivot = node->right;
+    node->right = pivot->left;
+    if (pivot->left != nullptr)
+        pivot->left->parent = node;
+    Replace(node, pivot);
+    pivot->left = node;
+    node->parent = pivot;
+    UpdateHeight(node);
+    UpdateHeight(pivot);
+    return pivot;
+}
+
+template <typename T, typename TCompare>
+inline T* CompactBinTreeAVL<T, TCompare>::RotateRight(T* node) noexcept
+{
+    T* pivot = node->left;
+    node->left = pivot->right;
+    if (pivot->right != nullptr)
+        pivot->right->parent = node;
+    Replace(node, pivot);
+    pivot->right = node;
+    node->parent = pivot;
+    UpdateHeight(node);
+    UpdateHeight(pivot);
+    return pivot;
+}
+
+template <typename T, typename TCompare>
+inline void CompactBinTreeAVL<T, TCompare>::Rebalance(T* node) noexcept
+{
+    while (node != nullptr)
+    {
+        UpdateHeight(node);
+
+        int32_t balance = Height(node->left) - Height(node->right);
+        if (balance > 1)
+        {
+            // Left-right case is reduced to the left-left case
+            if (Height(node->left->left) < Height(node->left->right))
+                RotateLeft(node->left);
+            node = RotateRight(node);
+        }
+        else if (balance < -1)
+        {
+            // Right-left case is reduced to the right-right case
+            if (Height(node->right->right) < Height(node->right->left))
+                RotateRight(node->right);
+            node = RotateLeft(node);
+        }
+
+        node = node->parent;
+    }
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,122 @@
+/*!
+    \file compact_list.h
+    \brief Compact intrusive list definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_COMPACT_LIST_H
+#define CPPTRADER_MATCHING_COMPACT_LIST_H
+
+#include "node_pool.h"
+
+namespace CppTrader {
+namespace Matching {
+
+//! Compact intrusive list
+/*!
+    Compact intrusive list has the same interface as CppCommon::List, but
+    links list nodes with 32-bit compact node pointers. List nodes must be
+    allocated from the compact node pool (see NodePool).
+
+    Not thread-safe.
+*/
+template <typename T>
+class CompactList
+{
+public:
+    //! List node
+    struct Node
+    {
+        CompactPtr<T> next; //!< Pointer to the next list node
+        CompactPtr<T> prev; //!< Pointer to the previous list node
+    };
+
+    //! List iterator
+    template <typename TNode>
+    class Iterator
+    {
+    public:
+        Iterator() noexcept : _node(nullptr) {}
+        explicit Iterator(TNode* node) noexcept : _node(node) {}
+
+        TNode& operator*() const noexcept { return *_node; }
+        TNode* operator->() const noexcept { return _node; }
+
+        Iterator& operator++() noexcept { _node = _node->next; return *this; }
+        Iterator operator++(int) noexcept { Iterator result(*this); ++*this; return result; }
+
+        friend bool operator==(const Iterator& it1, const Iterator& it2) noexcept { return it1._node == it2._node; }
+        friend bool operator!=(const Iterator& it1, const Iterator& it2) noexcept { return it1._node != it2._node; }
+
+        explicit operator bool() const noexcept { return _node != nullptr; }
+
+    private:
+        TNode* _node;
+    };
+
+    typedef Iterator<T> iterator;
+    typedef Iterator<const T> const_iterator;
+
+    CompactList() noexcept : _size(0) {}
+    CompactList(const CompactList&) noexcept = default;
+    CompactList(CompactList&&) noexcept = default;
+    ~CompactList() noexcept = default;
+
+    CompactList& operator=(const CompactList&) noexcept = default;
+    CompactList& operator=(CompactList&&) noexcept = default;
+
+    //! Check if the list is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Is the list empty?
+    bool empty() const noexcept { return _front == nullptr; }
+    //! Get the list size
+    size_t size() const noexcept { return _size; }
+
+    //! Get the front list item
+    T* front() noexcept { return _front; }
+    const T* front() const noexcept { return _front; }
+    //! Get the back list item
+    T* back() noexcept { return _back; }
+    const T* back() const noexcept { return _back; }
+
+    //! Get the begin list iterator
+    iterator begin() noexcept { return iterator(_front); }
+    const_iterator begin() const noexcept { return const_iterator(_front); }
+    //! Get the end list iterator
+    iterator end() noexcept { return iterator(); }
+    const_iterator end() const noexcept { return const_iterator(); }
+
+    //! Push a new item into the front of the list
+    void push_front(T& item) noexcept;
+    //! Push a new item into the back of the list
+    void push_back(T& item) noexcept;
+    //! Push a new item as a next to the given one
+    void push_next(T& base, T& item) noexcept;
+    //! Push a new item as a previous to the given one
+    void push_prev(T& base, T& item) noexcept;
+
+    //! Pop the item from the front of the list
+    T* pop_front() noexcept;
+    //! Pop the item from the back of the list
+    T* pop_back() noexcept;
+    //! Pop the given item from the list
+    T* pop_current(T& base) noexcept;
+
+    //! Clear the list
+    void clear() noexcept;
+
+private:
+    size_t _size;
+    CompactPtr<T> _front;
+    CompactPtr<T> _back;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "compact_list.inl"
+
+#endif // CPPTRADER_MATCHING_COMPACT_LIST_H
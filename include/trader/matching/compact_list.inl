@@ -0,0 +1,110 @@
+/*!
+    \file compact_list.inl
+    \brief Compact intrusive list inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <typename T>
+inline void CompactList<T>::push_front(T& item) noexcept
+{
+    item.next = _front;
+    item.prev = nullptr;
+    if (_front != nullptr)
+        _front->prev = &item;
+    else
+        _back = &item;
+    _front = &item;
+    ++_size;
+}
+
+template <typename T>
+inline void CompactList<T>::push_back(T& item) noexcept
+{
+    item.next = nullptr;
+    item.prev = _back;
+    if (_back != nullptr)
+        _back->next = &item;
+    else
+        _front = &item;
+    _back = &item;
+    ++_size;
+}
+
+template <typename T>
+inline void CompactList<T>::push_next(T& base, T& item) noexcept
+{
+    item.next = base.next;
+    item.prev = &base;
+    if (base.next != nullptr)
+        base.next->prev = &item;
+    else
+        _back = &item;
+    base.next = &item;
+    ++_size;
+}
+
+template <typename T>
+inline void CompactList<T>::push_prev(T& base, T& item) noexcept
+{
+    item.next = &base;
+    item.prev = base.prev;
+    if (base.prev != nullptr)
+        base.prev->next = &item;
+    else
+        _front = &item;
+    base.prev = &item;
+    ++_size;
+}
+
+template <typename T>
+inline T* CompactList<T>::pop_front() noexcept
+{
+    if (_front == nullptr)
+        return nullptr;
+
+    return pop_current(*_front);
+}
+
+template <typename T>
+inline T* CompactList<T>::pop_back() noexcept
+{
+    if (_back == nullptr)
+        return nullptr;
+
+    return pop_current(*_back);
+}
+
+template <typename T>
+inline T* CompactList<T>::pop_current(T& base) noexcept
+{
+    // Unlink the item from its neighbours
+    if (base.next != nullptr)
+        base.next->prev = base.prev;
+    else
+        _back = base.prev;
+    if (base.prev != nullptr)
+        base.prev->next = base.next;
+    else
+        _front = base.next;
+
+    base.next = nullptr;
+    base.prev = nullptr;
+    --_size;
+    return &base;
+}
+
+template <typename T>
+inline void CompactList<T>::clear() noexcept
+{
+    _size = 0;
+    _front = nullptr;
+    _back = nullptr;
+}
+
+} // namespace Matching
+} // namespace CppTrader
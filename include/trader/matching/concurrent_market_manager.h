@@ -0,0 +1,248 @@
+/*!
+    \file concurrent_market_manager.h
+    \brief Concurrent market manager definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_CONCURRENT_MARKET_MANAGER_H
+#define CPPTRADER_MATCHING_CONCURRENT_MARKET_MANAGER_H
+
+#include "market_manager.h"
+
+#include "threads/locker.h"
+#include "threads/spin_lock.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Concurrent market manager
+/*!
+    Concurrent market manager is a thread-safe facade which allows several
+    threads to submit orders for different symbols at the same time. Each
+    order book is managed by its own market manager guarded with its own
+    spin lock, so operations on different symbols proceed in parallel.
+    Order Id to symbol Id routes are kept in the striped hash map, each
+    stripe is guarded with its own spin lock.
+
+    Lock order:
+    \li Order book locks are taken in ascending symbol Id order. Operations
+        which touch several order books (EnableMatching(), DisableMatching(),
+        DeleteOwnerOrders()) take locks of all order books in this order;
+    \li Stripe lock is always the innermost one and is held only for a
+        single route lookup or update. No order book lock is ever taken
+        while a stripe lock is held;
+    \li Market handler is called under the lock of the corresponding order
+        book, so it must be thread-safe for different order books and must
+        not call the concurrent market manager back.
+
+    Thread-safe.
+*/
+class ConcurrentMarketManager
+{
+public:
+    //! Create the concurrent market manager
+    /*!
+        \param market_handler - Market handler
+        \param symbols - Maximal count of symbols (default is 4096)
+        \param stripes - Count of order routes stripes (power of two, default is 64)
+    */
+    explicit ConcurrentMarketManager(MarketHandler& market_handler, size_t symbols = 4096, size_t stripes = 64);
+    ConcurrentMarketManager(const ConcurrentMarketManager&) = delete;
+    ConcurrentMarketManager(ConcurrentMarketManager&&) = delete;
+    ~ConcurrentMarketManager() = default;
+
+    ConcurrentMarketManager& operator=(const ConcurrentMarketManager&) = delete;
+    ConcurrentMarketManager& operator=(ConcurrentMarketManager&&) = delete;
+
+    //! Get the maximal count of symbols
+    size_t symbols() const noexcept { return _symbols; }
+
+    //! Add a new order book with its symbol
+    /*!
+        \param symbol - Symbol of the order book to add
+        \return Error code
+    */
+    ErrorCode AddOrderBook(const Symbol& symbol);
+    //! Delete the order book with its symbol and all its orders
+    /*!
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode DeleteOrderBook(uint32_t id);
+
+    //! Visit the order book under its lock
+    /*!
+        \param id - Symbol Id of the order book
+        \param visitor - Order book visitor with the signature void visitor(const OrderBook& order_book)
+        \return Error code
+    */
+    template <class TVisitor>
+    ErrorCode VisitOrderBook(uint32_t id, TVisitor&& visitor);
+    //! Visit the order under the lock of its order book
+    /*!
+        \param id - Order Id
+        \param visitor - Order visitor with the signature void visitor(const Order& order)
+        \return Error code
+    */
+    template <class TVisitor>
+    ErrorCode VisitOrder(uint64_t id, TVisitor&& visitor);
+
+    //! Add a new order
+    /*!
+        \param order - Order to add
+        \return Error code
+    */
+    ErrorCode AddOrder(const Order& order);
+    //! Reduce the order by the given quantity
+    /*!
+        \param id - Order Id
+        \param quantity - Order quantity to reduce
+        \return Error code
+    */
+    ErrorCode ReduceOrder(uint64_t id, uint64_t quantity);
+    //! Modify the order
+    /*!
+        \param id - Order Id
+        \param new_price - Order price to modify
+        \param new_quantity - Order quantity to modify
+        \return Error code
+    */
+    ErrorCode ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity);
+    //! Mitigate the order
+    /*!
+        \param id - Order Id
+        \param new_price - Order price to modify
+        \param new_quantity - Order quantity to modify
+        \return Error code
+    */
+    ErrorCode MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity);
+    //! Replace the order with a similar order but different Id, price and quantity
+    /*!
+        \param id - Order Id
+        \param new_id - Order Id to replace
+        \param new_price - Order price to replace
+        \param new_quantity - Order quantity to replace
+        \return Error code
+    */
+    ErrorCode ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity);
+    //! Delete the order
+    /*!
+        \param id - Order Id
+        \return Error code
+    */
+    ErrorCode DeleteOrder(uint64_t id);
+    //! Execute the order
+    /*!
+        \param id - Order Id
+        \param quantity - Order executed quantity
+        \return Error code
+    */
+    ErrorCode ExecuteOrder(uint64_t id, uint64_t quantity);
+    //! Execute the order
+    /*!
+        \param id - Order Id
+        \param price - Order executed price
+        \param quantity - Order executed quantity
+        \return Error code
+    */
+    ErrorCode ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity);
+
+    //! Delete all orders of the order book
+    /*!
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode DeleteOrders(uint32_t id);
+    //! Delete all orders of the given owner in all order books
+    /*!
+        All order books are locked during the operation, so the owner orders
+        are deleted from all of them atomically.
+
+        \param owner - Order owner Id
+        \return Error code
+    */
+    ErrorCode DeleteOwnerOrders(uint32_t owner);
+
+    //! Is automatic matching enabled?
+    bool IsMatchingEnabled() const noexcept { return _matching.load(std::memory_order_acquire); }
+    //! Enable automatic matching in all order books
+    void EnableMatching();
+    //! Disable automatic matching in all order books
+    void DisableMatching();
+
+private:
+    // Order book guarded with its own lock
+    struct alignas(64) Book
+    {
+        CppCommon::SpinLock Lock;
+        std::unique_ptr<MarketManager> Manager;
+    };
+
+    // Order routes stripe guarded with its own lock
+    struct alignas(64) Stripe
+    {
+        CppCommon::SpinLock Lock;
+        CppCommon::HashMap<uint64_t, uint32_t, FastHash> Routes;
+
+        Stripe() : Routes(1024, 0) {}
+    };
+
+    // Market handler which keeps order routes up to date
+    class Router : public MarketHandler
+    {
+    public:
+        explicit Router(ConcurrentMarketManager& manager) : _manager(manager) {}
+
+    protected:
+        void onAddSymbol(const Symbol& symbol) override;
+        void onDeleteSymbol(const Symbol& symbol) override;
+        void onAddOrderBook(const OrderBook& order_book) override;
+        void onUpdateOrderBook(const OrderBook& order_book, bool top) override;
+        void onDeleteOrderBook(const OrderBook& order_book) override;
+        void onUpdateAuction(const OrderBook& order_book, const Auction& auction) override;
+        void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override;
+        void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override;
+        void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override;
+        void onAddOrder(const Order& order) override;
+        void onUpdateOrder(const Order& order) override;
+        void onReplaceOrder(const Order& old_order, const Order& order) override;
+        void onDeleteOrder(const Order& order) override;
+        void onDeleteOrders(const OrderBook& order_book, size_t orders, uint64_t volume) override;
+        void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override;
+
+    private:
+        ConcurrentMarketManager& _manager;
+    };
+
+    MarketHandler& _market_handler;
+    Router _router;
+    std::atomic<bool> _matching;
+    size_t _symbols;
+    std::unique_ptr<Book[]> _books;
+    size_t _stripes_count;
+    std::unique_ptr<Stripe[]> _stripes;
+
+    Stripe& GetStripe(uint64_t id) noexcept { return _stripes[(FastHash()(id) >> 32) & (_stripes_count - 1)]; }
+    bool FindRoute(uint64_t id, uint32_t& symbol);
+    bool InsertRoute(uint64_t id, uint32_t symbol);
+    void EraseRoute(uint64_t id);
+
+    template <class TOperation>
+    ErrorCode RouteOrder(uint64_t id, TOperation&& operation);
+
+    void LockAll() noexcept;
+    void UnlockAll() noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "concurrent_market_manager.inl"
+
+#endif // CPPTRADER_MATCHING_CONCURRENT_MARKET_MANAGER_H
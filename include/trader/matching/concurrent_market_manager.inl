@@ -0,0 +1,69 @@
+/*!
+    \file concurrent_market_manager.inl
+    \brief Concurrent market manager inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TVisitor>
+inline ErrorCode ConcurrentMarketManager::VisitOrderBook(uint32_t id, TVisitor&& visitor)
+{
+    if (id >= _symbols)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    Book& book = _books[id];
+    CppCommon::Locker<CppCommon::SpinLock> locker(book.Lock);
+
+    if (!book.Manager)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    visitor(*book.Manager->GetOrderBook(id));
+    return ErrorCode::OK;
+}
+
+template <class TVisitor>
+inline ErrorCode ConcurrentMarketManager::VisitOrder(uint64_t id, TVisitor&& visitor)
+{
+    return RouteOrder(id, [id, &visitor](MarketManager& manager)
+    {
+        visitor(*manager.GetOrder(id));
+        return ErrorCode::OK;
+    });
+}
+
+template <class TOperation>
+inline ErrorCode ConcurrentMarketManager::RouteOrder(uint64_t id, TOperation&& operation)
+{
+    assert((id > 0) && "Order Id must be greater than zero!");
+    if (id == 0)
+        return ErrorCode::ORDER_ID_INVALID;
+
+    for (;;)
+    {
+        // Route the order Id to its order book
+        uint32_t symbol;
+        if (!FindRoute(id, symbol))
+            return ErrorCode::ORDER_NOT_FOUND;
+
+        Book& book = _books[symbol];
+        CppCommon::Locker<CppCommon::SpinLock> locker(book.Lock);
+
+        // Order could be deleted or its Id could be reused in another order book before the lock
+        if (!book.Manager || (book.Manager->GetOrder(id) == nullptr))
+        {
+            uint32_t current;
+            if (FindRoute(id, current) && (current != symbol))
+                continue;
+            return ErrorCode::ORDER_NOT_FOUND;
+        }
+
+        return operation(*book.Manager);
+    }
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,130 @@
+/*!
+    \file conflation_handler.h
+    \brief Conflation market handler definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_CONFLATION_HANDLER_H
+#define CPPTRADER_MATCHING_CONFLATION_HANDLER_H
+
+#include "fast_hash.h"
+#include "market_event.h"
+#include "market_handler.h"
+
+#include "containers/hashmap.h"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Conflation market handler
+/*!
+    Conflation market handler is a level 2 market data publisher fed by the
+    price level handlers of the market manager. It keeps the set of dirty
+    order books and dirty price levels and publishes only their net changes
+    against the previously published state with onConflatedEvent() handler
+    on Flush() call, either at the end of each conflation interval or at the
+    batch boundary. Price levels which were changed back and forth or added
+    and deleted inside the interval are never published.
+
+    Conflated events are ADD_ORDER_BOOK, DELETE_ORDER_BOOK, ADD_LEVEL,
+    UPDATE_LEVEL and DELETE_LEVEL market events with the same fields as the
+    original ones, except Top flag which is never set.
+
+    Not thread-safe.
+*/
+class ConflationHandler : public MarketHandler
+{
+public:
+    //! Create the conflation market handler
+    /*!
+        \param interval - Conflation interval in nanoseconds (default is 0, flush on each call)
+    */
+    explicit ConflationHandler(uint64_t interval = 0);
+    ConflationHandler(const ConflationHandler&) = delete;
+    ConflationHandler(ConflationHandler&&) = delete;
+    virtual ~ConflationHandler() = default;
+
+    ConflationHandler& operator=(const ConflationHandler&) = delete;
+    ConflationHandler& operator=(ConflationHandler&&) = delete;
+
+    //! Get the conflation interval in nanoseconds
+    uint64_t interval() const noexcept { return _interval; }
+    //! Get the count of dirty order books
+    size_t dirty() const noexcept { return _dirty_books.size(); }
+
+    //! Publish net changes of all dirty order books (batch boundary)
+    /*!
+        \return Count of published conflated events
+    */
+    size_t Flush();
+    //! Publish net changes of all dirty order books if the conflation interval is elapsed
+    /*!
+        \param timestamp - Current timestamp in nanoseconds
+        \return Count of published conflated events
+    */
+    size_t Flush(uint64_t timestamp);
+
+protected:
+    // Conflated market handler
+    virtual void onConflatedEvent(const MarketEvent& event) {}
+
+protected:
+    void onAddOrderBook(const OrderBook& order_book) override;
+    void onDeleteOrderBook(const OrderBook& order_book) override;
+
+    void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override;
+    void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override;
+    void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override;
+
+private:
+    struct ConflatedLevel
+    {
+        // Published state
+        bool Published;
+        uint64_t PublishedVolume;
+        uint64_t PublishedVisible;
+        size_t PublishedOrders;
+        // Current state
+        bool Dirty;
+        bool Exists;
+        uint64_t Volume;
+        uint64_t Visible;
+        size_t Orders;
+    };
+
+    typedef CppCommon::HashMap<uint64_t, ConflatedLevel, FastHash> Levels;
+
+    struct ConflatedBook
+    {
+        uint32_t Id;
+        bool Published;
+        bool Deleted;
+        bool Dirty;
+        Levels Bids;
+        Levels Asks;
+        std::vector<std::pair<bool, uint64_t>> DirtyLevels;
+
+        explicit ConflatedBook(uint32_t id);
+    };
+
+    uint64_t _interval;
+    uint64_t _timestamp;
+    std::vector<std::unique_ptr<ConflatedBook>> _books;
+    std::vector<uint32_t> _dirty_books;
+
+    ConflatedBook& GetBook(uint32_t id);
+    void MarkDirty(ConflatedBook& book);
+    void UpdateLevel(const OrderBook& order_book, const Level& level, bool exists);
+    size_t FlushBook(ConflatedBook& book);
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#endif // CPPTRADER_MATCHING_CONFLATION_HANDLER_H
@@ -0,0 +1,114 @@
+/*!
+    \file depth.h
+    \brief Order book depth definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_DEPTH_H
+#define CPPTRADER_MATCHING_DEPTH_H
+
+#include "level.h"
+
+#include <cstring>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+class OrderBook;
+
+//! Order book depth
+/*!
+    Order book depth keeps top N price levels of one order book side in the
+    contiguous structure-of-arrays form: prices, total volumes, visible volumes
+    and orders count. Depth is ordered from the best price level to the worst
+    one and is updated incrementally by the order book with each price level
+    update, so reading the depth costs only a memory copy.
+
+    Depth is disabled by default and could be enabled for the order book with
+    MarketManager::EnableOrderBookDepth() method.
+
+    Not thread-safe.
+*/
+class Depth
+{
+    friend class OrderBook;
+
+public:
+    Depth(LevelType type) noexcept;
+    Depth(const Depth&) = delete;
+    Depth(Depth&&) = delete;
+    ~Depth() = default;
+
+    Depth& operator=(const Depth&) = delete;
+    Depth& operator=(Depth&&) = delete;
+
+    //! Check if the depth is enabled
+    explicit operator bool() const noexcept { return enabled(); }
+
+    //! Is the depth enabled?
+    bool enabled() const noexcept { return _capacity > 0; }
+    //! Is the depth empty?
+    bool empty() const noexcept { return _size == 0; }
+
+    //! Get the depth side type
+    LevelType type() const noexcept { return _type; }
+    //! Is the bids depth?
+    bool IsBid() const noexcept { return _type == LevelType::BID; }
+    //! Is the asks depth?
+    bool IsAsk() const noexcept { return _type == LevelType::ASK; }
+    //! Get the depth capacity (maximal count of price levels)
+    size_t capacity() const noexcept { return _capacity; }
+    //! Get the depth size (current count of price levels)
+    size_t size() const noexcept { return _size; }
+
+    //! Get the depth prices array
+    const price_t* prices() const noexcept { return _prices.data(); }
+    //! Get the depth total volumes array
+    const volume_t* total_volumes() const noexcept { return _total_volumes.data(); }
+    //! Get the depth visible volumes array
+    const volume_t* visible_volumes() const noexcept { return _visible_volumes.data(); }
+    //! Get the depth orders count array
+    const size_t* orders() const noexcept { return _orders.data(); }
+
+    //! Copy the depth into the given arrays
+    /*!
+        Any of the given arrays might be nullptr to skip copying.
+
+        \param prices - Prices array
+        \param total_volumes - Total volumes array
+        \param visible_volumes - Visible volumes array
+        \param orders - Orders count array
+        \param count - Arrays size
+        \return Count of copied price levels
+    */
+    size_t Copy(price_t* prices, volume_t* total_volumes, volume_t* visible_volumes, size_t* orders, size_t count) const noexcept;
+
+private:
+    LevelType _type;
+    size_t _capacity;
+    size_t _size;
+    std::vector<price_t> _prices;
+    std::vector<volume_t> _total_volumes;
+    std::vector<volume_t> _visible_volumes;
+    std::vector<size_t> _orders;
+
+    // Depth management
+    void Reset(size_t capacity);
+    bool IsBetter(price_t price1, price_t price2) const noexcept;
+    size_t Find(price_t price) const noexcept;
+    void Set(size_t index, const Level& level) noexcept;
+    void Append(const Level& level) noexcept;
+    void Insert(const Level& level) noexcept;
+    void Update(const Level& level) noexcept;
+    bool Erase(const Level& level) noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "depth.inl"
+
+#endif // CPPTRADER_MATCHING_DEPTH_H
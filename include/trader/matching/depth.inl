@@ -0,0 +1,131 @@
+/*!
+    \file depth.inl
+    \brief Order book depth inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline Depth::Depth(LevelType type) noexcept
+    : _type(type),
+      _capacity(0),
+      _size(0)
+{
+}
+
+inline size_t Depth::Copy(price_t* prices, volume_t* total_volumes, volume_t* visible_volumes, size_t* orders, size_t count) const noexcept
+{
+    count = std::min(count, _size);
+    if (count == 0)
+        return 0;
+
+    if (prices != nullptr)
+        std::memcpy(prices, _prices.data(), count * sizeof(price_t));
+    if (total_volumes != nullptr)
+        std::memcpy(total_volumes, _total_volumes.data(), count * sizeof(volume_t));
+    if (visible_volumes != nullptr)
+        std::memcpy(visible_volumes, _visible_volumes.data(), count * sizeof(volume_t));
+    if (orders != nullptr)
+        std::memcpy(orders, _orders.data(), count * sizeof(size_t));
+
+    return count;
+}
+
+inline void Depth::Reset(size_t capacity)
+{
+    _capacity = capacity;
+    _size = 0;
+    _prices.resize(capacity);
+    _total_volumes.resize(capacity);
+    _visible_volumes.resize(capacity);
+    _orders.resize(capacity);
+}
+
+inline bool Depth::IsBetter(price_t price1, price_t price2) const noexcept
+{
+    return (_type == LevelType::BID) ? (price1 > price2) : (price1 < price2);
+}
+
+inline size_t Depth::Find(price_t price) const noexcept
+{
+    for (size_t i = 0; i < _size; ++i)
+        if (_prices[i] == price)
+            return i;
+    return _size;
+}
+
+inline void Depth::Set(size_t index, const Level& level) noexcept
+{
+    _prices[index] = level.Price;
+    _total_volumes[index] = level.TotalVolume;
+    _visible_volumes[index] = level.VisibleVolume;
+    _orders[index] = level.Orders;
+}
+
+inline void Depth::Append(const Level& level) noexcept
+{
+    assert((_size < _capacity) && "Depth is full!");
+    Set(_size++, level);
+}
+
+inline void Depth::Insert(const Level& level) noexcept
+{
+    // Find the insert position
+    size_t index = 0;
+    while ((index < _size) && !IsBetter(level.Price, _prices[index]))
+        ++index;
+
+    // Skip price levels out of the depth
+    if (index == _capacity)
+        return;
+
+    // Drop the worst price level from the full depth
+    if (_size == _capacity)
+        --_size;
+
+    // Shift worse price levels
+    size_t count = _size - index;
+    if (count > 0)
+    {
+        std::memmove(&_prices[index + 1], &_prices[index], count * sizeof(price_t));
+        std::memmove(&_total_volumes[index + 1], &_total_volumes[index], count * sizeof(volume_t));
+        std::memmove(&_visible_volumes[index + 1], &_visible_volumes[index], count * sizeof(volume_t));
+        std::memmove(&_orders[index + 1], &_orders[index], count * sizeof(size_t));
+    }
+
+    Set(index, level);
+    ++_size;
+}
+
+inline void Depth::Update(const Level& level) noexcept
+{
+    size_t index = Find(level.Price);
+    if (index < _size)
+        Set(index, level);
+}
+
+inline bool Depth::Erase(const Level& level) noexcept
+{
+    size_t index = Find(level.Price);
+    if (index == _size)
+        return false;
+
+    // Shift worse price levels
+    size_t count = _size - index - 1;
+    if (count > 0)
+    {
+        std::memmove(&_prices[index], &_prices[index + 1], count * sizeof(price_t));
+        std::memmove(&_total_volumes[index], &_total_volumes[index + 1], count * sizeof(volume_t));
+        std::memmove(&_visible_volumes[index], &_visible_volumes[index + 1], count * sizeof(volume_t));
+        std::memmove(&_orders[index], &_orders[index + 1], count * sizeof(size_t));
+    }
+
+    --_size;
+    return true;
+}
+
+} // namespace Matching
+} // namespace CppTrader
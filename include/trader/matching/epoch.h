@@ -0,0 +1,140 @@
+/*!
+    \file epoch.h
+    \brief Epoch-based reclamation definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_EPOCH_H
+#define CPPTRADER_MATCHING_EPOCH_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Epoch manager
+/*!
+    Epoch manager tracks read-side critical sections of registered reader
+    threads. Writer retires released nodes with the current global epoch
+    and recycles them only when all readers active at the moment of the
+    retirement have left their critical sections, so the node memory which
+    was reachable by a reader is never reused under its feet.
+
+    Reader thread registers once with RegisterReader() and then wraps each
+    read-side critical section with Enter()/Leave() calls (or EpochGuard).
+    Critical sections should be short, because an active reader prevents
+    all nodes retired after its entering from being recycled.
+
+    Thread-safe.
+*/
+class EpochManager
+{
+public:
+    //! Invalid reader slot
+    static const size_t INVALID_READER = std::numeric_limits<size_t>::max();
+
+    //! Create the epoch manager
+    /*!
+        \param readers - Maximal count of registered reader threads (default is 64)
+    */
+    explicit EpochManager(size_t readers = 64);
+    EpochManager(const EpochManager&) = delete;
+    EpochManager(EpochManager&&) = delete;
+    ~EpochManager() = default;
+
+    EpochManager& operator=(const EpochManager&) = delete;
+    EpochManager& operator=(EpochManager&&) = delete;
+
+    //! Get the current global epoch
+    uint64_t epoch() const noexcept { return _epoch.load(std::memory_order_acquire); }
+    //! Get the maximal count of registered reader threads
+    size_t readers() const noexcept { return _readers; }
+
+    //! Register a new reader thread
+    /*!
+        \return Reader slot or INVALID_READER if all slots are in use
+    */
+    size_t RegisterReader() noexcept;
+    //! Unregister the reader thread
+    /*!
+        \param reader - Reader slot
+    */
+    void UnregisterReader(size_t reader) noexcept;
+
+    //! Enter the read-side critical section
+    /*!
+        \param reader - Reader slot
+    */
+    void Enter(size_t reader) noexcept;
+    //! Leave the read-side critical section
+    /*!
+        \param reader - Reader slot
+    */
+    void Leave(size_t reader) noexcept;
+
+    //! Synchronize with reader threads
+    /*!
+        Advances the global epoch if all active readers have observed the current
+        one and calculates the oldest epoch which could be still observed by any
+        active reader. Nodes retired in any epoch before it could be recycled.
+
+        Should be called from the writer thread only.
+
+        \return Oldest observed epoch
+    */
+    uint64_t Synchronize() noexcept;
+
+private:
+    struct alignas(64) Slot
+    {
+        // Observed epoch (0 if the reader is not in the critical section)
+        std::atomic<uint64_t> Epoch;
+        std::atomic<bool> Registered;
+    };
+
+    alignas(64) std::atomic<uint64_t> _epoch;
+    size_t _readers;
+    std::unique_ptr<Slot[]> _slots;
+};
+
+//! Epoch guard
+/*!
+    Epoch guard enters the read-side critical section of the epoch manager
+    in its constructor and leaves it in its destructor.
+
+    Not thread-safe.
+*/
+class EpochGuard
+{
+public:
+    //! Enter the read-side critical section
+    /*!
+        \param manager - Epoch manager
+        \param reader - Reader slot
+    */
+    EpochGuard(EpochManager& manager, size_t reader) noexcept : _manager(manager), _reader(reader) { _manager.Enter(_reader); }
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard(EpochGuard&&) = delete;
+    ~EpochGuard() noexcept { _manager.Leave(_reader); }
+
+    EpochGuard& operator=(const EpochGuard&) = delete;
+    EpochGuard& operator=(EpochGuard&&) = delete;
+
+private:
+    EpochManager& _manager;
+    size_t _reader;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "epoch.inl"
+
+#endif // CPPTRADER_MATCHING_EPOCH_H
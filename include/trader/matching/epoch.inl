@@ -0,0 +1,31 @@
+/*!
+    \file epoch.inl
+    \brief Epoch-based reclamation inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline void EpochManager::Enter(size_t reader) noexcept
+{
+    assert((reader < _readers) && _slots[reader].Registered.load(std::memory_order_relaxed) && "Reader is not registered!");
+
+    // Announce the observed epoch
+    _slots[reader].Epoch.store(_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    // Order the announcement before any read of shared nodes (pairs with the fence in Synchronize())
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline void EpochManager::Leave(size_t reader) noexcept
+{
+    assert((reader < _readers) && "Reader is not registered!");
+
+    _slots[reader].Epoch.store(0, std::memory_order_release);
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -24,12 +24,14 @@ enum class ErrorCode : uint8_t
     SYMBOL_NOT_FOUND,
     ORDER_BOOK_DUPLICATE,
     ORDER_BOOK_NOT_FOUND,
+    ORDER_BOOK_MODE_INVALID,
     ORDER_DUPLICATE,
     ORDER_NOT_FOUND,
     ORDER_ID_INVALID,
     ORDER_TYPE_INVALID,
     ORDER_PARAMETER_INVALID,
-    ORDER_QUANTITY_INVALID
+    ORDER_QUANTITY_INVALID,
+    ORDER_PRICE_INVALID
 };
 
 template <class TOutputStream>
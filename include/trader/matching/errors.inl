@@ -29,6 +29,9 @@ inline TOutputStream& operator<<(TOutputStream& stream, ErrorCode error)
         case ErrorCode::ORDER_BOOK_NOT_FOUND:
             stream << "ORDER_BOOK_NOT_FOUND";
             break;
+        case ErrorCode::ORDER_BOOK_MODE_INVALID:
+            stream << "ORDER_BOOK_MODE_INVALID";
+            break;
         case ErrorCode::ORDER_DUPLICATE:
             stream << "ORDER_DUPLICATE";
             break;
@@ -47,6 +50,9 @@ inline TOutputStream& operator<<(TOutputStream& stream, ErrorCode error)
         case ErrorCode::ORDER_QUANTITY_INVALID:
             stream << "ORDER_QUANTITY_INVALID";
             break;
+        case ErrorCode::ORDER_PRICE_INVALID:
+            stream << "ORDER_PRICE_INVALID";
+            break;
         default:
             stream << "<unknown>";
             break;
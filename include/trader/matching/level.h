@@ -12,7 +12,7 @@
 #include "order.h"
 #include "update.h"
 
-#include "containers/bintree_avl.h"
+#include <tuple>
 
 namespace CppTrader {
 namespace Matching {
@@ -33,17 +33,17 @@ struct Level
     //! Level type
     LevelType Type;
     //! Level price
-    uint64_t Price;
+    price_t Price;
     //! Level volume
-    uint64_t TotalVolume;
+    volume_t TotalVolume;
     //! Level hidden volume
-    uint64_t HiddenVolume;
+    volume_t HiddenVolume;
     //! Level visible volume
-    uint64_t VisibleVolume;
+    volume_t VisibleVolume;
     //! Level orders
     size_t Orders;
 
-    Level(LevelType type, uint64_t price) noexcept;
+    Level(LevelType type, price_t price) noexcept;
     Level(const Level&) noexcept = default;
     Level(Level&&) noexcept = default;
     ~Level() noexcept = default;
@@ -75,12 +75,39 @@ struct Level
 };
 
 //! Price level node
-struct LevelNode : public Level, public CppCommon::BinTreeAVL<LevelNode>::Node
+/*!
+    Trailing stop price levels keep orders with the same trailing distance and
+    step only, so the whole price level is repriced at once when the market
+    moves. Such price levels are ordered by the price first and then by their
+    trailing distance and step. Other price levels have zero trailing distance
+    and step and are ordered by the price only.
+*/
+struct LevelNode : public Level, public NodeTree<LevelNode>::Node
 {
+#if defined(CPPTRADER_COMPACT_LINKS)
+    //! Compact node handle
+    uint32_t Handle;
+#endif
+
     //! Price level orders
-    CppCommon::List<OrderNode> OrderList;
+    OrderNodeList OrderList;
+
+    //! 'All-Or-None' orders volume of the price level
+    volume_t AONVolume;
+    //! 'All-Or-None' orders count of the price level
+    size_t AONOrders;
 
-    LevelNode(LevelType type, uint64_t price) noexcept;
+    //! Subtree volume (total volume of the price level and all its child levels in the tree)
+    volume_t SubtreeVolume;
+    //! Subtree orders (orders count of the price level and all its child levels in the tree)
+    size_t SubtreeOrders;
+
+    //! Trailing distance of the trailing stop price level orders
+    int64_t TrailingDistance;
+    //! Trailing step of the trailing stop price level orders
+    int64_t TrailingStep;
+
+    LevelNode(LevelType type, price_t price, int64_t trailing_distance = 0, int64_t trailing_step = 0) noexcept;
     LevelNode(const Level& level) noexcept;
     LevelNode(const LevelNode&) noexcept = default;
     LevelNode(LevelNode&&) noexcept = default;
@@ -90,19 +117,22 @@ struct LevelNode : public Level, public CppCommon::BinTreeAVL<LevelNode>::Node
     LevelNode& operator=(const LevelNode&) noexcept = default;
     LevelNode& operator=(LevelNode&&) noexcept = default;
 
+    //! Get the price level key (price, trailing distance and trailing step)
+    std::tuple<price_t, int64_t, int64_t> Key() const noexcept { return std::make_tuple(Price, TrailingDistance, TrailingStep); }
+
     // Price level comparison
     friend bool operator==(const LevelNode& level1, const LevelNode& level2) noexcept
-    { return level1.Price == level2.Price; }
+    { return level1.Key() == level2.Key(); }
     friend bool operator!=(const LevelNode& level1, const LevelNode& level2) noexcept
-    { return level1.Price != level2.Price; }
+    { return level1.Key() != level2.Key(); }
     friend bool operator<(const LevelNode& level1, const LevelNode& level2) noexcept
-    { return level1.Price < level2.Price; }
+    { return level1.Key() < level2.Key(); }
     friend bool operator>(const LevelNode& level1, const LevelNode& level2) noexcept
-    { return level1.Price > level2.Price; }
+    { return level1.Key() > level2.Key(); }
     friend bool operator<=(const LevelNode& level1, const LevelNode& level2) noexcept
-    { return level1.Price <= level2.Price; }
+    { return level1.Key() <= level2.Key(); }
     friend bool operator>=(const LevelNode& level1, const LevelNode& level2) noexcept
-    { return level1.Price >= level2.Price; }
+    { return level1.Key() >= level2.Key(); }
 };
 
 //! Price level update
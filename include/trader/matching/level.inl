@@ -27,7 +27,7 @@ inline TOutputStream& operator<<(TOutputStream& stream, LevelType type)
     return stream;
 }
 
-inline Level::Level(LevelType type, uint64_t price) noexcept
+inline Level::Level(LevelType type, price_t price) noexcept
     : Type(type),
       Price(price),
       TotalVolume(0),
@@ -50,12 +50,25 @@ inline TOutputStream& operator<<(TOutputStream& stream, const Level& level)
     return stream;
 }
 
-inline LevelNode::LevelNode(LevelType type, uint64_t price) noexcept
-    : Level(type, price)
+inline LevelNode::LevelNode(LevelType type, price_t price, int64_t trailing_distance, int64_t trailing_step) noexcept
+    : Level(type, price),
+      AONVolume(0),
+      AONOrders(0),
+      SubtreeVolume(0),
+      SubtreeOrders(0),
+      TrailingDistance(trailing_distance),
+      TrailingStep(trailing_step)
 {
 }
 
-inline LevelNode::LevelNode(const Level& level) noexcept : Level(level)
+inline LevelNode::LevelNode(const Level& level) noexcept
+    : Level(level),
+      AONVolume(0),
+      AONOrders(0),
+      SubtreeVolume(level.TotalVolume),
+      SubtreeOrders(level.Orders),
+      TrailingDistance(0),
+      TrailingStep(0)
 {
 }
 
@@ -63,6 +76,12 @@ inline LevelNode& LevelNode::operator=(const Level& level) noexcept
 {
     Level::operator=(level);
     OrderList.clear();
+    AONVolume = 0;
+    AONOrders = 0;
+    SubtreeVolume = level.TotalVolume;
+    SubtreeOrders = level.Orders;
+    TrailingDistance = 0;
+    TrailingStep = 0;
     return *this;
 }
 
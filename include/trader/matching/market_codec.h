@@ -0,0 +1,216 @@
+/*!
+    \file market_codec.h
+    \brief Market binary codec definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_CODEC_H
+#define CPPTRADER_MATCHING_MARKET_CODEC_H
+
+#include "market_event_handler.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market encoder
+/*!
+    Market encoder is a market handler which encodes market-by-order and
+    market-by-price book deltas into the compact binary form suitable for
+    recording full depth sessions to the local disk or sending them over
+    the network.
+
+    Encoded stream is a sequence of frames. Each frame starts with the
+    header of three varints: sequence number of the first market event,
+    market events count and payload size in bytes. Each market event of
+    the payload starts with the header byte (event type in low 5 bits, sell
+    side, top of the book and symbol change flags in high bits) followed by
+    varint fields which are present for the event type. Symbol Id, order Id
+    and price are encoded as zigzag varint deltas relative to the previous
+    market event of the same frame, hidden quantity is encoded instead of
+    the visible one. Delta state is reset at each frame start, so any frame
+    could be decoded independently.
+
+    Frame is passed to onEncodedFrame() handler when the payload reaches
+    the frame size or on Flush() call.
+
+    Not thread-safe.
+*/
+class MarketEncoder : public MarketEventHandler<MarketEncoder>
+{
+public:
+    //! Maximal frame header size in bytes
+    static const size_t MAX_HEADER_SIZE = 30;
+    //! Maximal encoded market event size in bytes
+    static const size_t MAX_EVENT_SIZE = 56;
+
+    //! Create the market encoder
+    /*!
+        \param frame_size - Frame payload size in bytes (default is 64KB)
+    */
+    explicit MarketEncoder(size_t frame_size = 64 * 1024);
+    MarketEncoder(const MarketEncoder&) = delete;
+    MarketEncoder(MarketEncoder&&) = delete;
+    virtual ~MarketEncoder() = default;
+
+    MarketEncoder& operator=(const MarketEncoder&) = delete;
+    MarketEncoder& operator=(MarketEncoder&&) = delete;
+
+    //! Get the sequence number of the next encoded market event
+    uint64_t sequence() const noexcept { return _sequence + _count; }
+    //! Get the count of encoded bytes including frame headers
+    uint64_t bytes() const noexcept { return _bytes; }
+    //! Get the size of the pending frame payload in bytes
+    size_t size() const noexcept { return _size - MAX_HEADER_SIZE; }
+
+    //! Encode the market event
+    /*!
+        \param event - Market event to encode
+    */
+    void Encode(const MarketEvent& event);
+
+    //! Flush the pending frame
+    void Flush();
+
+protected:
+    // Encoded frame handler
+    virtual void onEncodedFrame(const void* buffer, size_t size) {}
+
+private:
+    std::vector<uint8_t> _buffer;
+    size_t _size;
+    size_t _frame_size;
+    uint64_t _sequence;
+    uint64_t _count;
+    uint64_t _bytes;
+    // Delta state of the frame
+    uint32_t _symbol;
+    uint64_t _id;
+    uint64_t _price;
+
+    friend class MarketEventHandler<MarketEncoder>;
+    void onMarketEvent(const MarketEvent& event) { Encode(event); }
+};
+
+//! Decoded price level
+struct DecodedLevel
+{
+    //! Total volume
+    uint64_t Volume;
+    //! Visible volume
+    uint64_t Visible;
+    //! Orders count
+    uint64_t Orders;
+};
+
+//! Decoded order
+struct DecodedOrder
+{
+    //! Order side
+    OrderSide Side;
+    //! Order price
+    uint64_t Price;
+    //! Order leaves quantity
+    uint64_t Quantity;
+    //! Order visible quantity
+    uint64_t Visible;
+};
+
+//! Decoded order book auction
+struct DecodedAuction
+{
+    //! Equilibrium price
+    uint64_t Price;
+    //! Executable volume
+    uint64_t Volume;
+    //! Bid volume
+    uint64_t BidVolume;
+    //! Ask volume
+    uint64_t AskVolume;
+};
+
+//! Decoded order book
+struct DecodedOrderBook
+{
+    //! Symbol Id
+    uint32_t Id;
+    //! Bid price levels from the best to the worst one
+    std::map<uint64_t, DecodedLevel, std::greater<uint64_t>> Bids;
+    //! Ask price levels from the best to the worst one
+    std::map<uint64_t, DecodedLevel> Asks;
+    //! Orders by Id
+    std::unordered_map<uint64_t, DecodedOrder> Orders;
+    //! Last indicative auction state
+    DecodedAuction Auction;
+};
+
+//! Market decoder
+/*!
+    Market decoder decodes frames produced by MarketEncoder, passes each
+    decoded market event to onDecodedEvent() handler and rebuilds market-by-price
+    levels, market-by-order orders and the last indicative auction state of
+    all order books from them.
+
+    Mass cancel is reported by DELETE_ORDER market event per deleted order
+    followed by the summary DELETE_ORDERS market event, so the summary does
+    not change decoded orders.
+
+    Not thread-safe.
+*/
+class MarketDecoder
+{
+public:
+    MarketDecoder();
+    MarketDecoder(const MarketDecoder&) = delete;
+    MarketDecoder(MarketDecoder&&) = delete;
+    virtual ~MarketDecoder() = default;
+
+    MarketDecoder& operator=(const MarketDecoder&) = delete;
+    MarketDecoder& operator=(MarketDecoder&&) = delete;
+
+    //! Get the sequence number of the next expected market event
+    uint64_t sequence() const noexcept { return _sequence; }
+    //! Get the count of detected sequence gaps
+    uint64_t gaps() const noexcept { return _gaps; }
+
+    //! Get the decoded order book with the given Id
+    /*!
+        \param id - Symbol Id
+        \return Pointer to the decoded order book or nullptr
+    */
+    const DecodedOrderBook* GetOrderBook(uint32_t id) const noexcept
+    { return ((id < _order_books.size()) ? _order_books[id].get() : nullptr); }
+
+    //! Decode all complete frames from the given buffer
+    /*!
+        \param buffer - Buffer to decode
+        \param size - Buffer size
+        \return Count of consumed bytes (incomplete frame at the end of the buffer is not consumed)
+    */
+    size_t Decode(const void* buffer, size_t size);
+
+protected:
+    // Decoded market event handler
+    virtual void onDecodedEvent(const MarketEvent& event) {}
+
+private:
+    uint64_t _sequence;
+    uint64_t _gaps;
+    std::vector<std::unique_ptr<DecodedOrderBook>> _order_books;
+
+    void DecodeFrame(const uint8_t* buffer, size_t size, uint64_t count);
+    void Apply(const MarketEvent& event);
+    DecodedOrderBook& GetOrCreateOrderBook(uint32_t id);
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#endif // CPPTRADER_MATCHING_MARKET_CODEC_H
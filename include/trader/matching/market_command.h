@@ -0,0 +1,120 @@
+/*!
+    \file market_command.h
+    \brief Market command definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_COMMAND_H
+#define CPPTRADER_MATCHING_MARKET_COMMAND_H
+
+#include "errors.h"
+#include "order.h"
+
+#include <type_traits>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market command type
+enum class MarketCommandType : uint8_t
+{
+    NONE,
+    ADD_ORDER,
+    REDUCE_ORDER,
+    MODIFY_ORDER,
+    MITIGATE_ORDER,
+    REPLACE_ORDER,
+    DELETE_ORDER,
+    EXECUTE_ORDER
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, MarketCommandType type);
+
+//! Market command
+/*!
+    Market command is a fixed-size record of one MarketManager order
+    operation which is passed from order entry threads to the market
+    manager thread through MarketCommandQueue. Fields meaning depends
+    on the command type:
+    \li <b>ADD_ORDER</b> - NewOrder is the order to add;
+    \li <b>REDUCE_ORDER</b> - Id, Quantity is the quantity to reduce;
+    \li <b>MODIFY_ORDER, MITIGATE_ORDER</b> - Id, new Price and new Quantity;
+    \li <b>REPLACE_ORDER</b> - Id, NewId, new Price and new Quantity;
+    \li <b>DELETE_ORDER</b> - Id;
+    \li <b>EXECUTE_ORDER</b> - Id, Price (zero to execute at the order price)
+        and executed Quantity.
+
+    Not thread-safe.
+*/
+struct MarketCommand
+{
+    //! Command type
+    MarketCommandType Type;
+    //! Producer index (assigned by the command queue)
+    uint32_t Producer;
+    //! Command tag to match the command completion
+    uint64_t Tag;
+    //! Order Id
+    uint64_t Id;
+    //! New order Id
+    uint64_t NewId;
+    //! Price
+    uint64_t Price;
+    //! Quantity
+    uint64_t Quantity;
+    //! New order
+    Order NewOrder;
+
+    //! Prepare the add order command
+    static MarketCommand AddOrder(const Order& order, uint64_t tag = 0) noexcept;
+    //! Prepare the reduce order command
+    static MarketCommand ReduceOrder(uint64_t id, uint64_t quantity, uint64_t tag = 0) noexcept;
+    //! Prepare the modify order command
+    static MarketCommand ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity, uint64_t tag = 0) noexcept;
+    //! Prepare the mitigate order command
+    static MarketCommand MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity, uint64_t tag = 0) noexcept;
+    //! Prepare the replace order command
+    static MarketCommand ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity, uint64_t tag = 0) noexcept;
+    //! Prepare the delete order command
+    static MarketCommand DeleteOrder(uint64_t id, uint64_t tag = 0) noexcept;
+    //! Prepare the execute order command
+    static MarketCommand ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity, uint64_t tag = 0) noexcept;
+
+    template <class TOutputStream>
+    friend TOutputStream& operator<<(TOutputStream& stream, const MarketCommand& command);
+};
+
+//! Market command completion
+/*!
+    Market command completion is the result of the market command applied
+    by the market manager thread which is returned to the command producer.
+
+    Not thread-safe.
+*/
+struct MarketCompletion
+{
+    //! Command tag
+    uint64_t Tag;
+    //! Order Id
+    uint64_t Id;
+    //! Command type
+    MarketCommandType Type;
+    //! Command result
+    ErrorCode Result;
+
+    template <class TOutputStream>
+    friend TOutputStream& operator<<(TOutputStream& stream, const MarketCompletion& completion);
+};
+
+static_assert(std::is_trivially_copyable<MarketCommand>::value, "Market command must be trivially copyable!");
+static_assert(std::is_trivially_copyable<MarketCompletion>::value, "Market completion must be trivially copyable!");
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_command.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_COMMAND_H
@@ -0,0 +1,138 @@
+/*!
+    \file market_command.inl
+    \brief Market command inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, MarketCommandType type)
+{
+    switch (type)
+    {
+        case MarketCommandType::NONE:
+            stream << "NONE";
+            break;
+        case MarketCommandType::ADD_ORDER:
+            stream << "ADD-ORDER";
+            break;
+        case MarketCommandType::REDUCE_ORDER:
+            stream << "REDUCE-ORDER";
+            break;
+        case MarketCommandType::MODIFY_ORDER:
+            stream << "MODIFY-ORDER";
+            break;
+        case MarketCommandType::MITIGATE_ORDER:
+            stream << "MITIGATE-ORDER";
+            break;
+        case MarketCommandType::REPLACE_ORDER:
+            stream << "REPLACE-ORDER";
+            break;
+        case MarketCommandType::DELETE_ORDER:
+            stream << "DELETE-ORDER";
+            break;
+        case MarketCommandType::EXECUTE_ORDER:
+            stream << "EXECUTE-ORDER";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+inline MarketCommand MarketCommand::AddOrder(const Order& order, uint64_t tag) noexcept
+{
+    MarketCommand command = {};
+    command.Type = MarketCommandType::ADD_ORDER;
+    command.Tag = tag;
+    command.Id = order.Id;
+    command.NewOrder = order;
+    return command;
+}
+
+inline MarketCommand MarketCommand::ReduceOrder(uint64_t id, uint64_t quantity, uint64_t tag) noexcept
+{
+    MarketCommand command = {};
+    command.Type = MarketCommandType::REDUCE_ORDER;
+    command.Tag = tag;
+    command.Id = id;
+    command.Quantity = quantity;
+    return command;
+}
+
+inline MarketCommand MarketCommand::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity, uint64_t tag) noexcept
+{
+    MarketCommand command = {};
+    command.Type = MarketCommandType::MODIFY_ORDER;
+    command.Tag = tag;
+    command.Id = id;
+    command.Price = new_price;
+    command.Quantity = new_quantity;
+    return command;
+}
+
+inline MarketCommand MarketCommand::MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity, uint64_t tag) noexcept
+{
+    MarketCommand command = ModifyOrder(id, new_price, new_quantity, tag);
+    command.Type = MarketCommandType::MITIGATE_ORDER;
+    return command;
+}
+
+inline MarketCommand MarketCommand::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity, uint64_t tag) noexcept
+{
+    MarketCommand command = ModifyOrder(id, new_price, new_quantity, tag);
+    command.Type = MarketCommandType::REPLACE_ORDER;
+    command.NewId = new_id;
+    return command;
+}
+
+inline MarketCommand MarketCommand::DeleteOrder(uint64_t id, uint64_t tag) noexcept
+{
+    MarketCommand command = {};
+    command.Type = MarketCommandType::DELETE_ORDER;
+    command.Tag = tag;
+    command.Id = id;
+    return command;
+}
+
+inline MarketCommand MarketCommand::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity, uint64_t tag) noexcept
+{
+    MarketCommand command = ModifyOrder(id, price, quantity, tag);
+    command.Type = MarketCommandType::EXECUTE_ORDER;
+    return command;
+}
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, const MarketCommand& command)
+{
+    stream << "MarketCommand(Type=" << command.Type
+        << "; Producer=" << command.Producer
+        << "; Tag=" << command.Tag
+        << "; Id=" << command.Id
+        << "; NewId=" << command.NewId
+        << "; Price=" << command.Price
+        << "; Quantity=" << command.Quantity;
+    if (command.Type == MarketCommandType::ADD_ORDER)
+        stream << "; NewOrder=" << command.NewOrder;
+    stream << ")";
+    return stream;
+}
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, const MarketCompletion& completion)
+{
+    stream << "MarketCompletion(Tag=" << completion.Tag
+        << "; Id=" << completion.Id
+        << "; Type=" << completion.Type
+        << "; Result=" << completion.Result
+        << ")";
+    return stream;
+}
+
+} // namespace Matching
+} // namespace CppTrader
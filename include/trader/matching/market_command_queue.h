@@ -0,0 +1,136 @@
+/*!
+    \file market_command_queue.h
+    \brief Market command queue definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_COMMAND_QUEUE_H
+#define CPPTRADER_MATCHING_MARKET_COMMAND_QUEUE_H
+
+#include "market_command.h"
+#include "market_manager.h"
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market command queue
+/*!
+    Market command queue is an order entry front-end of the market manager.
+    It is a bounded lock-free multi-producer single-consumer ring of fixed-size
+    market commands. Order entry threads enqueue commands with their producer
+    index, the market manager thread drains them in batches with Drain() and
+    returns command results through per-producer single-producer single-consumer
+    completion rings.
+
+    Producer is never allowed to have more commands in flight than its
+    completion ring could hold, so the market manager thread never waits
+    for a slow producer to take its completions.
+
+    Thread-safe: each producer index should be used by one thread at a time,
+    Drain() should be called from the market manager thread only.
+*/
+class MarketCommandQueue
+{
+public:
+    //! Create the market command queue
+    /*!
+        \param capacity - Commands ring capacity (power of two, default is 64K commands)
+        \param producers - Count of producers (default is 16)
+        \param completions - Completion ring capacity of each producer (power of two, default is 4K completions)
+        \param batch - Maximal count of commands applied by one Drain() call (default is 64)
+    */
+    explicit MarketCommandQueue(size_t capacity = 64 * 1024, size_t producers = 16, size_t completions = 4 * 1024, size_t batch = 64);
+    MarketCommandQueue(const MarketCommandQueue&) = delete;
+    MarketCommandQueue(MarketCommandQueue&&) = delete;
+    ~MarketCommandQueue() = default;
+
+    MarketCommandQueue& operator=(const MarketCommandQueue&) = delete;
+    MarketCommandQueue& operator=(MarketCommandQueue&&) = delete;
+
+    //! Get the commands ring capacity
+    size_t capacity() const noexcept { return _capacity; }
+    //! Get the count of producers
+    size_t producers() const noexcept { return _producers_count; }
+
+    //! Enqueue the market command (producer thread)
+    /*!
+        \param producer - Producer index
+        \param command - Market command to enqueue
+        \return 'true' if the command was enqueued, 'false' if the commands ring is full or the producer has too many commands in flight
+    */
+    bool Enqueue(size_t producer, const MarketCommand& command) noexcept;
+
+    //! Dequeue the next market command completion (producer thread)
+    /*!
+        \param producer - Producer index
+        \param completion - Market command completion
+        \return 'true' if the completion was dequeued, 'false' if there are no completions
+    */
+    bool Dequeue(size_t producer, MarketCompletion& completion) noexcept;
+
+    //! Drain the batch of market commands into the market manager (market manager thread)
+    /*!
+        Dequeues up to the given limit of commands, prefetches order nodes
+        of all of them and applies them one by one in the enqueue order.
+
+        \param market - Market manager
+        \param limit - Maximal count of commands to apply (default is the batch size)
+        \return Count of applied commands
+    */
+    size_t Drain(MarketManager& market, size_t limit = std::numeric_limits<size_t>::max());
+
+    //! Apply the market command to the market manager
+    /*!
+        Command is validated before it is applied, so invalid order Ids
+        are reported with an error code instead of market manager asserts.
+        Missing orders are reported by the market manager with
+        ErrorCode::ORDER_NOT_FOUND without an additional order lookup.
+
+        \param market - Market manager
+        \param command - Market command to apply
+        \return Error code
+    */
+    static ErrorCode Apply(MarketManager& market, const MarketCommand& command);
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> Sequence;
+        MarketCommand Command;
+    };
+
+    struct Producer
+    {
+        // Producer cache line
+        alignas(64) uint64_t Submitted;
+        std::atomic<uint64_t> Tail;
+        // Consumer cache line
+        alignas(64) std::atomic<uint64_t> Head;
+        std::unique_ptr<MarketCompletion[]> Completions;
+    };
+
+    size_t _capacity;
+    std::unique_ptr<Slot[]> _slots;
+    size_t _producers_count;
+    size_t _completions;
+    std::unique_ptr<Producer[]> _producers;
+    std::vector<MarketCommand> _batch;
+    alignas(64) std::atomic<uint64_t> _enqueue;
+    alignas(64) uint64_t _dequeue;
+
+    bool TryDequeue(MarketCommand& command) noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_command_queue.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_COMMAND_QUEUE_H
@@ -0,0 +1,77 @@
+/*!
+    \file market_command_queue.inl
+    \brief Market command queue inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline bool MarketCommandQueue::Enqueue(size_t producer, const MarketCommand& command) noexcept
+{
+    assert((producer < _producers_count) && "Invalid market command producer!");
+    Producer& owner = _producers[producer];
+
+    // Limit commands in flight with the completion ring capacity
+    if ((owner.Submitted - owner.Tail.load(std::memory_order_relaxed)) >= _completions)
+        return false;
+
+    // Claim the free slot
+    Slot* slot;
+    uint64_t position = _enqueue.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        slot = &_slots[position & (_capacity - 1)];
+        int64_t difference = (int64_t)(slot->Sequence.load(std::memory_order_acquire) - position);
+        if (difference == 0)
+        {
+            if (_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+            return false;
+        else
+            position = _enqueue.load(std::memory_order_relaxed);
+    }
+
+    // Publish the command
+    slot->Command = command;
+    slot->Command.Producer = (uint32_t)producer;
+    slot->Sequence.store(position + 1, std::memory_order_release);
+
+    ++owner.Submitted;
+    return true;
+}
+
+inline bool MarketCommandQueue::Dequeue(size_t producer, MarketCompletion& completion) noexcept
+{
+    assert((producer < _producers_count) && "Invalid market command producer!");
+    Producer& owner = _producers[producer];
+
+    uint64_t tail = owner.Tail.load(std::memory_order_relaxed);
+    if (tail == owner.Head.load(std::memory_order_acquire))
+        return false;
+
+    completion = owner.Completions[tail & (_completions - 1)];
+    owner.Tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+inline bool MarketCommandQueue::TryDequeue(MarketCommand& command) noexcept
+{
+    Slot& slot = _slots[_dequeue & (_capacity - 1)];
+    if (slot.Sequence.load(std::memory_order_acquire) != (_dequeue + 1))
+        return false;
+
+    command = slot.Command;
+
+    // Release the slot for the next lap of producers
+    slot.Sequence.store(_dequeue + _capacity, std::memory_order_release);
+    ++_dequeue;
+    return true;
+}
+
+} // namespace Matching
+} // namespace CppTrader
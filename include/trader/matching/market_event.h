@@ -0,0 +1,125 @@
+/*!
+    \file market_event.h
+    \brief Market event definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_EVENT_H
+#define CPPTRADER_MATCHING_MARKET_EVENT_H
+
+#include "auction.h"
+#include "level.h"
+#include "order.h"
+#include "order_book.h"
+#include "symbol.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market event type
+enum class MarketEventType : uint8_t
+{
+    NONE,
+    ADD_ORDER_BOOK,
+    DELETE_ORDER_BOOK,
+    ADD_LEVEL,
+    UPDATE_LEVEL,
+    DELETE_LEVEL,
+    ADD_ORDER,
+    UPDATE_ORDER,
+    REPLACE_ORDER,
+    DELETE_ORDER,
+    DELETE_ORDERS,
+    EXECUTE_ORDER,
+    SNAPSHOT_BEGIN,
+    SNAPSHOT_BOOK,
+    SNAPSHOT_LEVEL,
+    SNAPSHOT_ORDER,
+    SNAPSHOT_END,
+    ADD_SYMBOL,
+    DELETE_SYMBOL,
+    UPDATE_AUCTION
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, MarketEventType type);
+
+//! Market event
+/*!
+    Market event is a fixed-size binary record of one MarketHandler event
+    which could be copied between threads and processes as is. Fields
+    meaning depends on the event type:
+    \li <b>ADD/UPDATE/DELETE_LEVEL, SNAPSHOT_LEVEL</b> - Price, Quantity is
+        the total volume, Visible is the visible volume, Value is the orders
+        count, Top is the top of the book flag;
+    \li <b>ADD/UPDATE/DELETE_ORDER, SNAPSHOT_ORDER</b> - Id, Price, Quantity is
+        the leaves quantity, Visible is the visible quantity, Value is the
+        executed quantity;
+    \li <b>REPLACE_ORDER</b> - the same as the order event, but Value is the
+        old order Id;
+    \li <b>EXECUTE_ORDER</b> - Id, Price and Quantity of the execution, Value
+        is the order leaves quantity before the execution;
+    \li <b>DELETE_ORDERS</b> - Quantity is the deleted volume, Value is the
+        deleted orders count;
+    \li <b>SNAPSHOT_BEGIN</b> - Value is the order books count;
+    \li <b>SNAPSHOT_BOOK</b> - Value is the price levels count of the order book;
+    \li <b>ADD/DELETE_SYMBOL</b> - Value is the symbol name packed into 8 bytes;
+    \li <b>UPDATE_AUCTION</b> - Price is the equilibrium price, Quantity is the
+        executable volume, Visible is the bid volume, Value is the ask volume.
+
+    Not thread-safe.
+*/
+struct MarketEvent
+{
+    //! Event type
+    MarketEventType Type;
+    //! Order side or price level side (BUY for bids, SELL for asks)
+    OrderSide Side;
+    //! Top of the book flag
+    bool Top;
+    //! Symbol Id
+    uint32_t SymbolId;
+    //! Order Id
+    uint64_t Id;
+    //! Price
+    uint64_t Price;
+    //! Quantity
+    uint64_t Quantity;
+    //! Visible quantity
+    uint64_t Visible;
+    //! Auxiliary value
+    uint64_t Value;
+
+    //! Prepare the market event of the given type
+    static MarketEvent FromType(MarketEventType type, uint64_t value = 0) noexcept;
+    //! Prepare the symbol event
+    static MarketEvent FromSymbol(MarketEventType type, const Symbol& symbol) noexcept;
+    //! Prepare the order book event
+    static MarketEvent FromBook(MarketEventType type, const OrderBook& order_book, uint64_t value = 0) noexcept;
+    //! Prepare the order book auction event
+    static MarketEvent FromAuction(const OrderBook& order_book, const Auction& auction) noexcept;
+    //! Prepare the price level event
+    static MarketEvent FromLevel(MarketEventType type, const OrderBook& order_book, const Level& level, bool top) noexcept;
+    //! Prepare the order event
+    static MarketEvent FromOrder(MarketEventType type, const Order& order, uint64_t value) noexcept;
+    //! Prepare the order execution event
+    static MarketEvent FromExecution(const Order& order, uint64_t price, uint64_t quantity) noexcept;
+
+    template <class TOutputStream>
+    friend TOutputStream& operator<<(TOutputStream& stream, const MarketEvent& event);
+};
+
+static_assert(std::is_trivially_copyable<MarketEvent>::value, "Market event must be trivially copyable!");
+static_assert(sizeof(MarketEvent) == 48, "Market event must be 48 bytes!");
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_event.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_EVENT_H
@@ -0,0 +1,175 @@
+/*!
+    \file market_event.inl
+    \brief Market event inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, MarketEventType type)
+{
+    switch (type)
+    {
+        case MarketEventType::NONE:
+            stream << "NONE";
+            break;
+        case MarketEventType::ADD_ORDER_BOOK:
+            stream << "ADD-ORDER-BOOK";
+            break;
+        case MarketEventType::DELETE_ORDER_BOOK:
+            stream << "DELETE-ORDER-BOOK";
+            break;
+        case MarketEventType::ADD_LEVEL:
+            stream << "ADD-LEVEL";
+            break;
+        case MarketEventType::UPDATE_LEVEL:
+            stream << "UPDATE-LEVEL";
+            break;
+        case MarketEventType::DELETE_LEVEL:
+            stream << "DELETE-LEVEL";
+            break;
+        case MarketEventType::ADD_ORDER:
+            stream << "ADD-ORDER";
+            break;
+        case MarketEventType::UPDATE_ORDER:
+            stream << "UPDATE-ORDER";
+            break;
+        case MarketEventType::REPLACE_ORDER:
+            stream << "REPLACE-ORDER";
+            break;
+        case MarketEventType::DELETE_ORDER:
+            stream << "DELETE-ORDER";
+            break;
+        case MarketEventType::DELETE_ORDERS:
+            stream << "DELETE-ORDERS";
+            break;
+        case MarketEventType::EXECUTE_ORDER:
+            stream << "EXECUTE-ORDER";
+            break;
+        case MarketEventType::SNAPSHOT_BEGIN:
+            stream << "SNAPSHOT-BEGIN";
+            break;
+        case MarketEventType::SNAPSHOT_BOOK:
+            stream << "SNAPSHOT-BOOK";
+            break;
+        case MarketEventType::SNAPSHOT_LEVEL:
+            stream << "SNAPSHOT-LEVEL";
+            break;
+        case MarketEventType::SNAPSHOT_ORDER:
+            stream << "SNAPSHOT-ORDER";
+            break;
+        case MarketEventType::SNAPSHOT_END:
+            stream << "SNAPSHOT-END";
+            break;
+        case MarketEventType::ADD_SYMBOL:
+            stream << "ADD-SYMBOL";
+            break;
+        case MarketEventType::DELETE_SYMBOL:
+            stream << "DELETE-SYMBOL";
+            break;
+        case MarketEventType::UPDATE_AUCTION:
+            stream << "UPDATE-AUCTION";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+inline MarketEvent MarketEvent::FromType(MarketEventType type, uint64_t value) noexcept
+{
+    MarketEvent event = {};
+    event.Type = type;
+    event.Value = value;
+    return event;
+}
+
+inline MarketEvent MarketEvent::FromSymbol(MarketEventType type, const Symbol& symbol) noexcept
+{
+    MarketEvent event = FromType(type);
+    event.SymbolId = symbol.Id;
+    static_assert(sizeof(symbol.Name) == sizeof(event.Value), "Symbol name must fit into the market event value!");
+    std::memcpy(&event.Value, symbol.Name, sizeof(event.Value));
+    return event;
+}
+
+inline MarketEvent MarketEvent::FromBook(MarketEventType type, const OrderBook& order_book, uint64_t value) noexcept
+{
+    MarketEvent event = FromType(type, value);
+    event.SymbolId = order_book.symbol().Id;
+    return event;
+}
+
+inline MarketEvent MarketEvent::FromAuction(const OrderBook& order_book, const Auction& auction) noexcept
+{
+    MarketEvent event = FromBook(MarketEventType::UPDATE_AUCTION, order_book, auction.AskVolume);
+    event.Price = auction.Price;
+    event.Quantity = auction.Volume;
+    event.Visible = auction.BidVolume;
+    return event;
+}
+
+inline MarketEvent MarketEvent::FromLevel(MarketEventType type, const OrderBook& order_book, const Level& level, bool top) noexcept
+{
+    MarketEvent event = {};
+    event.Type = type;
+    event.Side = level.IsBid() ? OrderSide::BUY : OrderSide::SELL;
+    event.Top = top;
+    event.SymbolId = order_book.symbol().Id;
+    event.Price = level.Price;
+    event.Quantity = level.TotalVolume;
+    event.Visible = level.VisibleVolume;
+    event.Value = level.Orders;
+    return event;
+}
+
+inline MarketEvent MarketEvent::FromOrder(MarketEventType type, const Order& order, uint64_t value) noexcept
+{
+    MarketEvent event = {};
+    event.Type = type;
+    event.Side = order.Side;
+    event.SymbolId = order.SymbolId;
+    event.Id = order.Id;
+    event.Price = order.Price;
+    event.Quantity = order.LeavesQuantity;
+    event.Visible = order.VisibleQuantity();
+    event.Value = value;
+    return event;
+}
+
+inline MarketEvent MarketEvent::FromExecution(const Order& order, uint64_t price, uint64_t quantity) noexcept
+{
+    MarketEvent event = {};
+    event.Type = MarketEventType::EXECUTE_ORDER;
+    event.Side = order.Side;
+    event.SymbolId = order.SymbolId;
+    event.Id = order.Id;
+    event.Price = price;
+    event.Quantity = quantity;
+    event.Value = order.LeavesQuantity;
+    return event;
+}
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, const MarketEvent& event)
+{
+    stream << "MarketEvent(Type=" << event.Type
+        << "; Side=" << event.Side
+        << "; Top=" << (event.Top ? "true" : "false")
+        << "; SymbolId=" << event.SymbolId
+        << "; Id=" << event.Id
+        << "; Price=" << event.Price
+        << "; Quantity=" << event.Quantity
+        << "; Visible=" << event.Visible
+        << "; Value=" << event.Value
+        << ")";
+    return stream;
+}
+
+} // namespace Matching
+} // namespace CppTrader
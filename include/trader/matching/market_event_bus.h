@@ -0,0 +1,148 @@
+/*!
+    \file market_event_bus.h
+    \brief Market event bus definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_EVENT_BUS_H
+#define CPPTRADER_MATCHING_MARKET_EVENT_BUS_H
+
+#include "market_event_handler.h"
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+class MarketEventBus;
+
+//! Market event bus consumer
+/*!
+    Market event bus consumer reads market events published into the bus
+    with its own sequence. Each consumer is polled by a single thread.
+    Consumer could depend on other consumers of the same bus (sequence
+    barrier), in this case it never reads events that are not yet consumed
+    by all its dependencies.
+
+    Thread-safe for a single polling thread.
+*/
+class MarketEventBusConsumer
+{
+    friend class MarketEventBus;
+
+public:
+    MarketEventBusConsumer(const MarketEventBusConsumer&) = delete;
+    MarketEventBusConsumer(MarketEventBusConsumer&&) = delete;
+    ~MarketEventBusConsumer() = default;
+
+    MarketEventBusConsumer& operator=(const MarketEventBusConsumer&) = delete;
+    MarketEventBusConsumer& operator=(MarketEventBusConsumer&&) = delete;
+
+    //! Get the consumer sequence (count of consumed market events)
+    uint64_t sequence() const noexcept { return _sequence.load(std::memory_order_acquire); }
+
+    //! Get the count of market events available for the consumer
+    uint64_t available() const noexcept { return Barrier() - _sequence.load(std::memory_order_relaxed); }
+
+    //! Poll the available market events
+    /*!
+        Consumer handles all market events available at the moment of the
+        call (but no more than the given limit) as a single batch and then
+        releases them for the publisher and dependent consumers at once.
+
+        \param handler - Market event handler with the signature void handler(const MarketEvent& event)
+        \param limit - Market events limit (default is unlimited)
+        \return Count of handled market events
+    */
+    template <class THandler>
+    size_t Poll(THandler&& handler, size_t limit = std::numeric_limits<size_t>::max());
+
+private:
+    alignas(64) std::atomic<uint64_t> _sequence;
+    const MarketEventBus& _bus;
+    std::vector<const MarketEventBusConsumer*> _dependencies;
+
+    MarketEventBusConsumer(const MarketEventBus& bus, const std::vector<const MarketEventBusConsumer*>& dependencies);
+
+    uint64_t Barrier() const noexcept;
+};
+
+//! Market event bus
+/*!
+    Market event bus is an in-process disruptor-style market handler. Market
+    manager writes each market event once into the pre-allocated ring and any
+    number of consumers read it from their own threads at their own pace with
+    batched consumption, so slow consumers do not add latency to matching
+    until the ring is full. The full ring blocks the publisher until the
+    slowest consumer releases the oldest slot, no market event is ever lost.
+
+    All consumers should be added before the first market event is published.
+
+    Not thread-safe for the publisher (market manager owner thread).
+*/
+class MarketEventBus : public MarketEventHandler<MarketEventBus>
+{
+    friend class MarketEventBusConsumer;
+
+public:
+    //! Create the market event bus
+    /*!
+        \param capacity - Ring capacity in events (power of two, default is 64K events)
+    */
+    explicit MarketEventBus(size_t capacity = 64 * 1024);
+    MarketEventBus(const MarketEventBus&) = delete;
+    MarketEventBus(MarketEventBus&&) = delete;
+    virtual ~MarketEventBus() = default;
+
+    MarketEventBus& operator=(const MarketEventBus&) = delete;
+    MarketEventBus& operator=(MarketEventBus&&) = delete;
+
+    //! Get the ring capacity in events
+    size_t capacity() const noexcept { return _events.size(); }
+    //! Get the bus sequence (count of published market events)
+    uint64_t sequence() const noexcept { return _published.load(std::memory_order_acquire); }
+    //! Get the bus consumers
+    const std::vector<std::unique_ptr<MarketEventBusConsumer>>& consumers() const noexcept { return _consumers; }
+
+    //! Add a new consumer
+    /*!
+        \param dependencies - Consumers which should handle each market event before the new one (default is none)
+        \return Consumer which lives as long as the bus
+    */
+    MarketEventBusConsumer& AddConsumer(const std::vector<const MarketEventBusConsumer*>& dependencies = {});
+
+    //! Publish the market event
+    /*!
+        Waits for the slowest consumer if the ring is full.
+
+        \param event - Market event to publish
+    */
+    void Publish(const MarketEvent& event) noexcept;
+
+private:
+    std::vector<MarketEvent> _events;
+    uint64_t _mask;
+    // Publisher sequence and the cached slowest consumer sequence
+    uint64_t _sequence;
+    uint64_t _gating;
+    alignas(64) std::atomic<uint64_t> _published;
+    std::vector<std::unique_ptr<MarketEventBusConsumer>> _consumers;
+
+    uint64_t Gating() const noexcept;
+
+    friend class MarketEventHandler<MarketEventBus>;
+    void onMarketEvent(const MarketEvent& event) noexcept { Publish(event); }
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_event_bus.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_EVENT_BUS_H
@@ -0,0 +1,70 @@
+/*!
+    \file market_event_bus.inl
+    \brief Market event bus inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class THandler>
+inline size_t MarketEventBusConsumer::Poll(THandler&& handler, size_t limit)
+{
+    uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+    uint64_t available = Barrier() - sequence;
+    if (available == 0)
+        return 0;
+
+    size_t count = (available < limit) ? (size_t)available : limit;
+
+    // Handle the whole batch of market events
+    for (size_t i = 0; i < count; ++i)
+        handler(_bus._events[(sequence + i) & _bus._mask]);
+
+    // Release the batch for the publisher and dependent consumers
+    _sequence.store(sequence + count, std::memory_order_release);
+
+    return count;
+}
+
+inline uint64_t MarketEventBusConsumer::Barrier() const noexcept
+{
+    uint64_t barrier = _bus._published.load(std::memory_order_acquire);
+    for (auto dependency : _dependencies)
+    {
+        uint64_t sequence = dependency->_sequence.load(std::memory_order_acquire);
+        if (sequence < barrier)
+            barrier = sequence;
+    }
+    return barrier;
+}
+
+inline void MarketEventBus::Publish(const MarketEvent& event) noexcept
+{
+    // Wait for the slowest consumer to release the slot of the full ring
+    if ((_sequence - _gating) >= _events.size())
+        while ((_sequence - (_gating = Gating())) >= _events.size())
+            std::this_thread::yield();
+
+    _events[_sequence & _mask] = event;
+
+    // Make the market event visible to consumers
+    _published.store(++_sequence, std::memory_order_release);
+}
+
+inline uint64_t MarketEventBus::Gating() const noexcept
+{
+    uint64_t gating = _sequence;
+    for (const auto& consumer : _consumers)
+    {
+        uint64_t sequence = consumer->_sequence.load(std::memory_order_acquire);
+        if (sequence < gating)
+            gating = sequence;
+    }
+    return gating;
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,66 @@
+/*!
+    \file market_event_handler.h
+    \brief Market event handler definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_EVENT_HANDLER_H
+#define CPPTRADER_MATCHING_MARKET_EVENT_HANDLER_H
+
+#include "market_event.h"
+#include "market_handler.h"
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market event handler
+/*!
+    Market event handler converts symbol, order book, auction, price level,
+    order and execution handlers of the market manager into fixed-size market
+    events and passes them to the onMarketEvent(const MarketEvent& event)
+    method of the derived class without an additional virtual call (CRTP).
+
+    onUpdateOrderBook() handler is deliberately not converted: it always
+    follows the price level handlers of the same change, whose market events
+    already carry the top of the book flag, so forwarding it would double the
+    event traffic without adding any information. Derived classes which need
+    it could still override the handler.
+
+    Not thread-safe.
+*/
+template <class TDerived>
+class MarketEventHandler : public MarketHandler
+{
+protected:
+    void onAddSymbol(const Symbol& symbol) override;
+    void onDeleteSymbol(const Symbol& symbol) override;
+
+    void onAddOrderBook(const OrderBook& order_book) override;
+    void onDeleteOrderBook(const OrderBook& order_book) override;
+
+    void onUpdateAuction(const OrderBook& order_book, const Auction& auction) override;
+
+    void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override;
+    void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override;
+    void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override;
+
+    void onAddOrder(const Order& order) override;
+    void onUpdateOrder(const Order& order) override;
+    void onReplaceOrder(const Order& old_order, const Order& order) override;
+    void onDeleteOrder(const Order& order) override;
+    void onDeleteOrders(const OrderBook& order_book, size_t orders, uint64_t volume) override;
+
+    void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override;
+
+private:
+    void Dispatch(const MarketEvent& event) { static_cast<TDerived&>(*this).onMarketEvent(event); }
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_event_handler.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_EVENT_HANDLER_H
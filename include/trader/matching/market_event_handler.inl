@@ -0,0 +1,99 @@
+/*!
+    \file market_event_handler.inl
+    \brief Market event handler inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onAddSymbol(const Symbol& symbol)
+{
+    Dispatch(MarketEvent::FromSymbol(MarketEventType::ADD_SYMBOL, symbol));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onDeleteSymbol(const Symbol& symbol)
+{
+    Dispatch(MarketEvent::FromSymbol(MarketEventType::DELETE_SYMBOL, symbol));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onAddOrderBook(const OrderBook& order_book)
+{
+    Dispatch(MarketEvent::FromBook(MarketEventType::ADD_ORDER_BOOK, order_book));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onDeleteOrderBook(const OrderBook& order_book)
+{
+    Dispatch(MarketEvent::FromBook(MarketEventType::DELETE_ORDER_BOOK, order_book));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onUpdateAuction(const OrderBook& order_book, const Auction& auction)
+{
+    Dispatch(MarketEvent::FromAuction(order_book, auction));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onAddLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    Dispatch(MarketEvent::FromLevel(MarketEventType::ADD_LEVEL, order_book, level, top));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onUpdateLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    Dispatch(MarketEvent::FromLevel(MarketEventType::UPDATE_LEVEL, order_book, level, top));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onDeleteLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    Dispatch(MarketEvent::FromLevel(MarketEventType::DELETE_LEVEL, order_book, level, top));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onAddOrder(const Order& order)
+{
+    Dispatch(MarketEvent::FromOrder(MarketEventType::ADD_ORDER, order, order.ExecutedQuantity));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onUpdateOrder(const Order& order)
+{
+    Dispatch(MarketEvent::FromOrder(MarketEventType::UPDATE_ORDER, order, order.ExecutedQuantity));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onReplaceOrder(const Order& old_order, const Order& order)
+{
+    Dispatch(MarketEvent::FromOrder(MarketEventType::REPLACE_ORDER, order, old_order.Id));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onDeleteOrder(const Order& order)
+{
+    Dispatch(MarketEvent::FromOrder(MarketEventType::DELETE_ORDER, order, order.ExecutedQuantity));
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onDeleteOrders(const OrderBook& order_book, size_t orders, uint64_t volume)
+{
+    MarketEvent event = MarketEvent::FromBook(MarketEventType::DELETE_ORDERS, order_book, orders);
+    event.Quantity = volume;
+    Dispatch(event);
+}
+
+template <class TDerived>
+inline void MarketEventHandler<TDerived>::onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity)
+{
+    Dispatch(MarketEvent::FromExecution(order, price, quantity));
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,186 @@
+/*!
+    \file market_event_ring.h
+    \brief Market event ring definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_EVENT_RING_H
+#define CPPTRADER_MATCHING_MARKET_EVENT_RING_H
+
+#include "market_event.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market event ring read status
+enum class MarketEventRingStatus : uint8_t
+{
+    OK,
+    EMPTY,
+    OVERRUN
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, MarketEventRingStatus status);
+
+//! Market event ring
+/*!
+    Single-producer, multi-consumer ring of fixed-size market events placed
+    into the given memory block, so the same ring could be shared between
+    processes with a shared memory block. The producer never waits for the
+    consumers and never makes system calls: each event is copied into the
+    next ring slot stamped with its sequence number.
+
+    Each consumer keeps its own cursor with MarketEventRingReader. Consumer
+    which falls behind more than the ring capacity detects the overrun by
+    the slot stamp, calls MarketEventRingReader::Resync() to request a new
+    snapshot and skips events until the snapshot begins.
+
+    Ring capacity must be a power of two and must be greater than the size
+    of the market snapshot.
+
+    Thread-safe for one producer and many consumers.
+*/
+class MarketEventRing
+{
+    friend class MarketEventRingReader;
+
+public:
+    //! Initialize the ring in the given memory block
+    /*!
+        The ring continues the sequence of the valid ring with the same capacity
+        found in the memory block, so connected consumers are not broken by
+        the producer restart.
+
+        \param buffer - Memory block of MarketEventRing::Size(capacity) bytes
+        \param capacity - Ring capacity (power of two)
+    */
+    MarketEventRing(void* buffer, size_t capacity) noexcept;
+    MarketEventRing(const MarketEventRing&) = delete;
+    MarketEventRing(MarketEventRing&&) = delete;
+    ~MarketEventRing() = default;
+
+    MarketEventRing& operator=(const MarketEventRing&) = delete;
+    MarketEventRing& operator=(MarketEventRing&&) = delete;
+
+    //! Get the memory block size required for the ring with the given capacity
+    static size_t Size(size_t capacity) noexcept;
+
+    //! Get the ring capacity
+    size_t capacity() const noexcept { return _capacity; }
+    //! Get the count of published events
+    uint64_t sequence() const noexcept { return _sequence; }
+
+    //! Publish the market event
+    void Publish(const MarketEvent& event) noexcept;
+
+    //! Is a new market snapshot requested by any consumer?
+    bool IsSnapshotRequested() const noexcept;
+    //! Acknowledge all snapshot requests before publishing a new snapshot
+    void AcknowledgeSnapshot() noexcept;
+
+private:
+    static constexpr uint64_t MAGIC = 0x474E4952544B4D43ull;
+    static constexpr size_t WORDS = sizeof(MarketEvent) / sizeof(uint64_t);
+
+    // Ring header with the producer and consumers data on separate cache lines
+    struct Header
+    {
+        std::atomic<uint64_t> Magic;
+        uint64_t Capacity;
+        alignas(64) std::atomic<uint64_t> Sequence;
+        alignas(64) std::atomic<uint64_t> SnapshotRequests;
+    };
+
+    // Ring slot stamped with '2 * sequence + 2' when the event is published
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> Stamp;
+        std::atomic<uint64_t> Data[WORDS];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Market event ring requires lock-free 64-bit atomics!");
+
+    Header* _header;
+    Slot* _slots;
+    size_t _capacity;
+    uint64_t _sequence;
+    uint64_t _snapshot_requests;
+};
+
+//! Market event ring reader
+/*!
+    Market event ring reader keeps the consumer cursor in the market event ring.
+    New reader starts from the current ring sequence and requests a snapshot,
+    unless nothing was published into the ring yet. Reader created before the
+    producer attaches to the ring with the first read after the producer has
+    initialized it.
+
+    Not thread-safe.
+*/
+class MarketEventRingReader
+{
+public:
+    //! Attach to the ring in the given memory block
+    /*!
+        \param buffer - Memory block of MarketEventRing::Size(capacity) bytes
+        \param capacity - Ring capacity (power of two)
+    */
+    MarketEventRingReader(void* buffer, size_t capacity) noexcept;
+    MarketEventRingReader(const MarketEventRingReader&) = delete;
+    MarketEventRingReader(MarketEventRingReader&&) = delete;
+    ~MarketEventRingReader() = default;
+
+    MarketEventRingReader& operator=(const MarketEventRingReader&) = delete;
+    MarketEventRingReader& operator=(MarketEventRingReader&&) = delete;
+
+    //! Is the ring initialized by the producer?
+    bool valid() const noexcept;
+    //! Is the reader attached to the ring?
+    bool attached() const noexcept { return _attached; }
+    //! Is the reader synchronized with the producer?
+    bool synchronized() const noexcept { return _synchronized; }
+    //! Get the reader cursor
+    uint64_t cursor() const noexcept { return _cursor; }
+
+    //! Read the next market event
+    /*!
+        Events before the snapshot are skipped while the reader is not synchronized.
+        Overrun is reported until MarketEventRingReader::Resync() is called.
+
+        \param event - Market event to read
+        \return Read status
+    */
+    MarketEventRingStatus Read(MarketEvent& event) noexcept;
+
+    //! Resynchronize the reader with the producer
+    /*!
+        Moves the cursor to the current ring sequence and requests a new market
+        snapshot. Consumer should reset its state with the SNAPSHOT_BEGIN event.
+    */
+    void Resync() noexcept;
+
+private:
+    MarketEventRing::Header* _header;
+    MarketEventRing::Slot* _slots;
+    size_t _capacity;
+    uint64_t _cursor;
+    bool _attached;
+    bool _synchronized;
+    bool _overrun;
+
+    // Attach to the initialized ring
+    void Attach() noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_event_ring.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_EVENT_RING_H
@@ -0,0 +1,201 @@
+/*!
+    \file market_event_ring.inl
+    \brief Market event ring inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, MarketEventRingStatus status)
+{
+    switch (status)
+    {
+        case MarketEventRingStatus::OK:
+            stream << "OK";
+            break;
+        case MarketEventRingStatus::EMPTY:
+            stream << "EMPTY";
+            break;
+        case MarketEventRingStatus::OVERRUN:
+            stream << "OVERRUN";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+inline size_t MarketEventRing::Size(size_t capacity) noexcept
+{
+    return sizeof(Header) + capacity * sizeof(Slot);
+}
+
+inline MarketEventRing::MarketEventRing(void* buffer, size_t capacity) noexcept
+    : _header((Header*)buffer),
+      _slots((Slot*)((uint8_t*)buffer + sizeof(Header))),
+      _capacity(capacity),
+      _sequence(0),
+      _snapshot_requests(0)
+{
+    assert((buffer != nullptr) && "Market event ring buffer must not be null!");
+    assert((capacity > 0) && ((capacity & (capacity - 1)) == 0) && "Market event ring capacity must be a power of two!");
+
+    // Continue the valid ring with the same capacity
+    if ((_header->Magic.load(std::memory_order_acquire) == MAGIC) && (_header->Capacity == capacity))
+    {
+        _sequence = _header->Sequence.load(std::memory_order_relaxed);
+        _snapshot_requests = _header->SnapshotRequests.load(std::memory_order_relaxed);
+        return;
+    }
+
+    // Initialize a new ring
+    _header->Magic.store(0, std::memory_order_relaxed);
+    _header->Capacity = capacity;
+    _header->Sequence.store(0, std::memory_order_relaxed);
+    _header->SnapshotRequests.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < capacity; ++i)
+        _slots[i].Stamp.store(0, std::memory_order_relaxed);
+    _header->Magic.store(MAGIC, std::memory_order_release);
+}
+
+inline void MarketEventRing::Publish(const MarketEvent& event) noexcept
+{
+    uint64_t data[WORDS];
+    std::memcpy(data, &event, sizeof(MarketEvent));
+
+    Slot& slot = _slots[_sequence & (_capacity - 1)];
+
+    // Mark the slot as being written
+    slot.Stamp.store(2 * _sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < WORDS; ++i)
+        slot.Data[i].store(data[i], std::memory_order_relaxed);
+
+    // Mark the slot as published and publish the new ring sequence
+    slot.Stamp.store(2 * _sequence + 2, std::memory_order_release);
+    _header->Sequence.store(++_sequence, std::memory_order_release);
+}
+
+inline bool MarketEventRing::IsSnapshotRequested() const noexcept
+{
+    return _header->SnapshotRequests.load(std::memory_order_relaxed) != _snapshot_requests;
+}
+
+inline void MarketEventRing::AcknowledgeSnapshot() noexcept
+{
+    _snapshot_requests = _header->SnapshotRequests.load(std::memory_order_acquire);
+}
+
+inline MarketEventRingReader::MarketEventRingReader(void* buffer, size_t capacity) noexcept
+    : _header((MarketEventRing::Header*)buffer),
+      _slots((MarketEventRing::Slot*)((uint8_t*)buffer + sizeof(MarketEventRing::Header))),
+      _capacity(capacity),
+      _cursor(0),
+      _attached(false),
+      _synchronized(false),
+      _overrun(false)
+{
+    assert((buffer != nullptr) && "Market event ring buffer must not be null!");
+    assert((capacity > 0) && ((capacity & (capacity - 1)) == 0) && "Market event ring capacity must be a power of two!");
+
+    if (valid())
+        Attach();
+}
+
+inline void MarketEventRingReader::Attach() noexcept
+{
+    _attached = true;
+
+    // Read from the beginning of the empty ring or request a new snapshot
+    if (_header->Sequence.load(std::memory_order_acquire) == 0)
+        _synchronized = true;
+    else
+        Resync();
+}
+
+inline bool MarketEventRingReader::valid() const noexcept
+{
+    return (_header->Magic.load(std::memory_order_acquire) == MarketEventRing::MAGIC) && (_header->Capacity == _capacity);
+}
+
+inline MarketEventRingStatus MarketEventRingReader::Read(MarketEvent& event) noexcept
+{
+    if (!_attached)
+    {
+        if (!valid())
+            return MarketEventRingStatus::EMPTY;
+        Attach();
+    }
+
+    if (_overrun)
+        return MarketEventRingStatus::OVERRUN;
+
+    for (;;)
+    {
+        uint64_t sequence = _header->Sequence.load(std::memory_order_acquire);
+        if (_cursor == sequence)
+            return MarketEventRingStatus::EMPTY;
+
+        // Check the cursor is still inside the ring
+        if ((sequence - _cursor) > _capacity)
+        {
+            _overrun = true;
+            return MarketEventRingStatus::OVERRUN;
+        }
+
+        const MarketEventRing::Slot& slot = _slots[_cursor & (_capacity - 1)];
+        uint64_t stamp = 2 * _cursor + 2;
+
+        // Check the slot was not overwritten before the read
+        if (slot.Stamp.load(std::memory_order_acquire) != stamp)
+        {
+            _overrun = true;
+            return MarketEventRingStatus::OVERRUN;
+        }
+
+        uint64_t data[MarketEventRing::WORDS];
+        for (size_t i = 0; i < MarketEventRing::WORDS; ++i)
+            data[i] = slot.Data[i].load(std::memory_order_relaxed);
+
+        // Check the slot was not overwritten during the read
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.Stamp.load(std::memory_order_relaxed) != stamp)
+        {
+            _overrun = true;
+            return MarketEventRingStatus::OVERRUN;
+        }
+
+        std::memcpy(&event, data, sizeof(MarketEvent));
+        ++_cursor;
+
+        // Skip events until the snapshot begins
+        if (!_synchronized)
+        {
+            if (event.Type != MarketEventType::SNAPSHOT_BEGIN)
+                continue;
+            _synchronized = true;
+        }
+
+        return MarketEventRingStatus::OK;
+    }
+}
+
+inline void MarketEventRingReader::Resync() noexcept
+{
+    // Move the cursor before requesting a snapshot, so the requested snapshot is never skipped
+    _cursor = _header->Sequence.load(std::memory_order_acquire);
+    _synchronized = false;
+    _overrun = false;
+
+    // Request a new snapshot
+    _header->SnapshotRequests.fetch_add(1, std::memory_order_acq_rel);
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -24,13 +24,16 @@ namespace Matching {
     could be used to monitor the following changes in the market:
     \li Add/Remove/Modify symbols
     \li Add/Remove/Modify orders
+    \li Mass-cancel of orders
     \li Order executions
     \li Order book updates
+    \li Order book auction updates
 
     Not thread-safe.
 */
 class MarketHandler
 {
+    friend class ConcurrentMarketManager;
     friend class MarketManager;
 
 public:
@@ -52,6 +55,9 @@ protected:
     virtual void onUpdateOrderBook(const OrderBook& order_book, bool top) {}
     virtual void onDeleteOrderBook(const OrderBook& order_book) {}
 
+    // Order book auction handlers
+    virtual void onUpdateAuction(const OrderBook& order_book, const Auction& auction) {}
+
     // Price level handlers
     virtual void onAddLevel(const OrderBook& order_book, const Level& level, bool top) {}
     virtual void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) {}
@@ -60,7 +66,10 @@ protected:
     // Order handlers
     virtual void onAddOrder(const Order& order) {}
     virtual void onUpdateOrder(const Order& order) {}
+    // Replaced order is reported as the delete of the old order and the add of the new one by default
+    virtual void onReplaceOrder(const Order& old_order, const Order& order) { onDeleteOrder(old_order); onAddOrder(order); }
     virtual void onDeleteOrder(const Order& order) {}
+    virtual void onDeleteOrders(const OrderBook& order_book, size_t orders, uint64_t volume) {}
 
     // Order execution handlers
     virtual void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) {}
@@ -9,13 +9,18 @@
 #ifndef CPPTRADER_MATCHING_MARKET_MANAGER_H
 #define CPPTRADER_MATCHING_MARKET_MANAGER_H
 
+#include "epoch.h"
 #include "fast_hash.h"
 #include "market_handler.h"
+#include "quote.h"
 
 #include "containers/hashmap.h"
 #include "memory/allocator_pool.h"
 
+#include <algorithm>
 #include <cassert>
+#include <deque>
+#include <memory>
 #include <vector>
 
 namespace CppTrader {
@@ -33,6 +38,11 @@ namespace Matching {
     Automatic orders matching can be enabled with EnableMatching() method or can be
     manually performed with Match() method.
 
+    With compact node links each market manager owns its price levels and orders
+    node pools. Every public method selects them for the calling thread, so order
+    books could be walked after the call. Use MarketManager::NodeScope to walk
+    order books of several market managers in the same thread.
+
     Not thread-safe.
 */
 class MarketManager
@@ -46,6 +56,37 @@ public:
     typedef std::vector<OrderBook*> OrderBooks;
     //! Orders container
     typedef CppCommon::HashMap<uint64_t, OrderNode*, FastHash> Orders;
+    //! Owner orders container
+    typedef CppCommon::HashMap<uint32_t, std::vector<OrderNode*>, FastHash> OwnerOrders;
+
+    //! Node pools scope
+    /*!
+        Selects price levels and orders node pools of the market manager to resolve
+        compact node links of the calling thread. Does nothing without compact node links.
+    */
+    class NodeScope
+    {
+    public:
+#if defined(CPPTRADER_COMPACT_LINKS)
+        explicit NodeScope(const MarketManager& manager) noexcept
+            : _levels(manager._level_pool), _orders(manager._order_pool)
+        {}
+#else
+        explicit NodeScope(const MarketManager&) noexcept {}
+#endif
+        NodeScope(const NodeScope&) = delete;
+        NodeScope(NodeScope&&) = delete;
+        ~NodeScope() noexcept = default;
+
+        NodeScope& operator=(const NodeScope&) = delete;
+        NodeScope& operator=(NodeScope&&) = delete;
+
+#if defined(CPPTRADER_COMPACT_LINKS)
+    private:
+        NodePool<LevelNode>::Scope _levels;
+        NodePool<OrderNode>::Scope _orders;
+#endif
+    };
 
     MarketManager();
     MarketManager(MarketHandler& market_handler);
@@ -61,6 +102,11 @@ public:
     //! Get the order books container
     const OrderBooks& order_books() const noexcept { return _order_books; }
     //! Get the orders container
+    /*!
+        Stop prices of trailing stop orders are kept by their price levels,
+        so orders taken from this container might have stale stop prices.
+        Use GetOrder() to get an order with the actual stop price.
+    */
     const Orders& orders() const noexcept { return _orders; }
 
     //! Get the symbol with the given Id
@@ -77,10 +123,32 @@ public:
     const OrderBook* GetOrderBook(uint32_t id) const noexcept;
     //! Get the order with the given Id
     /*!
+        The stop price of the trailing stop order is updated from its price level.
+
         \param id - Order Id
         \return Pointer to the order with the given Id or nullptr
     */
     const Order* GetOrder(uint64_t id) const noexcept;
+    //! Prefetch the order with the given Id into the CPU cache
+    /*!
+        Looks up the order in the orders index and prefetches its node. The lookup
+        itself is synchronous, only the load of the order node is overlapped with
+        the following work. Used to overlap order node cache misses of batched
+        order operations.
+
+        \param id - Order Id
+    */
+    void PrefetchOrder(uint64_t id) const noexcept;
+
+    //! Simulate the order matching without any changes in the market
+    /*!
+        The order is simulated against the order book of its symbol Id.
+        See OrderBook::SimulateOrder() for details.
+
+        \param order - Order to simulate
+        \return Order book sweep result (nothing is matched if the order book is not found)
+    */
+    Sweep SimulateOrder(const Order& order) const;
 
     //! Add a new symbol
     /*!
@@ -108,6 +176,114 @@ public:
     */
     ErrorCode DeleteOrderBook(uint32_t id);
 
+    //! Enable the order book depth
+    /*!
+        Order book will maintain bids and asks depth arrays of the given size
+        which are incrementally updated with each price level update.
+
+        \param id - Symbol Id of the order book
+        \param levels - Count of the top price levels to keep in the depth
+        \return Error code
+    */
+    ErrorCode EnableOrderBookDepth(uint32_t id, size_t levels);
+    //! Disable the order book depth
+    /*!
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode DisableOrderBookDepth(uint32_t id);
+
+    //! Enable the order book best bid and offer block
+    /*!
+        Order book will publish the best bid and offer into the block under the
+        sequence lock each time the top of the order book is changed, so other
+        threads could read it with OrderBook::bbo() without locks. The block is
+        kept until the order book is deleted.
+
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode EnableOrderBookBBO(uint32_t id);
+
+    //! Set the order book allocation policy
+    /*!
+        Allocation policy is applied when the incoming order is matched with
+        the price level which volume is greater than the order quantity. Price
+        levels with 'All-Or-None' orders are always matched in the FIFO order.
+
+        \param id - Symbol Id of the order book
+        \param allocation - Allocation policy
+        \return Error code
+    */
+    ErrorCode SetOrderBookAllocation(uint32_t id, const Allocation& allocation);
+
+    //! Enable the order book call auction mode
+    /*!
+        Orders of the order book in the call auction mode are collected without
+        the automatic matching, so the order book could be crossed. Market orders
+        are not collected and are deleted without execution. Indicative auction
+        state is published with MarketHandler::onUpdateAuction() handler after
+        each price level update. Order book in the batch auction mode is rejected
+        with ErrorCode::ORDER_BOOK_MODE_INVALID.
+
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode EnableOrderBookAuction(uint32_t id);
+    //! Uncross the order book and leave the call auction mode
+    /*!
+        All crossed orders of the order book are executed in bulk at the single
+        equilibrium price (see OrderBook::GetAuction() for details). Bids and asks
+        are executed in price-time priority up to the executable volume. After the
+        uncross the order book returns into the continuous matching mode.
+
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode UncrossOrderBook(uint32_t id);
+
+    //! Enable the order book batch auction mode
+    /*!
+        New limit orders of the order book in the batch auction mode are accepted
+        into the current batch without matching: duplicate Ids are rejected and
+        MarketHandler::onAddOrder() is called at once, the order is available with
+        GetOrder() and could be reduced, modified, replaced, executed or deleted
+        before the batch is matched. Each MatchOrderBookBatch() call adds all
+        orders of the batch into the order book in the arrival order and uncrosses
+        it at the single clearing price. Remaining parts of 'Immediate-Or-Cancel'
+        orders are deleted after the uncross, the remaining parts of other limit
+        orders rest in the order book until the next batch.
+
+        Market orders are rejected with ErrorCode::ORDER_TYPE_INVALID, 'Fill-Or-Kill'
+        and 'All-Or-None' limit orders which could not be partially filled by the
+        auction are rejected with ErrorCode::ORDER_PARAMETER_INVALID. Stop orders
+        are added into the order book at once and are activated after each uncross
+        by the clearing price, activated orders are matched with the uncrossed
+        order book immediately.
+
+        Order book in the call auction mode is rejected with
+        ErrorCode::ORDER_BOOK_MODE_INVALID.
+
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode EnableOrderBookBatch(uint32_t id);
+    //! Disable the order book batch auction mode
+    /*!
+        The current batch is matched before the order book returns into the
+        continuous matching mode.
+
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode DisableOrderBookBatch(uint32_t id);
+    //! Match the current batch of the order book
+    /*!
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode MatchOrderBookBatch(uint32_t id);
+
     //! Add a new order
     /*!
         \param order - Order to add
@@ -169,6 +345,14 @@ public:
     ErrorCode MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity);
     //! Replace the order with a similar order but different Id, price and quantity
     /*!
+        The order is replaced in place: the same order node is rekeyed in the orders
+        map and moved to the end of its price level if the price is not changed, or
+        to the new price level otherwise. The replaced order loses its time priority.
+        MarketHandler::onReplaceOrder() handler is called once with both old and new
+        orders. By default it calls MarketHandler::onDeleteOrder() and MarketHandler::onAddOrder(),
+        and the price level is published without and with the replaced order, so handlers
+        see the same events as for the delete and the add of the order.
+
         \param id - Order Id
         \param new_id - Order Id to replace
         \param new_price - Order price to replace
@@ -190,6 +374,63 @@ public:
     */
     ErrorCode DeleteOrder(uint64_t id);
 
+    //! Delete all orders of the order book
+    /*!
+        Orders are unlinked from the order book price levels in bulk. The
+        MarketHandler::onDeleteOrder() handler is called per deleted order and
+        then the MarketHandler::onDeleteOrders() handler is called once with
+        the summary of deleted orders. Price level handlers are called once per
+        changed price level with its net change.
+
+        \param id - Symbol Id of the order book
+        \return Error code
+    */
+    ErrorCode DeleteOrders(uint32_t id);
+    //! Delete all orders of the order book with the given side and price range
+    /*!
+        Limit orders are selected by the order price, stop orders are selected
+        by the order stop price.
+
+        \param id - Symbol Id of the order book
+        \param side - Order side
+        \param min_price - Min price of the range (inclusive, default is 0)
+        \param max_price - Max price of the range (inclusive, default is UINT64_MAX)
+        \return Error code
+    */
+    ErrorCode DeleteOrders(uint32_t id, OrderSide side, uint64_t min_price = 0, uint64_t max_price = std::numeric_limits<uint64_t>::max());
+    //! Delete all orders of the given owner in all order books (cancel-on-disconnect)
+    /*!
+        Orders are indexed by their owners, so the cost depends only on the
+        count of the owner orders, not on the count of all orders.
+
+        \param owner - Order owner Id
+        \return Error code
+    */
+    ErrorCode DeleteOwnerOrders(uint32_t owner);
+
+    //! Replace the market maker quotes ladder of the order book
+    /*!
+        All quotes are validated before any change, so the whole ladder is
+        replaced atomically or not changed at all. Each quote is compared with
+        the existing limit order with the same Id:
+        \li not existing order - a new limit order is added;
+        \li zero quote quantity - the existing order is deleted;
+        \li same price and not greater quantity - the existing order is reduced
+            in place and keeps its price level and time priority;
+        \li otherwise - the existing order is modified and moved to the new position.
+
+        Automatic matching is performed once after the whole ladder is replaced.
+        Price level handlers are called once per changed price level with its net
+        change, and MarketHandler::onUpdateOrderBook() handler is called once for
+        all price level updates.
+
+        \param id - Symbol Id of the order book
+        \param quotes - Quotes array
+        \param count - Quotes count
+        \return Error code
+    */
+    ErrorCode MassQuote(uint32_t id, const Quote* quotes, size_t count);
+
     //! Execute the order
     /*!
         \param id - Order Id
@@ -209,17 +450,53 @@ public:
     //! Is automatic matching enabled?
     bool IsMatchingEnabled() const noexcept { return _matching; }
     //! Enable automatic matching
-    void EnableMatching() { _matching = true; Match(); }
+    void EnableMatching() { NodeScope scope(*this); _matching = true; Match(); }
     //! Disable automatic matching
     void DisableMatching() { _matching = false; }
 
+    //! Get the epoch manager of reader threads (nullptr if epoch-based reclamation is disabled)
+    EpochManager* epochs() const noexcept { return _epochs.get(); }
+    //! Is epoch-based reclamation enabled?
+    bool IsReclamationEnabled() const noexcept { return (bool)_epochs; }
+    //! Enable epoch-based reclamation
+    /*!
+        In this mode deleted orders, price levels and order books are not returned
+        to their pools immediately, but retired and recycled only after all reader
+        threads registered in the epoch manager have left the critical sections
+        entered before the retirement. It keeps the best bid and offer block of
+        the order book (see EnableOrderBookBBO()) readable inside the critical
+        section even if the order book is deleted concurrently. The block pointer
+        must be obtained in the market manager thread.
+
+        Only the best bid and offer block is safe for reader threads. Order books,
+        price levels, orders and lookup methods are not synchronized and must be
+        used in the market manager thread only.
+
+        Reclamation cannot be disabled, because reader threads could keep
+        the epoch manager pointer.
+
+        \param readers - Maximal count of reader threads (default is 64)
+        Reclaim() is triggered automatically when the count of retired nodes has grown
+        by the given threshold since the previous Reclaim() call, so its cost is
+        amortized over the threshold retirements even if a stalled reader thread
+        keeps retired nodes.
+
+        \param threshold - Count of retired nodes which triggers Reclaim() (default is 1024)
+    */
+    void EnableReclamation(size_t readers = 64, size_t threshold = 1024);
+    //! Recycle retired nodes which are no longer observed by reader threads
+    /*!
+        \return Count of recycled nodes
+    */
+    size_t Reclaim();
+
     //! Match crossed orders in all order books
     /*!
         Method will match all crossed orders in each order book. Buy orders will be
         matched with sell orders at arbitrage price starting from the top of the book.
         Matched orders will be executed with deleted form the order book. After the
         matching operation each order book will have the best bid price guarantied
-        less than the best ask price!
+        less than the best ask price! Order books in the call or batch auction mode are skipped.
     */
     void Match();
 
@@ -232,8 +509,12 @@ private:
     CppCommon::DefaultMemoryManager _auxiliary_memory_manager;
 
     // Bid/Ask price levels
+#if defined(CPPTRADER_COMPACT_LINKS)
+    NodePool<LevelNode> _level_pool;
+#else
     CppCommon::PoolMemoryManager<CppCommon::DefaultMemoryManager> _level_memory_manager;
     CppCommon::PoolAllocator<LevelNode, CppCommon::DefaultMemoryManager> _level_pool;
+#endif
 
     // Symbols
     CppCommon::PoolMemoryManager<CppCommon::DefaultMemoryManager> _symbol_memory_manager;
@@ -246,10 +527,36 @@ private:
     OrderBooks _order_books;
 
     // Orders
+#if defined(CPPTRADER_COMPACT_LINKS)
+    NodePool<OrderNode> _order_pool;
+#else
     CppCommon::PoolMemoryManager<CppCommon::DefaultMemoryManager> _order_memory_manager;
     CppCommon::PoolAllocator<OrderNode, CppCommon::DefaultMemoryManager> _order_pool;
+#endif
     Orders _orders;
 
+    // Orders of each owner (orders without the owner are not tracked)
+    OwnerOrders _owner_orders;
+    std::vector<OrderNode*> _owner_orders_deleting;
+
+    void AddOwnerOrder(OrderNode* order_ptr);
+    void DeleteOwnerOrder(OrderNode* order_ptr);
+
+    // Epoch-based reclamation
+    std::unique_ptr<EpochManager> _epochs;
+    std::deque<std::pair<uint64_t, OrderNode*>> _retired_orders;
+    std::deque<std::pair<uint64_t, LevelNode*>> _retired_levels;
+    std::deque<std::pair<uint64_t, OrderBook*>> _retired_order_books;
+    size_t _retired;
+    size_t _reclaim_threshold;
+    size_t _reclaim_trigger;
+
+    void ReleaseOrder(OrderNode* order_ptr);
+    void ReleaseLevel(LevelNode* level_ptr);
+    void ReleaseOrderBook(OrderBook* order_book_ptr);
+
+    ErrorCode AddOrder(const Order& order, bool recursive);
+    ErrorCode AddBatchOrder(OrderBook* order_book_ptr, const Order& order);
     ErrorCode AddMarketOrder(const Order& order, bool recursive);
     ErrorCode AddLimitOrder(const Order& order, bool recursive);
     ErrorCode AddStopOrder(const Order& order, bool recursive);
@@ -259,25 +566,74 @@ private:
     ErrorCode ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity, bool recursive);
     ErrorCode DeleteOrder(uint64_t id, bool recursive);
 
+    // Orders mass-cancel
+    void DeleteOrders(OrderBook* order_book_ptr, bool buy, bool sell, price_t min_price, price_t max_price);
+    void DeleteOwnerOrders(OrderBook* order_book_ptr, OrderNode* const* orders, size_t count);
+    void DeleteLevelsOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, price_t min_price, price_t max_price, OrderNodeList& orders);
+    void DeleteStopLevelsOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, bool trailing, price_t min_price, price_t max_price, OrderNodeList& orders);
+    void DeleteUnlinkedOrders(OrderBook* order_book_ptr, OrderNodeList& orders);
+
     // Matching
     bool _matching;
 
+    // Order allocations of the matched price level
+    struct OrderAllocation
+    {
+        OrderNode* Order;
+        quantity_t Quantity;
+        uint64_t Remainder;
+        size_t Priority;
+    };
+    std::vector<OrderAllocation> _allocations;
+
+    // Coalesced order book updates
+    bool _coalescing;
+    bool _coalesced_top;
+
+    // Coalesced price level updates (the net change of each price level is published once)
+    struct CoalescedLevel
+    {
+        Level Update;
+        bool Existed;
+        bool Top;
+        size_t Sequence;
+    };
+    std::vector<CoalescedLevel> _coalesced_levels;
+
+    void PublishCoalescedLevels(const OrderBook& order_book);
+
+    // Quote Ids of the mass quote
+    std::vector<uint64_t> _quote_ids;
+
+    // Trailing stop price levels repriced by the market move
+    std::vector<LevelNode*> _repriced_levels;
+
+    bool IsAutomaticMatching(const OrderBook* order_book_ptr) const noexcept { return _matching && !order_book_ptr->IsAuction() && !order_book_ptr->IsBatch(); }
+
+    // Limit orders of the current batch are not linked to any price level until the batch is matched
+    static bool IsBatchOrder(const OrderNode* order_ptr) noexcept { return order_ptr->IsLimit() && (order_ptr->Level == nullptr); }
+
     void Match(OrderBook* order_book_ptr);
     void MatchMarket(OrderBook* order_book_ptr, Order* order_ptr);
     void MatchLimit(OrderBook* order_book_ptr, Order* order_ptr);
     void MatchOrder(OrderBook* order_book_ptr, Order* order_ptr);
+    void MatchOrders(OrderBook* order_book_ptr, OrderNode* executing_order_ptr, Order* order_ptr, quantity_t quantity);
+    void MatchProRata(OrderBook* order_book_ptr, LevelNode* level_ptr, Order* order_ptr);
+    void MatchSizePriority(OrderBook* order_book_ptr, LevelNode* level_ptr, Order* order_ptr);
+
+    void Uncross(OrderBook* order_book_ptr);
+    void UncrossLevels(OrderBook* order_book_ptr, LevelNode* level_ptr, price_t price, volume_t volume);
 
     bool ActivateStopOrders(OrderBook* order_book_ptr);
-    bool ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t stop_price);
+    bool ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, price_t stop_price);
     bool ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
     bool ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
 
-    uint64_t CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume);
-    uint64_t CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* bid_level_ptr, LevelNode* ask_level_ptr);
-    void ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume);
+    volume_t CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* bid_level_ptr, LevelNode* ask_level_ptr);
+    void ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, price_t price, volume_t volume);
     void RecalculateTrailingStopPrice(OrderBook* order_book_ptr, LevelNode* level_ptr);
 
-    void UpdateLevel(const OrderBook& order_book, const LevelUpdate& update) const;
+    void UpdateLevel(const OrderBook& order_book, const LevelUpdate& update);
 };
 
 /*! \example market_manager.cpp Market manager example */
@@ -6,6 +6,10 @@
     \copyright MIT License
 */
 
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <immintrin.h>
+#endif
+
 namespace CppTrader {
 namespace Matching {
 
@@ -17,38 +21,93 @@ inline MarketManager::MarketManager()
 inline MarketManager::MarketManager(MarketHandler& market_handler)
     : _market_handler(market_handler),
       _auxiliary_memory_manager(),
+#if !defined(CPPTRADER_COMPACT_LINKS)
       _level_memory_manager(_auxiliary_memory_manager),
       _level_pool(_level_memory_manager),
+#endif
       _symbol_memory_manager(_auxiliary_memory_manager),
       _symbol_pool(_symbol_memory_manager),
       _order_book_memory_manager(_auxiliary_memory_manager),
       _order_book_pool(_order_book_memory_manager),
+#if !defined(CPPTRADER_COMPACT_LINKS)
       _order_memory_manager(_auxiliary_memory_manager),
       _order_pool(_order_memory_manager),
+#endif
       _orders(16384, 0),
-      _matching(false)
+      _owner_orders(128, 0),
+      _retired(0),
+      _reclaim_threshold(0),
+      _reclaim_trigger(0),
+      _matching(false),
+      _coalescing(false),
+      _coalesced_top(false)
 {
 
 }
 
 inline const Symbol* MarketManager::GetSymbol(uint32_t id) const noexcept
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     return ((id < _symbols.size()) ? _symbols[id] : nullptr);
 }
 
 inline const OrderBook* MarketManager::GetOrderBook(uint32_t id) const noexcept
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     return ((id < _order_books.size()) ? _order_books[id] : nullptr);
 }
 
 inline const Order* MarketManager::GetOrder(uint64_t id) const noexcept
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     assert((id > 0) && "Order Id must be greater than zero!");
     if (id == 0)
         return nullptr;
 
     auto it = _orders.find(id);
-    return ((it != _orders.end()) ? it->second : nullptr);
+    if (it == _orders.end())
+        return nullptr;
+
+    // Materialize the stop price of the trailing stop order
+    OrderNode* order_ptr = it->second;
+    OrderBook::MaterializeTrailingStopOrder(order_ptr);
+
+    return order_ptr;
+}
+
+inline void MarketManager::PrefetchOrder(uint64_t id) const noexcept
+{
+    auto it = _orders.find(id);
+    if (it == _orders.end())
+        return;
+
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(it->second);
+#elif defined(_M_IX86) || defined(_M_X64)
+    _mm_prefetch((const char*)it->second, _MM_HINT_T0);
+#endif
+}
+
+inline Sweep MarketManager::SimulateOrder(const Order& order) const
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    const OrderBook* order_book_ptr = GetOrderBook(order.SymbolId);
+    if (order_book_ptr == nullptr)
+    {
+        Sweep sweep;
+        sweep.Leftover = order.LeavesQuantity;
+        return sweep;
+    }
+
+    return order_book_ptr->SimulateOrder(order);
 }
 
 } // namespace Matching
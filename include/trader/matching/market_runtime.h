@@ -0,0 +1,203 @@
+/*!
+    \file market_runtime.h
+    \brief Market runtime definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_RUNTIME_H
+#define CPPTRADER_MATCHING_MARKET_RUNTIME_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market runtime thread statistics
+struct RuntimeStats
+{
+    //! Is the thread pinned to its core?
+    bool Pinned;
+    //! Is the thread scheduled with the real-time policy?
+    bool Realtime;
+    //! Count of poll loops
+    uint64_t Loops;
+    //! Count of poll loops which did some work
+    uint64_t BusyLoops;
+    //! Count of poll loops which did no work
+    uint64_t IdleLoops;
+    //! Cycles spent in busy poll loops
+    uint64_t BusyCycles;
+    //! Cycles spent in idle poll loops including backoff
+    uint64_t IdleCycles;
+    //! Amount of work reported by the poll function
+    uint64_t Work;
+
+    RuntimeStats() noexcept : Pinned(false), Realtime(false), Loops(0), BusyLoops(0), IdleLoops(0), BusyCycles(0), IdleCycles(0), Work(0) {}
+
+    template <class TOutputStream>
+    friend TOutputStream& operator<<(TOutputStream& stream, const RuntimeStats& stats);
+};
+
+//! Market runtime
+/*!
+    Market runtime runs the matching engine thread and its helper threads
+    (parser, publisher) as busy-poll loops pinned to configured cores.
+
+    Each runtime thread repeatedly calls its poll function, which should poll
+    input rings and return the amount of done work (e.g. count of drained
+    commands). When the poll function returns zero the thread backs off with
+    an exponentially growing count of CPU pause instructions, but never yields
+    or sleeps, so it is never voluntarily descheduled. Runtime threads could
+    be optionally scheduled with SCHED_FIFO policy, and the whole process
+    memory could be locked to avoid page faults in the hot path.
+
+    Each runtime thread accounts busy and idle loops and the cycles spent in
+    them (time stamp counter where available), so the engine load and the
+    poll overhead could be monitored while the runtime is running. Statistics
+    are accumulated locally and published every 1024 poll loops, when the
+    thread becomes idle and when the thread is stopped.
+
+    Pinning, real-time scheduling and memory locking are best effort: they
+    require appropriate privileges and are supported on Linux only. Results
+    are reported with RuntimeStats::Pinned, RuntimeStats::Realtime flags and
+    the memory_locked() property. Real-time busy-poll threads should be
+    pinned to isolated cores, otherwise they starve other threads of the core.
+
+    Not thread-safe: AddThread(), Start() and Stop() should be called from
+    the same control thread, stats() is thread-safe.
+*/
+class MarketRuntime
+{
+public:
+    //! Any core (thread is not pinned)
+    static const int ANY_CORE = -1;
+    //! Default real-time priority (the lowest SCHED_FIFO priority, so kernel threads are not preempted)
+    static const int DEFAULT_PRIORITY = 1;
+
+    //! Create the market runtime
+    /*!
+        \param realtime - Schedule runtime threads with SCHED_FIFO policy (default is false)
+        \param lock_memory - Lock current and future process memory on start (default is false)
+        \param max_backoff - Maximal count of pause instructions in one idle backoff (default is 64)
+        \param priority - SCHED_FIFO priority of runtime threads (default is DEFAULT_PRIORITY)
+    */
+    explicit MarketRuntime(bool realtime = false, bool lock_memory = false, uint32_t max_backoff = 64, int priority = DEFAULT_PRIORITY);
+    MarketRuntime(const MarketRuntime&) = delete;
+    MarketRuntime(MarketRuntime&&) = delete;
+    ~MarketRuntime();
+
+    MarketRuntime& operator=(const MarketRuntime&) = delete;
+    MarketRuntime& operator=(MarketRuntime&&) = delete;
+
+    //! Get the count of runtime threads
+    size_t threads() const noexcept { return _threads.size(); }
+    //! Is the runtime running?
+    bool running() const noexcept { return _running.load(std::memory_order_acquire); }
+    //! Is the process memory locked?
+    bool memory_locked() const noexcept { return _memory_locked; }
+    //! Get the real-time priority of runtime threads
+    int priority() const noexcept { return _priority; }
+
+    //! Add a new runtime thread
+    /*!
+        Runtime threads could be added only before the runtime is started.
+
+        \param name - Thread name
+        \param core - Core to pin the thread to (default is ANY_CORE)
+        \param poll - Poll function which returns the amount of done work
+        \return Runtime thread index
+    */
+    size_t AddThread(const std::string& name, int core, const std::function<size_t()>& poll);
+
+    //! Get the runtime thread statistics
+    /*!
+        \param thread - Runtime thread index
+        \return Runtime thread statistics snapshot
+    */
+    RuntimeStats stats(size_t thread) const noexcept;
+
+    //! Start the runtime
+    /*!
+        Locks the process memory if required and starts all runtime threads.
+        If any runtime thread could not be started, already started threads
+        are stopped, the memory is unlocked and the exception is rethrown.
+
+        \return 'true' if the runtime was started, 'false' if the runtime is already running
+    */
+    bool Start();
+    //! Stop the runtime
+    /*!
+        Stops all runtime threads and waits for their completion.
+
+        \return 'true' if the runtime was stopped, 'false' if the runtime is not running
+    */
+    bool Stop();
+
+    //! Pin the current thread to the given core
+    /*!
+        \param core - Core index
+        \return 'true' if the thread was pinned, 'false' if pinning is not permitted or not supported
+    */
+    static bool PinThread(int core) noexcept;
+    //! Schedule the current thread with SCHED_FIFO policy
+    /*!
+        \param priority - SCHED_FIFO priority
+        \return 'true' if the thread was scheduled, 'false' if real-time scheduling is not permitted, not supported or the priority is invalid
+    */
+    static bool SetRealtime(int priority) noexcept;
+    //! Lock current and future process memory
+    /*!
+        \return 'true' if the memory was locked, 'false' if memory locking is not permitted or not supported
+    */
+    static bool LockMemory() noexcept;
+    //! Unlock the process memory
+    static void UnlockMemory() noexcept;
+
+    //! Execute the CPU pause instruction
+    static void Pause() noexcept;
+    //! Get the current CPU cycles counter
+    static uint64_t Cycles() noexcept;
+
+private:
+    struct alignas(64) Thread
+    {
+        std::string Name;
+        int Core;
+        std::function<size_t()> Poll;
+        std::thread Instance;
+        std::atomic<bool> Pinned;
+        std::atomic<bool> Realtime;
+        std::atomic<uint64_t> BusyLoops;
+        std::atomic<uint64_t> IdleLoops;
+        std::atomic<uint64_t> BusyCycles;
+        std::atomic<uint64_t> IdleCycles;
+        std::atomic<uint64_t> Work;
+    };
+
+    bool _realtime;
+    bool _lock_memory;
+    uint32_t _max_backoff;
+    int _priority;
+    bool _memory_locked;
+    std::vector<std::unique_ptr<Thread>> _threads;
+    alignas(64) std::atomic<bool> _running;
+
+    void Run(Thread& thread);
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_runtime.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_RUNTIME_H
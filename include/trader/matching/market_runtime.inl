@@ -0,0 +1,60 @@
+/*!
+    \file market_runtime.inl
+    \brief Market runtime inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include <chrono>
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, const RuntimeStats& stats)
+{
+    stream << "RuntimeStats(Pinned=" << (stats.Pinned ? "true" : "false")
+        << "; Realtime=" << (stats.Realtime ? "true" : "false")
+        << "; Loops=" << stats.Loops
+        << "; BusyLoops=" << stats.BusyLoops
+        << "; IdleLoops=" << stats.IdleLoops
+        << "; BusyCycles=" << stats.BusyCycles
+        << "; IdleCycles=" << stats.IdleCycles
+        << "; Work=" << stats.Work
+        << ")";
+    return stream;
+}
+
+inline void MarketRuntime::Pause() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+inline uint64_t MarketRuntime::Cycles() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    return __rdtsc();
+#elif defined(__i386__) || defined(__x86_64__)
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,180 @@
+/*!
+    \file market_sequencer.h
+    \brief Market sequencer definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_MARKET_SEQUENCER_H
+#define CPPTRADER_MATCHING_MARKET_SEQUENCER_H
+
+#include "market_command_queue.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Market sequencer merge policy
+enum class MergePolicy : uint8_t
+{
+    TIMESTAMP,
+    ARRIVAL
+};
+
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, MergePolicy policy);
+
+//! Market sequencer
+/*!
+    Market sequencer deterministically merges several input streams of market
+    commands (gateway threads, recorded input files) into the single sequence
+    applied to the market manager.
+
+    Each input stream is a bounded single-producer single-consumer ring. The
+    sequencer thread merges heads of all non-empty streams by the command
+    timestamp or by the global arrival ticket (ties are broken by the lower
+    stream index), assigns the global sequence number to each command and
+    applies commands to the market manager in batches.
+
+    The merge depends on which streams have data at the moment, so the only
+    thing required to reproduce the run is the order of stream indexes. It is
+    persisted as the merge journal of (stream, count) varint runs which is
+    passed to onMergeJournal() handler at the end of each Sequence() call.
+    Commands themselves are never copied into the journal, they are expected
+    to be recorded by the input side (gateway logs, input files).
+
+    To replay the run, feed the same input streams and pass the recorded
+    journal to Replay(). In replay mode the sequencer takes commands in the
+    journal order regardless of the merge policy and waits for the stream
+    required by the journal if it is empty. Once all recorded merge decisions
+    are replayed the sequencer leaves replay mode and merges the following
+    commands live with its merge policy, so the journal should be passed to
+    Replay() before the sequencer reaches its end.
+
+    Thread-safe: each stream should be fed by one thread at a time, Sequence()
+    and Replay() should be called from the market manager thread only.
+*/
+class MarketSequencer
+{
+public:
+    //! Create the market sequencer
+    /*!
+        \param streams - Count of input streams
+        \param policy - Merge policy (default is MergePolicy::TIMESTAMP)
+        \param capacity - Input stream ring capacity (power of two, default is 64K commands)
+        \param batch - Maximal count of commands applied by one Sequence() call (default is 64)
+    */
+    explicit MarketSequencer(size_t streams, MergePolicy policy = MergePolicy::TIMESTAMP, size_t capacity = 64 * 1024, size_t batch = 64);
+    MarketSequencer(const MarketSequencer&) = delete;
+    MarketSequencer(MarketSequencer&&) = delete;
+    virtual ~MarketSequencer() = default;
+
+    MarketSequencer& operator=(const MarketSequencer&) = delete;
+    MarketSequencer& operator=(MarketSequencer&&) = delete;
+
+    //! Get the count of input streams
+    size_t streams() const noexcept { return _streams_count; }
+    //! Get the merge policy
+    MergePolicy policy() const noexcept { return _policy; }
+    //! Get the global sequence number of the next sequenced command
+    uint64_t sequence() const noexcept { return _sequence; }
+    //! Is the sequencer in replay mode?
+    bool replaying() const noexcept { return _replaying; }
+
+    //! Enqueue the market command into the input stream (stream producer thread)
+    /*!
+        \param stream - Input stream index
+        \param command - Market command to enqueue
+        \param timestamp - Command timestamp used by MergePolicy::TIMESTAMP (default is 0)
+        \return 'true' if the command was enqueued, 'false' if the input stream is full
+    */
+    bool Enqueue(size_t stream, const MarketCommand& command, uint64_t timestamp = 0) noexcept;
+
+    //! Sequence the batch of market commands into the market manager (market manager thread)
+    /*!
+        \param market - Market manager
+        \param limit - Maximal count of commands to sequence (default is the batch size)
+        \return Count of sequenced commands
+    */
+    size_t Sequence(MarketManager& market, size_t limit = std::numeric_limits<size_t>::max());
+
+    //! Replay the recorded merge journal (market manager thread)
+    /*!
+        Switches the sequencer into replay mode and appends the recorded merge
+        decisions. Journal buffers are expected to be the ones passed to
+        onMergeJournal() handler, so each buffer contains whole runs.
+
+        \param buffer - Merge journal buffer
+        \param size - Merge journal buffer size
+        \return 'true' if the journal was appended, 'false' if it is malformed
+    */
+    bool Replay(const void* buffer, size_t size);
+
+protected:
+    //! Handle the sequenced market command
+    /*!
+        \param sequence - Global sequence number
+        \param stream - Input stream index
+        \param command - Sequenced market command
+        \param result - Result of the market command
+    */
+    virtual void onSequencedCommand(uint64_t sequence, size_t stream, const MarketCommand& command, ErrorCode result) {}
+    //! Handle the merge journal of the sequenced batch
+    /*!
+        \param buffer - Merge journal buffer
+        \param size - Merge journal buffer size
+    */
+    virtual void onMergeJournal(const void* buffer, size_t size) {}
+
+private:
+    struct Entry
+    {
+        uint64_t Key;
+        MarketCommand Command;
+    };
+
+    struct Stream
+    {
+        // Producer cache line
+        alignas(64) std::atomic<uint64_t> Tail;
+        uint64_t CachedHead;
+        // Consumer cache line
+        alignas(64) std::atomic<uint64_t> Head;
+        uint64_t CachedTail;
+        std::unique_ptr<Entry[]> Entries;
+    };
+
+    struct Run
+    {
+        size_t Stream;
+        uint64_t Count;
+    };
+
+    size_t _streams_count;
+    MergePolicy _policy;
+    size_t _capacity;
+    std::unique_ptr<Stream[]> _streams;
+    alignas(64) std::atomic<uint64_t> _arrival;
+    alignas(64) uint64_t _sequence;
+    bool _replaying;
+    std::deque<Run> _runs;
+    std::vector<Entry> _batch;
+    std::vector<size_t> _sources;
+    std::vector<uint8_t> _journal;
+
+    Entry* Peek(size_t stream) noexcept;
+    void Pop(size_t stream) noexcept;
+    size_t Select() noexcept;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "market_sequencer.inl"
+
+#endif // CPPTRADER_MATCHING_MARKET_SEQUENCER_H
@@ -0,0 +1,76 @@
+/*!
+    \file market_sequencer.inl
+    \brief Market sequencer inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, MergePolicy policy)
+{
+    switch (policy)
+    {
+        case MergePolicy::TIMESTAMP:
+            stream << "TIMESTAMP";
+            break;
+        case MergePolicy::ARRIVAL:
+            stream << "ARRIVAL";
+            break;
+        default:
+            stream << "<unknown>";
+            break;
+    }
+    return stream;
+}
+
+inline bool MarketSequencer::Enqueue(size_t stream, const MarketCommand& command, uint64_t timestamp) noexcept
+{
+    assert((stream < _streams_count) && "Invalid market sequencer stream!");
+    Stream& input = _streams[stream];
+
+    // Check for the free space with the cached consumer position first
+    uint64_t tail = input.Tail.load(std::memory_order_relaxed);
+    if ((tail - input.CachedHead) >= _capacity)
+    {
+        input.CachedHead = input.Head.load(std::memory_order_acquire);
+        if ((tail - input.CachedHead) >= _capacity)
+            return false;
+    }
+
+    // Publish the command with its merge key
+    Entry& entry = input.Entries[tail & (_capacity - 1)];
+    entry.Key = (_policy == MergePolicy::ARRIVAL) ? _arrival.fetch_add(1, std::memory_order_relaxed) : timestamp;
+    entry.Command = command;
+    entry.Command.Producer = (uint32_t)stream;
+    input.Tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+inline MarketSequencer::Entry* MarketSequencer::Peek(size_t stream) noexcept
+{
+    Stream& input = _streams[stream];
+
+    // Check for the available command with the cached producer position first
+    uint64_t head = input.Head.load(std::memory_order_relaxed);
+    if (head == input.CachedTail)
+    {
+        input.CachedTail = input.Tail.load(std::memory_order_acquire);
+        if (head == input.CachedTail)
+            return nullptr;
+    }
+
+    return &input.Entries[head & (_capacity - 1)];
+}
+
+inline void MarketSequencer::Pop(size_t stream) noexcept
+{
+    Stream& input = _streams[stream];
+    input.Head.store(input.Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+} // namespace Matching
+} // namespace CppTrader
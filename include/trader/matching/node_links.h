@@ -0,0 +1,60 @@
+/*!
+    \file node_links.h
+    \brief Order and price level node links definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_NODE_LINKS_H
+#define CPPTRADER_MATCHING_NODE_LINKS_H
+
+#if defined(CPPTRADER_COMPACT_LINKS)
+#include "compact_bintree_avl.h"
+#include "compact_list.h"
+#else
+#include "containers/bintree_avl.h"
+#include "containers/list.h"
+#endif
+
+#include <functional>
+
+namespace CppTrader {
+namespace Matching {
+
+/*!
+    Order and price level nodes are linked into price level trees and order
+    lists with pointers by default. Order books with a huge number of orders
+    could be built with CPPTRADER_COMPACT_LINKS definition, which allocates
+    order and price level nodes from the compact node pools of the market
+    manager and links them with 32-bit handles (see NodePool). It shrinks the order list
+    links and the price level back-link of each order from 24 to 16 bytes
+    (including the node handle) and the price level tree links from 32 to
+    20 bytes. Public API still works with plain node pointers.
+*/
+#if defined(CPPTRADER_COMPACT_LINKS)
+//! Node link type (compact 32-bit version)
+template <typename T>
+using NodeLink = CompactPtr<T>;
+//! Node list type (compact 32-bit version)
+template <typename T>
+using NodeList = CompactList<T>;
+//! Node tree type (compact 32-bit version)
+template <typename T, typename TCompare = std::less<T>>
+using NodeTree = CompactBinTreeAVL<T, TCompare>;
+#else
+//! Node link type
+template <typename T>
+using NodeLink = T*;
+//! Node list type
+template <typename T>
+using NodeList = CppCommon::List<T>;
+//! Node tree type
+template <typename T, typename TCompare = std::less<T>>
+using NodeTree = CppCommon::BinTreeAVL<T, TCompare>;
+#endif
+
+} // namespace Matching
+} // namespace CppTrader
+
+#endif // CPPTRADER_MATCHING_NODE_LINKS_H
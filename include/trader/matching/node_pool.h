@@ -0,0 +1,168 @@
+/*!
+    \file node_pool.h
+    \brief Compact node pool definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_NODE_POOL_H
+#define CPPTRADER_MATCHING_NODE_POOL_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Compact node pool
+/*!
+    Compact node pool allocates nodes of the given type from its own arena of
+    blocks and addresses them with 32-bit handles relative to the pool instead
+    of pointers. Blocks grow geometrically (64, 64, 128, 256... nodes), so a
+    handle is resolved into the block with one bit scan and one table lookup.
+    Zero handle is reserved for the null node.
+
+    Node type must provide the 'uint32_t Handle' field which is assigned by
+    the pool on node creation. Released nodes are recycled through the free
+    list of the pool which is linked with handle fields of released nodes, so
+    other node fields stay untouched. Blocks are freed with the pool.
+
+    Compact node pointers keep only handles, so they are resolved against the
+    current node pool of the calling thread which is selected with the
+    NodePool::Scope guard. The outermost scope leaves its pool current after
+    it ends, so nodes could be walked after the call which selected the pool.
+    Nested scopes restore the previous pool.
+
+    Not thread-safe.
+*/
+template <typename T>
+class NodePool
+{
+public:
+    //! Count of handle bits addressed by the first block
+    static const uint32_t FIRST_BLOCK_BITS = 6;
+    //! Maximal count of blocks
+    static const uint32_t MAX_BLOCKS = 33 - FIRST_BLOCK_BITS;
+
+    //! Node pool scope
+    /*!
+        Selects the node pool to resolve compact node pointers of the calling thread.
+    */
+    class Scope
+    {
+    public:
+        explicit Scope(const NodePool& pool) noexcept : _previous(_current) { _current = &pool; ++_depth; }
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        ~Scope() noexcept { if (--_depth > 0) _current = _previous; }
+
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        const NodePool* _previous;
+    };
+
+    NodePool() noexcept;
+    NodePool(const NodePool&) = delete;
+    NodePool(NodePool&&) = delete;
+    ~NodePool() noexcept;
+
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool& operator=(NodePool&&) = delete;
+
+    //! Get the count of allocated nodes
+    size_t allocated() const noexcept { return _allocated; }
+
+    //! Create a new node
+    /*!
+        Throws std::bad_alloc if all 32-bit handles are in use.
+
+        \param args - Node constructor arguments
+        \return Pointer to the created node
+    */
+    template <typename... Args>
+    T* Create(Args&&... args);
+    //! Release the node
+    /*!
+        \param ptr - Pointer to the node to release
+    */
+    void Release(T* ptr);
+
+    //! Resolve the node handle into the node pointer of the pool
+    T* Resolve(uint32_t handle) const noexcept;
+
+    //! Get the current node pool of the calling thread
+    static const NodePool* current() noexcept { return _current; }
+
+    //! Resolve the node handle into the node pointer of the current node pool
+    static T* Pointer(uint32_t handle) noexcept
+    {
+        assert(((handle == 0) || (_current != nullptr)) && "Compact node pointer is resolved outside of any node pool scope!");
+        return (handle != 0) ? _current->Resolve(handle) : nullptr;
+    }
+    //! Get the handle of the node
+    static uint32_t Handle(const T* ptr) noexcept
+    { return (ptr != nullptr) ? ptr->Handle : 0; }
+
+private:
+    T* _blocks[MAX_BLOCKS];
+    uint32_t _next;
+    uint32_t _free;
+    size_t _allocated;
+
+    static inline thread_local const NodePool* _current = nullptr;
+    static inline thread_local size_t _depth = 0;
+
+    // Get the block of the handle and the first handle of the block
+    static uint32_t Block(uint32_t handle) noexcept;
+    static uint32_t BlockBase(uint32_t block) noexcept { return (block == 0) ? 0 : (1u << (block + FIRST_BLOCK_BITS - 1)); }
+    static uint32_t BlockSize(uint32_t block) noexcept { return (block == 0) ? (1u << FIRST_BLOCK_BITS) : (1u << (block + FIRST_BLOCK_BITS - 1)); }
+};
+
+//! Compact node pointer
+/*!
+    Compact node pointer keeps the 32-bit handle of the node allocated from
+    the compact node pool and behaves as a plain node pointer.
+
+    Not thread-safe.
+*/
+template <typename T>
+class CompactPtr
+{
+public:
+    CompactPtr() noexcept : _handle(0) {}
+    CompactPtr(std::nullptr_t) noexcept : _handle(0) {}
+    CompactPtr(T* ptr) noexcept : _handle(NodePool<T>::Handle(ptr)) {}
+    CompactPtr(const CompactPtr&) noexcept = default;
+    CompactPtr(CompactPtr&&) noexcept = default;
+    ~CompactPtr() noexcept = default;
+
+    CompactPtr& operator=(std::nullptr_t) noexcept { _handle = 0; return *this; }
+    CompactPtr& operator=(T* ptr) noexcept { _handle = NodePool<T>::Handle(ptr); return *this; }
+    CompactPtr& operator=(const CompactPtr&) noexcept = default;
+    CompactPtr& operator=(CompactPtr&&) noexcept = default;
+
+    //! Convert to the node pointer
+    operator T*() const noexcept { return NodePool<T>::Pointer(_handle); }
+
+    T& operator*() const noexcept { return *NodePool<T>::Pointer(_handle); }
+    T* operator->() const noexcept { return NodePool<T>::Pointer(_handle); }
+
+    //! Get the node handle
+    uint32_t handle() const noexcept { return _handle; }
+
+private:
+    uint32_t _handle;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "node_pool.inl"
+
+#endif // CPPTRADER_MATCHING_NODE_POOL_H
@@ -0,0 +1,119 @@
+/*!
+    \file node_pool.inl
+    \brief Compact node pool inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace CppTrader {
+namespace Matching {
+
+template <typename T>
+inline NodePool<T>::NodePool() noexcept
+    : _blocks(),
+      _next(1),
+      _free(0),
+      _allocated(0)
+{
+}
+
+template <typename T>
+inline NodePool<T>::~NodePool() noexcept
+{
+    // Compact node pointers could not be resolved against the destroyed pool
+    if (_current == this)
+        _current = nullptr;
+
+    // Free blocks of the pool
+    for (uint32_t block = 0; block < MAX_BLOCKS; ++block)
+        if (_blocks[block] != nullptr)
+            ::operator delete(_blocks[block], std::align_val_t(alignof(T)));
+}
+
+template <typename T>
+inline uint32_t NodePool<T>::Block(uint32_t handle) noexcept
+{
+    if (handle < (1u << FIRST_BLOCK_BITS))
+        return 0;
+
+    // Block index is the count of significant handle bits above the first block bits
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, handle);
+    return (uint32_t)index + 1 - FIRST_BLOCK_BITS;
+#else
+    return (uint32_t)(32 - __builtin_clz(handle)) - FIRST_BLOCK_BITS;
+#endif
+}
+
+template <typename T>
+inline T* NodePool<T>::Resolve(uint32_t handle) const noexcept
+{
+    if (handle == 0)
+        return nullptr;
+
+    uint32_t block = Block(handle);
+    assert((_blocks[block] != nullptr) && "Node handle does not belong to the node pool!");
+    return _blocks[block] + (handle - BlockBase(block));
+}
+
+template <typename T>
+template <typename... Args>
+inline T* NodePool<T>::Create(Args&&... args)
+{
+    uint32_t handle;
+    T* ptr;
+
+    if (_free != 0)
+    {
+        // Take the node from the free list
+        handle = _free;
+        ptr = Resolve(handle);
+        _free = ptr->Handle;
+    }
+    else
+    {
+        // All 32-bit handles are in use
+        if (_next == 0)
+            throw std::bad_alloc();
+
+        // Allocate a new block of nodes
+        handle = _next;
+        uint32_t block = Block(handle);
+        if (_blocks[block] == nullptr)
+            _blocks[block] = (T*)::operator new(BlockSize(block) * sizeof(T), std::align_val_t(alignof(T)));
+
+        ptr = Resolve(handle);
+        ++_next;
+    }
+
+    ++_allocated;
+
+    // Construct the node and assign its handle
+    new (ptr) T(std::forward<Args>(args)...);
+    ptr->Handle = handle;
+    return ptr;
+}
+
+template <typename T>
+inline void NodePool<T>::Release(T* ptr)
+{
+    assert((ptr != nullptr) && "Released node must be valid!");
+    uint32_t handle = ptr->Handle;
+    assert((Resolve(handle) == ptr) && "Released node does not belong to the node pool!");
+
+    ptr->~T();
+
+    // Put the node into the free list linked through handles of released nodes
+    ptr->Handle = _free;
+    _free = handle;
+    --_allocated;
+}
+
+} // namespace Matching
+} // namespace CppTrader
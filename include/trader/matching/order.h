@@ -10,8 +10,9 @@
 #define CPPTRADER_MATCHING_ORDER_H
 
 #include "errors.h"
+#include "node_links.h"
+#include "types.h"
 
-#include "containers/list.h"
 #include "utility/iostream.h"
 
 #include <algorithm>
@@ -126,28 +127,14 @@ TOutputStream& operator<<(TOutputStream& stream, OrderTimeInForce tif);
 */
 struct Order
 {
+    // Hot order fields which are accessed during the matching
+
     //! Order Id
     uint64_t Id;
-    //! Symbol Id
-    uint32_t SymbolId;
-    //! Order type
-    OrderType Type;
-    //! Order side
-    OrderSide Side;
     //! Order price
-    uint64_t Price;
-    //! Order stop price
-    uint64_t StopPrice;
-
-    //! Order quantity
-    uint64_t Quantity;
-    //! Order executed quantity
-    uint64_t ExecutedQuantity;
+    price_t Price;
     //! Order leaves quantity
-    uint64_t LeavesQuantity;
-
-    //! Time in Force
-    OrderTimeInForce TimeInForce;
+    quantity_t LeavesQuantity;
 
     //! Order max visible quantity
     /*!
@@ -159,11 +146,30 @@ struct Order
 
         Supported only for limit and stop-limit orders!
     */
-    uint64_t MaxVisibleQuantity;
+    quantity_t MaxVisibleQuantity;
     //! Order hidden quantity
-    uint64_t HiddenQuantity() const noexcept { return (LeavesQuantity > MaxVisibleQuantity) ? (LeavesQuantity - MaxVisibleQuantity) : 0; }
+    quantity_t HiddenQuantity() const noexcept { return (LeavesQuantity > MaxVisibleQuantity) ? (LeavesQuantity - MaxVisibleQuantity) : 0; }
     //! Order visible quantity
-    uint64_t VisibleQuantity() const noexcept { return std::min(LeavesQuantity, MaxVisibleQuantity); }
+    quantity_t VisibleQuantity() const noexcept { return std::min(LeavesQuantity, MaxVisibleQuantity); }
+
+    //! Symbol Id
+    uint32_t SymbolId;
+    //! Order type
+    OrderType Type;
+    //! Order side
+    OrderSide Side;
+    //! Time in Force
+    OrderTimeInForce TimeInForce;
+
+    // Cold order fields which are rarely accessed during the matching
+
+    //! Order stop price
+    price_t StopPrice;
+
+    //! Order quantity
+    quantity_t Quantity;
+    //! Order executed quantity
+    quantity_t ExecutedQuantity;
 
     //! Market order slippage
     /*!
@@ -176,7 +182,7 @@ struct Order
 
         Supported only for market and stop orders!
     */
-    uint64_t Slippage;
+    price_t Slippage;
 
     //! Order trailing distance to market
     /*!
@@ -197,6 +203,13 @@ struct Order
     */
     int64_t TrailingStep;
 
+    //! Order owner Id
+    /*!
+        Optional owner (participant or session) tag used to mass-cancel
+        all orders of the owner. Zero value means no owner.
+    */
+    uint32_t OwnerId;
+
     Order() noexcept = default;
     Order(uint64_t id, uint32_t symbol, OrderType type, OrderSide side, uint64_t price, uint64_t stop_price, uint64_t quantity,
         OrderTimeInForce tif = OrderTimeInForce::GTC,
@@ -244,10 +257,10 @@ struct Order
     //! Is the 'Hidden' order?
     bool IsHidden() const noexcept { return MaxVisibleQuantity == 0; }
     //! Is the 'Iceberg' order?
-    bool IsIceberg() const noexcept { return MaxVisibleQuantity < std::numeric_limits<uint64_t>::max(); }
+    bool IsIceberg() const noexcept { return MaxVisibleQuantity < std::numeric_limits<quantity_t>::max(); }
 
     //! Is the order have slippage?
-    bool IsSlippage() const noexcept { return Slippage < std::numeric_limits<uint64_t>::max(); }
+    bool IsSlippage() const noexcept { return Slippage < std::numeric_limits<price_t>::max(); }
 
     //! Validate order parameters
     ErrorCode Validate() const noexcept;
@@ -296,11 +309,35 @@ struct Order
 };
 
 struct LevelNode;
+struct OrderNode;
+
+//! Order node links
+struct OrderLinks : public NodeList<OrderNode>::Node
+{
+    //! Price level of the order
+    NodeLink<LevelNode> Level;
+#if defined(CPPTRADER_COMPACT_LINKS)
+    //! Compact node handle
+    uint32_t Handle;
+#endif
+};
+
+//! Order node list
+typedef NodeList<OrderNode> OrderNodeList;
 
 //! Order node
-struct OrderNode : public Order, public CppCommon::List<OrderNode>::Node
+/*!
+    Order node is aligned to the cache line size. Its first cache line keeps
+    the price level orders list links, the price level and the hot order fields
+    (Id, price, leaves and max visible quantities, symbol, type, side and time
+    in force). All other order fields are cold and placed into the second cache
+    line, so walking price levels during the matching touches only one cache
+    line per order.
+*/
+struct alignas(64) OrderNode : public OrderLinks, public Order
 {
-    LevelNode* Level;
+    //! Index of the order in the orders of its owner
+    uint32_t OwnerIndex;
 
     OrderNode(const Order& order) noexcept;
     OrderNode(const OrderNode&) noexcept = default;
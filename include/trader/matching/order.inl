@@ -83,19 +83,20 @@ inline TOutputStream& operator<<(TOutputStream& stream, OrderTimeInForce tif)
 
 inline Order::Order(uint64_t id, uint32_t symbol, OrderType type, OrderSide side, uint64_t price, uint64_t stop_price, uint64_t quantity, OrderTimeInForce tif, uint64_t max_visible_quantity, uint64_t slippage, int64_t trailing_distance, int64_t trailing_step) noexcept
     : Id(id),
+      Price(SaturatePrice(price)),
+      LeavesQuantity(SaturateQuantity(quantity)),
+      MaxVisibleQuantity(SaturateQuantity(max_visible_quantity)),
       SymbolId(symbol),
       Type(type),
       Side(side),
-      Price(price),
-      StopPrice(stop_price),
-      Quantity(quantity),
-      ExecutedQuantity(0),
-      LeavesQuantity(quantity),
       TimeInForce(tif),
-      MaxVisibleQuantity(max_visible_quantity),
-      Slippage(slippage),
+      StopPrice(SaturatePrice(stop_price)),
+      Quantity(SaturateQuantity(quantity)),
+      ExecutedQuantity(0),
+      Slippage(SaturatePrice(slippage)),
       TrailingDistance(trailing_distance),
-      TrailingStep(trailing_step)
+      TrailingStep(trailing_step),
+      OwnerId(0)
 {
 }
 
@@ -121,6 +122,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const Order& order)
         stream << "; MaxVisibleQuantity=" << order.MaxVisibleQuantity;
     if (order.IsSlippage())
         stream << "; Slippage=" << order.Slippage;
+    if (order.OwnerId != 0)
+        stream << "; OwnerId=" << order.OwnerId;
     stream << ")";
     return stream;
 }
@@ -215,7 +218,7 @@ inline Order Order::TrailingSellStopLimit(uint64_t id, uint32_t symbol, uint64_t
     return Order(id, symbol, OrderType::TRAILING_STOP_LIMIT, OrderSide::SELL, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), trailing_distance, trailing_step);
 }
 
-inline OrderNode::OrderNode(const Order& order) noexcept : Order(order), Level(nullptr)
+inline OrderNode::OrderNode(const Order& order) noexcept : OrderLinks(), Order(order), OwnerIndex(0)
 {
 }
 
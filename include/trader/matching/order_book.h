@@ -9,11 +9,21 @@
 #ifndef CPPTRADER_MATCHING_ORDER_BOOK_H
 #define CPPTRADER_MATCHING_ORDER_BOOK_H
 
+#include "allocation.h"
+#include "auction.h"
+#include "bbo.h"
+#include "depth.h"
 #include "level.h"
+#include "sweep.h"
 #include "symbol.h"
 
 #include "memory/allocator_pool.h"
 
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace CppTrader {
 namespace Matching {
 
@@ -31,7 +41,7 @@ class OrderBook
 
 public:
     //! Price level container
-    typedef CppCommon::BinTreeAVL<LevelNode, std::less<LevelNode>> Levels;
+    typedef NodeTree<LevelNode, std::less<LevelNode>> Levels;
 
     OrderBook(MarketManager& manager, const Symbol& symbol);
     OrderBook(const OrderBook&) = delete;
@@ -63,6 +73,21 @@ public:
     //! Get the order book asks container
     const Levels& asks() const noexcept { return _asks; }
 
+    //! Get the order book bids depth
+    const Depth& bid_depth() const noexcept { return _bid_depth; }
+    //! Get the order book asks depth
+    const Depth& ask_depth() const noexcept { return _ask_depth; }
+
+    //! Get the order book best bid and offer block
+    /*!
+        The block could be read from any thread. It is nullptr unless enabled
+        with MarketManager::EnableOrderBookBBO() method and stays valid until
+        the order book is deleted.
+
+        \return Best bid and offer block or nullptr
+    */
+    const BBOBlock* bbo() const noexcept { return _bbo.get(); }
+
     //! Get the order book best buy stop order price level
     const LevelNode* best_buy_stop() const noexcept { return _best_buy_stop; }
     //! Get the order book best sell stop order price level
@@ -79,10 +104,18 @@ public:
     const LevelNode* best_trailing_sell_stop() const noexcept { return _best_trailing_sell_stop; }
 
     //! Get the order book trailing buy stop orders container
+    /*!
+        Trailing stop price levels are grouped by the trailing distance and
+        step of their orders and are repriced lazily (see MaterializeTrailingStopOrder()),
+        so the same price could have several trailing stop price levels.
+    */
     const Levels& trailing_buy_stop() const noexcept { return _trailing_buy_stop; }
     //! Get the order book trailing sell stop orders container
     const Levels& trailing_sell_stop() const noexcept { return _trailing_sell_stop; }
 
+    //! Get the order book orders of the current batch (not linked to price levels until the batch is matched)
+    const OrderNodeList& batch_orders() const noexcept { return _batch_orders; }
+
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderBook& order_book);
 
@@ -91,39 +124,148 @@ public:
         \param price - Price
         \return Pointer to the order book bid price level with the given price or nullptr
     */
-    const LevelNode* GetBid(uint64_t price) const noexcept;
+    const LevelNode* GetBid(price_t price) const noexcept;
     //! Get the order book ask price level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book ask price level with the given price or nullptr
     */
-    const LevelNode* GetAsk(uint64_t price) const noexcept;
+    const LevelNode* GetAsk(price_t price) const noexcept;
+
+    //! Get the cumulative bids volume at the given price or better
+    /*!
+        Bid price levels keep subtree volume aggregates, so the method
+        has O(log n) complexity.
+
+        \param price - Price
+        \return Total volume of bid price levels with prices greater than or equal to the given one
+    */
+    uint64_t GetCumulativeBidVolume(price_t price) const noexcept;
+    //! Get the cumulative asks volume at the given price or better
+    /*!
+        Ask price levels keep subtree volume aggregates, so the method
+        has O(log n) complexity.
+
+        \param price - Price
+        \return Total volume of ask price levels with prices less than or equal to the given one
+    */
+    uint64_t GetCumulativeAskVolume(price_t price) const noexcept;
+
+    //! Get the cumulative bids orders count at the given price or better
+    /*!
+        \param price - Price
+        \return Orders count of bid price levels with prices greater than or equal to the given one
+    */
+    size_t GetCumulativeBidOrders(price_t price) const noexcept;
+    //! Get the cumulative asks orders count at the given price or better
+    /*!
+        \param price - Price
+        \return Orders count of ask price levels with prices less than or equal to the given one
+    */
+    size_t GetCumulativeAskOrders(price_t price) const noexcept;
+
+    //! Get the bid price level where the cumulative bids volume reaches the given volume
+    /*!
+        Cumulative volume is accumulated from the best bid price level.
+
+        \param volume - Volume
+        \return Pointer to the order book bid price level or nullptr if the total bids volume is less than the given one
+    */
+    const LevelNode* GetBidForVolume(uint64_t volume) const noexcept;
+    //! Get the ask price level where the cumulative asks volume reaches the given volume
+    /*!
+        Cumulative volume is accumulated from the best ask price level.
+
+        \param volume - Volume
+        \return Pointer to the order book ask price level or nullptr if the total asks volume is less than the given one
+    */
+    const LevelNode* GetAskForVolume(uint64_t volume) const noexcept;
+
+    //! Get the order book allocation policy
+    const Allocation& allocation() const noexcept { return _allocation; }
+
+    //! Is the order book in the call auction mode?
+    bool IsAuction() const noexcept { return _auction; }
+    //! Is the order book in the batch auction mode?
+    bool IsBatch() const noexcept { return _batch; }
+    //! Get the order book indicative auction state
+    /*!
+        Equilibrium price is chosen among crossed price levels in a single
+        ascending pass with cumulative bid/ask volumes. The price with the
+        maximal executable volume wins, ties are resolved by the minimal
+        absolute imbalance and then by the market pressure: the higher price
+        for the buy side surplus and the lower price otherwise.
+
+        'All-Or-None' orders do not take part in the auction.
+
+        \return Order book auction state (zero price and volume if the order book is not crossed)
+    */
+    Auction GetAuction() const noexcept;
+
+    //! Simulate the order matching against the order book
+    /*!
+        Simulates the automatic matching of the given order against the current
+        price levels of the opposite order book side without any changes in the
+        order book and without memory allocations. The same rules as the real
+        matching are applied: market (and stop) orders are limited by the best
+        price with the optional slippage, hidden volume is matched, resting
+        'All-Or-None' orders stop the matching if they cannot be filled completely,
+        'Fill-Or-Kill' and 'All-Or-None' orders are matched completely or not at all.
+
+        The handler is called for each matched price level with the following
+        signature: void(const LevelNode& level, price_t price, uint64_t quantity)
+
+        \param order - Order to simulate
+        \param handler - Matched price level handler
+        \return Order book sweep result
+    */
+    template <class THandler>
+    Sweep SimulateOrder(const Order& order, THandler&& handler) const;
+    //! Simulate the order matching against the order book
+    /*!
+        \param order - Order to simulate
+        \return Order book sweep result
+    */
+    Sweep SimulateOrder(const Order& order) const;
 
     //! Get the order book buy stop level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book buy stop level with the given price or nullptr
     */
-    const LevelNode* GetBuyStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetBuyStopLevel(price_t price) const noexcept;
     //! Get the order book sell stop level with the given price
     /*!
         \param price - Price
         \return Pointer to the order book sell stop level with the given price or nullptr
     */
-    const LevelNode* GetSellStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetSellStopLevel(price_t price) const noexcept;
 
     //! Get the order book trailing buy stop level with the given price
     /*!
         \param price - Price
-        \return Pointer to the order book trailing buy stop level with the given price or nullptr
+        \return Pointer to the first order book trailing buy stop level with the given price or nullptr
     */
-    const LevelNode* GetTrailingBuyStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetTrailingBuyStopLevel(price_t price) const noexcept;
     //! Get the order book trailing sell stop level with the given price
     /*!
         \param price - Price
-        \return Pointer to the order book trailing sell stop level with the given price or nullptr
+        \return Pointer to the first order book trailing sell stop level with the given price or nullptr
     */
-    const LevelNode* GetTrailingSellStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetTrailingSellStopLevel(price_t price) const noexcept;
+
+    //! Materialize the stop price of the trailing stop order
+    /*!
+        Market moves reprice the whole trailing stop price level without
+        touching its orders, so the stop price of the trailing stop order
+        (and the limit price of the trailing stop-limit order) is updated
+        from its price level only when the order is activated, changed or
+        requested with MarketManager::GetOrder(). Other orders are not changed.
+
+        \param order - Order to materialize
+        \param level - Price level of the order
+    */
+    static void MaterializeTrailingStopOrder(Order& order, const Level& level) noexcept;
 
 private:
     // Market manager
@@ -138,15 +280,33 @@ private:
     Levels _bids;
     Levels _asks;
 
+    // Price levels subtree aggregates management
+    static void UpdateSubtree(LevelNode* level) noexcept;
+    static void UpdateSubtreePath(LevelNode* level) noexcept;
+    static void RebuildSubtreePath(LevelNode* level) noexcept;
+
     // Price level management
     LevelNode* GetNextLevel(LevelNode* level) noexcept;
+    const LevelNode* GetNextLevel(const LevelNode* level) const noexcept;
     LevelNode* AddLevel(OrderNode* order_ptr);
     LevelNode* DeleteLevel(OrderNode* order_ptr);
 
+    // Bid/Ask price levels depth
+    Depth _bid_depth;
+    Depth _ask_depth;
+
+    // Price levels depth management
+    void EnableDepth(size_t levels);
+    void DisableDepth();
+    void UpdateDepth(const LevelUpdate& update);
+    void RefillDepth(Depth& depth);
+
     // Orders management
     LevelUpdate AddOrder(OrderNode* order_ptr);
-    LevelUpdate ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
+    LevelUpdate ReduceOrder(OrderNode* order_ptr, quantity_t quantity, quantity_t hidden, quantity_t visible);
     LevelUpdate DeleteOrder(OrderNode* order_ptr);
+    std::pair<LevelUpdate, LevelUpdate> ReplaceOrder(OrderNode* order_ptr, quantity_t quantity);
+    LevelUpdate DeleteLevelOrders(LevelNode* level_ptr, OrderNodeList& orders);
 
     // Buy/Sell stop orders levels
     LevelNode* _best_buy_stop;
@@ -161,7 +321,7 @@ private:
 
     // Stop orders management
     void AddStopOrder(OrderNode* order_ptr);
-    void ReduceStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
+    void ReduceStopOrder(OrderNode* order_ptr, quantity_t quantity, quantity_t hidden, quantity_t visible);
     void DeleteStopOrder(OrderNode* order_ptr);
 
     // Buy/Sell trailing stop orders levels
@@ -172,33 +332,73 @@ private:
 
     // Trailing stop orders price level management
     LevelNode* GetNextTrailingStopLevel(LevelNode* level) noexcept;
+    LevelNode* GetTrailingStopLevel(const OrderNode* order_ptr) noexcept;
     LevelNode* AddTrailingStopLevel(OrderNode* order_ptr);
     LevelNode* DeleteTrailingStopLevel(OrderNode* order_ptr);
+    LevelNode* LinkTrailingStopLevel(LevelNode* level_ptr);
+    void UnlinkTrailingStopLevel(LevelNode* level_ptr);
+    void MergeTrailingStopLevel(LevelNode* level_ptr, LevelNode* target_ptr, bool front);
 
     // Trailing stop orders management
     void AddTrailingStopOrder(OrderNode* order_ptr);
-    void ReduceTrailingStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
+    void ReduceTrailingStopOrder(OrderNode* order_ptr, quantity_t quantity, quantity_t hidden, quantity_t visible);
     void DeleteTrailingStopOrder(OrderNode* order_ptr);
+    static void MaterializeTrailingStopOrder(OrderNode* order_ptr) noexcept;
 
     // Trailing stop price calculation
-    uint64_t CalculateTrailingStopPrice(const Order& order) const noexcept;
+    price_t CalculateTrailingStopPrice(const Order& order) const noexcept;
+    price_t CalculateTrailingStopPrice(const LevelNode& level) const noexcept;
+    price_t CalculateTrailingStopPrice(bool buy, price_t stop_price, int64_t trailing_distance, int64_t trailing_step) const noexcept;
 
     // Market last and trailing prices
-    uint64_t _last_bid_price;
-    uint64_t _last_ask_price;
-    uint64_t _matching_bid_price;
-    uint64_t _matching_ask_price;
-    uint64_t _trailing_bid_price;
-    uint64_t _trailing_ask_price;
+    price_t _last_bid_price;
+    price_t _last_ask_price;
+    price_t _matching_bid_price;
+    price_t _matching_ask_price;
+    price_t _trailing_bid_price;
+    price_t _trailing_ask_price;
 
     // Update market last prices
-    uint64_t GetMarketPriceBid() const noexcept;
-    uint64_t GetMarketPriceAsk() const noexcept;
-    uint64_t GetMarketTrailingStopPriceBid() const noexcept;
-    uint64_t GetMarketTrailingStopPriceAsk() const noexcept;
-    void UpdateLastPrice(const Order& order, uint64_t price) noexcept;
-    void UpdateMatchingPrice(const Order& order, uint64_t price) noexcept;
+    price_t GetMarketPriceBid() const noexcept;
+    price_t GetMarketPriceAsk() const noexcept;
+    price_t GetMarketTrailingStopPriceBid() const noexcept;
+    price_t GetMarketTrailingStopPriceAsk() const noexcept;
+    void UpdateLastPrice(const Order& order, price_t price) noexcept;
+    void UpdateMatchingPrice(const Order& order, price_t price) noexcept;
     void ResetMatchingPrice() noexcept;
+
+    // Stop orders activation triggers (nearest stop price levels against market prices)
+    bool IsBuyStopTriggered() const noexcept;
+    bool IsSellStopTriggered() const noexcept;
+
+    // Stop orders price level activation
+    void ActivateStopLevel(LevelNode* level_ptr, OrderNodeList& orders);
+
+    // Allocation policy
+    Allocation _allocation;
+
+    // Call auction mode
+    bool _auction;
+
+    // Batch auction mode with the arrival list of the current batch
+    bool _batch;
+    OrderNodeList _batch_orders;
+    std::vector<uint64_t> _batch_ioc_orders;
+
+    // Best bid and offer block published for readers from other threads
+    std::unique_ptr<BBOBlock> _bbo;
+
+    // Best bid and offer block management
+    void EnableBBO();
+    void PublishBBO() const noexcept;
+
+    // Matching chain calculation
+    quantity_t CalculateMatchingChain(const LevelNode* level_ptr, price_t price, quantity_t volume) const noexcept;
+
+    // Bid/Ask price levels revision (changed with each bid/ask order update)
+    uint64_t _revision;
+    // Revision of the order book where 'All-Or-None' orders matching chain was not found
+    uint64_t _aon_unmatched_revision;
 };
 
 } // namespace Matching
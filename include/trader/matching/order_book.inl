@@ -23,40 +23,195 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderBook& order_b
     return stream;
 }
 
-inline const LevelNode* OrderBook::GetBid(uint64_t price) const noexcept
+inline const LevelNode* OrderBook::GetBid(price_t price) const noexcept
 {
     auto it = _bids.find(LevelNode(LevelType::BID, price));
     return (it != _bids.end()) ? it.operator->() : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetAsk(uint64_t price) const noexcept
+inline const LevelNode* OrderBook::GetAsk(price_t price) const noexcept
 {
     auto it = _asks.find(LevelNode(LevelType::ASK, price));
     return (it != _asks.end()) ? it.operator->() : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetBuyStopLevel(uint64_t price) const noexcept
+inline const LevelNode* OrderBook::GetBuyStopLevel(price_t price) const noexcept
 {
     auto it = _buy_stop.find(LevelNode(LevelType::ASK, price));
     return (it != _buy_stop.end()) ? it.operator->() : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetSellStopLevel(uint64_t price) const noexcept
+inline const LevelNode* OrderBook::GetSellStopLevel(price_t price) const noexcept
 {
     auto it = _sell_stop.find(LevelNode(LevelType::BID, price));
     return (it != _sell_stop.end()) ? it.operator->() : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetTrailingBuyStopLevel(uint64_t price) const noexcept
+inline const LevelNode* OrderBook::GetTrailingBuyStopLevel(price_t price) const noexcept
 {
-    auto it = _trailing_buy_stop.find(LevelNode(LevelType::ASK, price));
-    return (it != _trailing_buy_stop.end()) ? it.operator->() : nullptr;
+    auto it = _trailing_buy_stop.lower_bound(LevelNode(LevelType::ASK, price, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::min()));
+    return ((it != _trailing_buy_stop.end()) && (it->Price == price)) ? it.operator->() : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetTrailingSellStopLevel(uint64_t price) const noexcept
+inline const LevelNode* OrderBook::GetTrailingSellStopLevel(price_t price) const noexcept
 {
-    auto it = _trailing_sell_stop.find(LevelNode(LevelType::BID, price));
-    return (it != _trailing_sell_stop.end()) ? it.operator->() : nullptr;
+    auto it = _trailing_sell_stop.lower_bound(LevelNode(LevelType::BID, price, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::min()));
+    return ((it != _trailing_sell_stop.end()) && (it->Price == price)) ? it.operator->() : nullptr;
+}
+
+inline void OrderBook::MaterializeTrailingStopOrder(Order& order, const Level& level) noexcept
+{
+    // Only trailing stop orders are repriced lazily
+    if ((!order.IsTrailingStop() && !order.IsTrailingStopLimit()) || (order.StopPrice == level.Price))
+        return;
+
+    // Keep the distance between the limit price and the stop price
+    int64_t diff = order.Price - order.StopPrice;
+    order.StopPrice = level.Price;
+    if (order.IsTrailingStopLimit())
+        order.Price = order.StopPrice + diff;
+}
+
+inline void OrderBook::MaterializeTrailingStopOrder(OrderNode* order_ptr) noexcept
+{
+    // Only trailing stop orders are repriced lazily
+    if (!order_ptr->IsTrailingStop() && !order_ptr->IsTrailingStopLimit())
+        return;
+
+    LevelNode* level_ptr = order_ptr->Level;
+    if (level_ptr != nullptr)
+        MaterializeTrailingStopOrder(*order_ptr, *level_ptr);
+}
+
+template <class THandler>
+inline Sweep OrderBook::SimulateOrder(const Order& order, THandler&& handler) const
+{
+    Sweep sweep;
+    sweep.Leftover = order.LeavesQuantity;
+
+    // Start the matching simulation from the top of the book
+    const LevelNode* level_ptr = order.IsBuy() ? _best_ask : _best_bid;
+    if ((level_ptr == nullptr) || (order.LeavesQuantity == 0))
+        return sweep;
+
+    // Calculate acceptable market order price with optional slippage value
+    price_t price = order.Price;
+    if (order.IsMarket() || order.IsStop() || order.IsTrailingStop())
+    {
+        if (order.IsBuy())
+            price = (level_ptr->Price > (std::numeric_limits<price_t>::max() - order.Slippage)) ? std::numeric_limits<price_t>::max() : (level_ptr->Price + order.Slippage);
+        else
+            price = (level_ptr->Price < (std::numeric_limits<price_t>::min() + order.Slippage)) ? std::numeric_limits<price_t>::min() : (level_ptr->Price - order.Slippage);
+    }
+
+    // Check if the order could be filled completely
+    sweep.Fillable = (CalculateMatchingChain(level_ptr, price, order.LeavesQuantity) > 0);
+
+    // 'Fill-Or-Kill'/'All-Or-None' orders are matched completely at the order price or not matched at all
+    bool chain = order.IsFOK() || order.IsAON();
+    if (chain && !sweep.Fillable)
+        return sweep;
+
+    quantity_t leaves = order.LeavesQuantity;
+    bool stop = false;
+
+    // Travel through price levels
+    while ((level_ptr != nullptr) && (leaves > 0) && !stop)
+    {
+        // Check the arbitrage bid/ask prices
+        bool arbitrage = order.IsBuy() ? (price >= level_ptr->Price) : (price <= level_ptr->Price);
+        if (!arbitrage)
+            break;
+
+        quantity_t quantity = 0;
+
+        // Price level without 'All-Or-None' orders is matched without the orders walk
+        if (level_ptr->AONOrders == 0)
+            quantity = (quantity_t)std::min<volume_t>(level_ptr->TotalVolume, leaves);
+        else
+        {
+            // Travel through orders at current price level
+            for (const OrderNode* order_ptr = level_ptr->OrderList.front(); (order_ptr != nullptr) && (quantity < leaves); order_ptr = order_ptr->next)
+            {
+                // Special case for 'All-Or-None' orders
+                if (order_ptr->IsAON() && (order_ptr->LeavesQuantity > (leaves - quantity)))
+                {
+                    stop = true;
+                    break;
+                }
+
+                quantity += std::min(order_ptr->LeavesQuantity, (quantity_t)(leaves - quantity));
+            }
+        }
+
+        if (quantity > 0)
+        {
+            // Get the execution price
+            price_t execution_price = chain ? price : level_ptr->Price;
+
+            // Update the sweep result
+            if (sweep.Levels++ == 0)
+                sweep.BestPrice = execution_price;
+            sweep.WorstPrice = execution_price;
+            sweep.Quantity += quantity;
+            sweep.Notional += (uint64_t)execution_price * quantity;
+            leaves -= quantity;
+
+            // Call the matched price level handler
+            handler(*level_ptr, execution_price, (uint64_t)quantity);
+        }
+
+        // Switch to the next price level
+        level_ptr = GetNextLevel(level_ptr);
+    }
+
+    sweep.Leftover = leaves;
+
+    return sweep;
+}
+
+inline Sweep OrderBook::SimulateOrder(const Order& order) const
+{
+    return SimulateOrder(order, [](const LevelNode&, price_t, uint64_t) {});
+}
+
+inline void OrderBook::UpdateSubtree(LevelNode* level) noexcept
+{
+    level->SubtreeVolume = level->TotalVolume;
+    level->SubtreeOrders = level->Orders;
+    if (level->left != nullptr)
+    {
+        level->SubtreeVolume += level->left->SubtreeVolume;
+        level->SubtreeOrders += level->left->SubtreeOrders;
+    }
+    if (level->right != nullptr)
+    {
+        level->SubtreeVolume += level->right->SubtreeVolume;
+        level->SubtreeOrders += level->right->SubtreeOrders;
+    }
+}
+
+inline void OrderBook::UpdateSubtreePath(LevelNode* level) noexcept
+{
+    // Update subtree aggregates of the price level and all its parents
+    for (; level != nullptr; level = level->parent)
+        UpdateSubtree(level);
+}
+
+inline void OrderBook::RebuildSubtreePath(LevelNode* level) noexcept
+{
+    // Tree rotations restructure only the rotation top node and its direct
+    // children, and every rotation top node is a parent of the inserted or
+    // erased node. So updating children of each parent before the parent
+    // itself repairs all subtree aggregates.
+    for (; level != nullptr; level = level->parent)
+    {
+        if (level->left != nullptr)
+            UpdateSubtree(level->left);
+        if (level->right != nullptr)
+            UpdateSubtree(level->right);
+        UpdateSubtree(level);
+    }
 }
 
 inline LevelNode* OrderBook::GetNextLevel(LevelNode* level) noexcept
@@ -75,6 +230,47 @@ inline LevelNode* OrderBook::GetNextLevel(LevelNode* level) noexcept
     }
 }
 
+inline const LevelNode* OrderBook::GetNextLevel(const LevelNode* level) const noexcept
+{
+    if (level->IsBid())
+    {
+        Levels::const_reverse_iterator it(&_bids, level);
+        ++it;
+        return it.operator->();
+    }
+    else
+    {
+        Levels::const_iterator it(&_asks, level);
+        ++it;
+        return it.operator->();
+    }
+}
+
+inline void OrderBook::UpdateDepth(const LevelUpdate& update)
+{
+    Depth& depth = update.Update.IsBid() ? _bid_depth : _ask_depth;
+
+    // Skip disabled depth
+    if (!depth)
+        return;
+
+    switch (update.Type)
+    {
+        case UpdateType::ADD:
+            depth.Insert(update.Update);
+            break;
+        case UpdateType::UPDATE:
+            depth.Update(update.Update);
+            break;
+        case UpdateType::DELETE:
+            if (depth.Erase(update.Update))
+                RefillDepth(depth);
+            break;
+        default:
+            break;
+    }
+}
+
 inline LevelNode* OrderBook::GetNextStopLevel(LevelNode* level) noexcept
 {
     if (level->IsBid())
@@ -91,6 +287,15 @@ inline LevelNode* OrderBook::GetNextStopLevel(LevelNode* level) noexcept
     }
 }
 
+inline LevelNode* OrderBook::GetTrailingStopLevel(const OrderNode* order_ptr) noexcept
+{
+    // Trailing stop price level is shared only by orders with the same trailing distance and step
+    LevelNode key(order_ptr->IsBuy() ? LevelType::ASK : LevelType::BID, order_ptr->StopPrice, order_ptr->TrailingDistance, order_ptr->TrailingStep);
+    Levels& levels = order_ptr->IsBuy() ? _trailing_buy_stop : _trailing_sell_stop;
+    auto it = levels.find(key);
+    return (it != levels.end()) ? it.operator->() : nullptr;
+}
+
 inline LevelNode* OrderBook::GetNextTrailingStopLevel(LevelNode* level) noexcept
 {
     if (level->IsBid())
@@ -107,35 +312,49 @@ inline LevelNode* OrderBook::GetNextTrailingStopLevel(LevelNode* level) noexcept
     }
 }
 
-inline uint64_t OrderBook::GetMarketPriceBid() const noexcept
+inline price_t OrderBook::GetMarketPriceBid() const noexcept
 {
-    uint64_t matching_price = _matching_bid_price;
-    uint64_t best_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
+    price_t matching_price = _matching_bid_price;
+    price_t best_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
     return std::max(matching_price, best_price);
 }
 
-inline uint64_t OrderBook::GetMarketPriceAsk() const noexcept
+inline price_t OrderBook::GetMarketPriceAsk() const noexcept
 {
-    uint64_t matching_price = _matching_ask_price;
-    uint64_t best_price = (_best_ask != nullptr) ? _best_ask->Price : std::numeric_limits<uint64_t>::max();
+    price_t matching_price = _matching_ask_price;
+    price_t best_price = (_best_ask != nullptr) ? _best_ask->Price : std::numeric_limits<price_t>::max();
     return std::min(matching_price, best_price);
 }
 
-inline uint64_t OrderBook::GetMarketTrailingStopPriceBid() const noexcept
+inline price_t OrderBook::GetMarketTrailingStopPriceBid() const noexcept
 {
-    uint64_t last_price = _last_bid_price;
-    uint64_t best_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
+    price_t last_price = _last_bid_price;
+    price_t best_price = (_best_bid != nullptr) ? _best_bid->Price : 0;
     return std::min(last_price, best_price);
 }
 
-inline uint64_t OrderBook::GetMarketTrailingStopPriceAsk() const noexcept
+inline price_t OrderBook::GetMarketTrailingStopPriceAsk() const noexcept
 {
-    uint64_t last_price = _last_ask_price;
-    uint64_t best_price = (_best_ask != nullptr) ? _best_ask->Price : std::numeric_limits<uint64_t>::max();
+    price_t last_price = _last_ask_price;
+    price_t best_price = (_best_ask != nullptr) ? _best_ask->Price : std::numeric_limits<price_t>::max();
     return std::max(last_price, best_price);
 }
 
-inline void OrderBook::UpdateLastPrice(const Order& order, uint64_t price) noexcept
+inline bool OrderBook::IsBuyStopTriggered() const noexcept
+{
+    price_t market_price = GetMarketPriceAsk();
+    return ((_best_buy_stop != nullptr) && (market_price >= _best_buy_stop->Price)) ||
+           ((_best_trailing_buy_stop != nullptr) && (market_price >= _best_trailing_buy_stop->Price));
+}
+
+inline bool OrderBook::IsSellStopTriggered() const noexcept
+{
+    price_t market_price = GetMarketPriceBid();
+    return ((_best_sell_stop != nullptr) && (market_price <= _best_sell_stop->Price)) ||
+           ((_best_trailing_sell_stop != nullptr) && (market_price <= _best_trailing_sell_stop->Price));
+}
+
+inline void OrderBook::UpdateLastPrice(const Order& order, price_t price) noexcept
 {
     if (order.IsBuy())
         _last_bid_price = price;
@@ -143,7 +362,7 @@ inline void OrderBook::UpdateLastPrice(const Order& order, uint64_t price) noexc
         _last_ask_price = price;
 }
 
-inline void OrderBook::UpdateMatchingPrice(const Order& order, uint64_t price) noexcept
+inline void OrderBook::UpdateMatchingPrice(const Order& order, price_t price) noexcept
 {
     if (order.IsBuy())
         _matching_bid_price = price;
@@ -154,7 +373,7 @@ inline void OrderBook::UpdateMatchingPrice(const Order& order, uint64_t price) n
 inline void OrderBook::ResetMatchingPrice() noexcept
 {
     _matching_bid_price = 0;
-    _matching_ask_price = std::numeric_limits<uint64_t>::max();
+    _matching_ask_price = std::numeric_limits<price_t>::max();
 }
 
 } // namespace Matching
@@ -0,0 +1,58 @@
+/*!
+    \file quote.h
+    \brief Quote definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_QUOTE_H
+#define CPPTRADER_MATCHING_QUOTE_H
+
+#include "order.h"
+
+namespace CppTrader {
+namespace Matching {
+
+//! Quote
+/*!
+    Quote is a single entry of the market maker quotes ladder used in
+    MarketManager::MassQuote() method. Quote Id is the Id of the limit
+    order which keeps the quote in the order book, so the same quote Id
+    could be refreshed many times. Zero quantity cancels the quote.
+
+    Not thread-safe.
+*/
+struct Quote
+{
+    //! Quote Id (Id of the corresponding limit order)
+    uint64_t Id;
+    //! Quote side
+    OrderSide Side;
+    //! Quote price
+    uint64_t Price;
+    //! Quote quantity (zero to cancel the quote)
+    uint64_t Quantity;
+
+    Quote(uint64_t id, OrderSide side, uint64_t price, uint64_t quantity) noexcept
+        : Id(id), Side(side), Price(price), Quantity(quantity)
+    {}
+    Quote(const Quote&) noexcept = default;
+    Quote(Quote&&) noexcept = default;
+    ~Quote() noexcept = default;
+
+    Quote& operator=(const Quote&) noexcept = default;
+    Quote& operator=(Quote&&) noexcept = default;
+
+    //! Prepare a new buy quote
+    static Quote Buy(uint64_t id, uint64_t price, uint64_t quantity) noexcept { return Quote(id, OrderSide::BUY, price, quantity); }
+    //! Prepare a new sell quote
+    static Quote Sell(uint64_t id, uint64_t price, uint64_t quantity) noexcept { return Quote(id, OrderSide::SELL, price, quantity); }
+    //! Prepare a quote cancel
+    static Quote Cancel(uint64_t id) noexcept { return Quote(id, OrderSide::BUY, 0, 0); }
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#endif // CPPTRADER_MATCHING_QUOTE_H
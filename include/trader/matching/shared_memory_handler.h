@@ -0,0 +1,135 @@
+/*!
+    \file shared_memory_handler.h
+    \brief Shared memory market handler definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_SHARED_MEMORY_HANDLER_H
+#define CPPTRADER_MATCHING_SHARED_MEMORY_HANDLER_H
+
+#include "market_event_handler.h"
+#include "market_event_ring.h"
+#include "market_manager.h"
+
+#include "system/shared_memory.h"
+
+#include <string>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Shared memory market handler
+/*!
+    Shared memory market handler serializes order book, price level, order
+    and execution events into the market event ring placed into the named
+    shared memory block (/dev/shm/<name> on Linux), so any number of other
+    processes could consume them with SharedMemoryReader at their own pace.
+    Publishing is a plain memory copy without system calls and without
+    waiting for consumers.
+
+    Consumers that fall behind request a market snapshot. The market manager
+    owner thread should check SharedMemoryHandler::IsSnapshotRequested() from
+    time to time and call SharedMemoryHandler::PublishSnapshot() between
+    market operations.
+
+    Not thread-safe.
+*/
+class SharedMemoryHandler : public MarketEventHandler<SharedMemoryHandler>
+{
+public:
+    //! Create the shared memory market handler
+    /*!
+        \param name - Shared memory block name
+        \param capacity - Ring capacity in events (power of two, default is 1M events)
+    */
+    explicit SharedMemoryHandler(const std::string& name, size_t capacity = 1024 * 1024);
+    SharedMemoryHandler(const SharedMemoryHandler&) = delete;
+    SharedMemoryHandler(SharedMemoryHandler&&) = delete;
+    virtual ~SharedMemoryHandler() = default;
+
+    SharedMemoryHandler& operator=(const SharedMemoryHandler&) = delete;
+    SharedMemoryHandler& operator=(SharedMemoryHandler&&) = delete;
+
+    //! Get the shared memory block name
+    const std::string& name() const noexcept { return _shared_memory.name(); }
+    //! Get the market event ring
+    const MarketEventRing& ring() const noexcept { return _ring; }
+
+    //! Is a new market snapshot requested by any consumer?
+    bool IsSnapshotRequested() const noexcept { return _ring.IsSnapshotRequested(); }
+
+    //! Publish the market snapshot
+    /*!
+        Snapshot contains all price levels and all orders of all order books
+        of the market manager framed with SNAPSHOT_BEGIN and SNAPSHOT_END events.
+        Orders of each order book follow its price levels in the order of their
+        priority: limit orders, stop orders, trailing stop orders and orders of
+        the current batch.
+
+        Snapshot which does not fit into the ring capacity would be overwritten
+        before consumers could read it, so it is not published at all and the
+        snapshot request stays pending.
+
+        \param market - Market manager
+        \return 'true' if the snapshot was published, 'false' if the snapshot exceeds the ring capacity
+    */
+    bool PublishSnapshot(const MarketManager& market);
+
+private:
+    CppCommon::SharedMemory _shared_memory;
+    MarketEventRing _ring;
+
+    void PublishSnapshotOrders(const OrderBook::Levels& levels);
+
+    friend class MarketEventHandler<SharedMemoryHandler>;
+    void onMarketEvent(const MarketEvent& event) noexcept { _ring.Publish(event); }
+};
+
+//! Shared memory market reader
+/*!
+    Shared memory market reader attaches to the market event ring created
+    by SharedMemoryHandler with the same name and capacity in this or any
+    other process and reads market events with its own cursor.
+
+    Not thread-safe.
+*/
+class SharedMemoryReader
+{
+public:
+    //! Open the shared memory market reader
+    /*!
+        \param name - Shared memory block name
+        \param capacity - Ring capacity in events (must be the same as in SharedMemoryHandler)
+    */
+    explicit SharedMemoryReader(const std::string& name, size_t capacity = 1024 * 1024);
+    SharedMemoryReader(const SharedMemoryReader&) = delete;
+    SharedMemoryReader(SharedMemoryReader&&) = delete;
+    ~SharedMemoryReader() = default;
+
+    SharedMemoryReader& operator=(const SharedMemoryReader&) = delete;
+    SharedMemoryReader& operator=(SharedMemoryReader&&) = delete;
+
+    //! Get the market event ring reader
+    const MarketEventRingReader& reader() const noexcept { return _reader; }
+
+    //! Read the next market event
+    /*!
+        \param event - Market event to read
+        \return Read status
+    */
+    MarketEventRingStatus Read(MarketEvent& event) noexcept { return _reader.Read(event); }
+
+    //! Resynchronize the reader after the overrun
+    void Resync() noexcept { _reader.Resync(); }
+
+private:
+    CppCommon::SharedMemory _shared_memory;
+    MarketEventRingReader _reader;
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#endif // CPPTRADER_MATCHING_SHARED_MEMORY_HANDLER_H
@@ -0,0 +1,60 @@
+/*!
+    \file sweep.h
+    \brief Order book sweep definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_SWEEP_H
+#define CPPTRADER_MATCHING_SWEEP_H
+
+#include "types.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CppTrader {
+namespace Matching {
+
+//! Order book sweep
+/*!
+    Order book sweep is a result of the order matching simulation against
+    the current order book price levels. It is calculated with the same rules
+    as the real matching, but without any changes in the order book.
+
+    Not thread-safe.
+*/
+struct Sweep
+{
+    //! Matched quantity
+    uint64_t Quantity;
+    //! Leftover quantity which cannot be matched
+    uint64_t Leftover;
+    //! Matched notional (sum of products of execution prices and quantities)
+    uint64_t Notional;
+    //! Count of matched price levels
+    size_t Levels;
+    //! First execution price
+    price_t BestPrice;
+    //! Last execution price
+    price_t WorstPrice;
+    //! Is 'Fill-Or-Kill' order with the same price and quantity will be filled?
+    bool Fillable;
+
+    Sweep() noexcept : Quantity(0), Leftover(0), Notional(0), Levels(0), BestPrice(0), WorstPrice(0), Fillable(false) {}
+    Sweep(const Sweep&) noexcept = default;
+    Sweep(Sweep&&) noexcept = default;
+    ~Sweep() noexcept = default;
+
+    Sweep& operator=(const Sweep&) noexcept = default;
+    Sweep& operator=(Sweep&&) noexcept = default;
+
+    //! Get the average execution price (zero if nothing is matched)
+    double AveragePrice() const noexcept { return (Quantity > 0) ? ((double)Notional / (double)Quantity) : 0.0; }
+};
+
+} // namespace Matching
+} // namespace CppTrader
+
+#endif // CPPTRADER_MATCHING_SWEEP_H
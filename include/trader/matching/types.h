@@ -0,0 +1,83 @@
+/*!
+    \file types.h
+    \brief Price and quantity types definition
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#ifndef CPPTRADER_MATCHING_TYPES_H
+#define CPPTRADER_MATCHING_TYPES_H
+
+#include <cstdint>
+#include <limits>
+
+namespace CppTrader {
+namespace Matching {
+
+#if defined(CPPTRADER_COMPACT_TYPES)
+//! Price type (compact 32-bit version)
+typedef uint32_t price_t;
+//! Quantity type (compact 32-bit version)
+typedef uint32_t quantity_t;
+#else
+//! Price type
+typedef uint64_t price_t;
+//! Quantity type
+typedef uint64_t quantity_t;
+#endif
+
+//! Volume type
+/*!
+    Volume aggregates quantities of many orders (e.g. price level volumes and
+    matching chains), so it is always 64-bit even with compact quantities.
+*/
+typedef uint64_t volume_t;
+
+//! Check if the given value could be represented as a price
+/*!
+    Prices and quantities are stored as 64-bit unsigned integers by default.
+    Compact order books (e.g. equities with NASDAQ ITCH 32-bit prices and
+    shares) could be built with CPPTRADER_COMPACT_TYPES definition, which
+    halves the memory used by price and quantity fields in orders, levels
+    and level updates. Aggregated volumes (see volume_t) always stay 64-bit.
+    All public API methods which accept 64-bit values
+    check them with the following helpers before narrowing. The maximal
+    value of the compact type is reserved for saturated out of range values.
+
+    \param value - Value to check
+    \return 'true' if the value fits into the price type, 'false' otherwise
+*/
+bool IsValidPrice(uint64_t value) noexcept;
+//! Check if the given value could be represented as a quantity
+/*!
+    \param value - Value to check
+    \return 'true' if the value fits into the quantity type, 'false' otherwise
+*/
+bool IsValidQuantity(uint64_t value) noexcept;
+
+//! Narrow the given value to the price type with saturation
+/*!
+    Used for upper bound values (e.g. market order slippage) where any value
+    out of the price type range means 'unlimited'.
+
+    \param value - Value to narrow
+    \return Narrowed price value
+*/
+price_t SaturatePrice(uint64_t value) noexcept;
+//! Narrow the given value to the quantity type with saturation
+/*!
+    Used for upper bound values (e.g. max visible quantity) where any value
+    out of the quantity type range means 'unlimited'.
+
+    \param value - Value to narrow
+    \return Narrowed quantity value
+*/
+quantity_t SaturateQuantity(uint64_t value) noexcept;
+
+} // namespace Matching
+} // namespace CppTrader
+
+#include "types.inl"
+
+#endif // CPPTRADER_MATCHING_TYPES_H
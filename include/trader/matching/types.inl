@@ -0,0 +1,39 @@
+/*!
+    \file types.inl
+    \brief Price and quantity types inline implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+namespace CppTrader {
+namespace Matching {
+
+inline bool IsValidPrice(uint64_t value) noexcept
+{
+    if constexpr (sizeof(price_t) < sizeof(uint64_t))
+        return (value < std::numeric_limits<price_t>::max());
+    else
+        return true;
+}
+
+inline bool IsValidQuantity(uint64_t value) noexcept
+{
+    if constexpr (sizeof(quantity_t) < sizeof(uint64_t))
+        return (value < std::numeric_limits<quantity_t>::max());
+    else
+        return true;
+}
+
+inline price_t SaturatePrice(uint64_t value) noexcept
+{
+    return IsValidPrice(value) ? (price_t)value : std::numeric_limits<price_t>::max();
+}
+
+inline quantity_t SaturateQuantity(uint64_t value) noexcept
+{
+    return IsValidQuantity(value) ? (quantity_t)value : std::numeric_limits<quantity_t>::max();
+}
+
+} // namespace Matching
+} // namespace CppTrader
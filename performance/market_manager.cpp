@@ -193,5 +193,13 @@ int main(int argc, char** argv)
     std::cout << "Delete order operations: " << market_handler.delete_orders() << std::endl;
     std::cout << "Execute order operations: " << market_handler.execute_orders() << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Memory statistics: " << std::endl;
+    std::cout << "Order size: " << sizeof(Order) << " bytes" << std::endl;
+    std::cout << "Order node size: " << sizeof(OrderNode) << " bytes" << std::endl;
+    std::cout << "Price level node size: " << sizeof(LevelNode) << " bytes" << std::endl;
+    std::cout << "Max orders memory: " << market_handler.max_orders() * sizeof(OrderNode) << " bytes" << std::endl;
+
     return 0;
 }
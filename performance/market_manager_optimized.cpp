@@ -12,6 +12,8 @@
 #include <OptionParser.h>
 
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 using namespace CppCommon;
@@ -43,40 +45,48 @@ struct Level
     size_t Orders;
 };
 
+// Price levels are addressed by 32-bit indexes in the pool instead of size_t ones,
+// which halves the price level index stored in each order and price entry. Indexes
+// survive the pool growth, but level pointers and references do not, so they must
+// not be kept over allocate() calls.
 class LevelPool
 {
 public:
     LevelPool() = default;
     explicit LevelPool(size_t reserve) { _allocated.reserve(reserve); }
 
-    Level& operator[](size_t index) { return _allocated[index]; }
+    Level& operator[](uint32_t index) { return _allocated[index]; }
 
-    Level* get(size_t index) { return &_allocated[index]; }
+    Level* get(uint32_t index) { return &_allocated[index]; }
 
-    size_t allocate()
+    uint32_t allocate()
     {
         if (_free.empty())
         {
-            size_t index = _allocated.size();
+            // 32-bit price level indexes must not be truncated
+            if (_allocated.size() >= std::numeric_limits<uint32_t>::max())
+                throw std::length_error("Price level pool is out of 32-bit indexes!");
+
+            uint32_t index = (uint32_t)_allocated.size();
             _allocated.emplace_back();
             return index;
         }
         else
         {
-            size_t index = _free.back();
+            uint32_t index = _free.back();
             _free.pop_back();
             return index;
         }
     }
 
-    void free(size_t index)
+    void free(uint32_t index)
     {
         _free.push_back(index);
     }
 
 private:
     std::vector<Level> _allocated;
-    std::vector<size_t> _free;
+    std::vector<uint32_t> _free;
 };
 
 enum class UpdateType : uint8_t
@@ -106,13 +116,13 @@ struct Order
     OrderSide Side;
     uint32_t Price;
     uint32_t Quantity;
-    size_t Level;
+    uint32_t Level;
 };
 
 struct PriceLevel
 {
     uint32_t Price;
-    size_t Level;
+    uint32_t Level;
 };
 
 class OrderBook
@@ -151,7 +161,7 @@ private:
 
     static LevelPool _levels;
 
-    std::pair<size_t, UpdateType> FindLevel(Order* order_ptr)
+    std::pair<uint32_t, UpdateType> FindLevel(Order* order_ptr)
     {
         if (order_ptr->Side == OrderSide::BUY)
         {
@@ -167,7 +177,7 @@ private:
             }
 
             // Create a new price level
-            size_t level_index = _levels.allocate();
+            uint32_t level_index = _levels.allocate();
             Level* level_ptr = _levels.get(level_index);
             level_ptr->Type = LevelType::BID;
             level_ptr->Price = order_ptr->Price;
@@ -193,7 +203,7 @@ private:
             }
 
             // Create a new price level
-            size_t level_index = _levels.allocate();
+            uint32_t level_index = _levels.allocate();
             Level* level_ptr = _levels.get(level_index);
             level_ptr->Type = LevelType::ASK;
             level_ptr->Price = order_ptr->Price;
@@ -247,7 +257,7 @@ private:
     LevelUpdate AddOrder(Order* order_ptr)
     {
         // Find the price level for the order
-        std::pair<size_t, UpdateType> find_result = FindLevel(order_ptr);
+        std::pair<uint32_t, UpdateType> find_result = FindLevel(order_ptr);
         Level* level_ptr = _levels.get(find_result.first);
 
         // Update the price level volume
@@ -779,5 +789,12 @@ int main(int argc, char** argv)
     std::cout << "Delete order operations: " << market_handler.delete_orders() << std::endl;
     std::cout << "Execute order operations: " << market_handler.execute_orders() << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Memory statistics: " << std::endl;
+    std::cout << "Order size: " << sizeof(Order) << " bytes" << std::endl;
+    std::cout << "Price level size: " << sizeof(Level) << " bytes" << std::endl;
+    std::cout << "Price level link size: " << sizeof(PriceLevel) << " bytes" << std::endl;
+
     return 0;
 }
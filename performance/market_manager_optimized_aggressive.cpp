@@ -11,6 +11,8 @@
 
 #include <OptionParser.h>
 
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 using namespace CppCommon;
@@ -23,53 +25,58 @@ struct Level
     uint32_t Volume;
 };
 
+// 32-bit price level pool (see LevelPool in market_manager_optimized.cpp)
 class LevelPool
 {
 public:
     LevelPool() = default;
     explicit LevelPool(size_t reserve) { _allocated.reserve(reserve); }
 
-    Level& operator[](size_t index) { return _allocated[index]; }
+    Level& operator[](uint32_t index) { return _allocated[index]; }
 
-    Level* get(size_t index) { return &_allocated[index]; }
+    Level* get(uint32_t index) { return &_allocated[index]; }
 
-    size_t allocate()
+    uint32_t allocate()
     {
         if (_free.empty())
         {
-            size_t index = _allocated.size();
+            // 32-bit price level indexes must not be truncated
+            if (_allocated.size() >= std::numeric_limits<uint32_t>::max())
+                throw std::length_error("Price level pool is out of 32-bit indexes!");
+
+            uint32_t index = (uint32_t)_allocated.size();
             _allocated.emplace_back();
             return index;
         }
         else
         {
-            size_t index = _free.back();
+            uint32_t index = _free.back();
             _free.pop_back();
             return index;
         }
     }
 
-    void free(size_t index)
+    void free(uint32_t index)
     {
         _free.push_back(index);
     }
 
 private:
     std::vector<Level> _allocated;
-    std::vector<size_t> _free;
+    std::vector<uint32_t> _free;
 };
 
 struct Order
 {
     uint16_t Symbol;
     uint32_t Quantity;
-    size_t Level;
+    uint32_t Level;
 };
 
 struct PriceLevel
 {
     int32_t Price;
-    size_t Level;
+    uint32_t Level;
 };
 
 class OrderBook
@@ -108,7 +115,7 @@ private:
 
     static LevelPool _levels;
 
-    size_t FindLevel(int32_t price)
+    uint32_t FindLevel(int32_t price)
     {
         // Choose the price level collection
         Levels* levels = (price > 0) ? &_bids : &_asks;
@@ -125,7 +132,7 @@ private:
         }
 
         // Create a new price level
-        size_t level_index = _levels.allocate();
+        uint32_t level_index = _levels.allocate();
         Level* level_ptr = _levels.get(level_index);
         level_ptr->Price = price;
         level_ptr->Volume = 0;
@@ -163,7 +170,7 @@ private:
     void AddOrder(Order* order_ptr, int32_t price)
     {
         // Find the price level for the order
-        size_t level_index = FindLevel(price);
+        uint32_t level_index = FindLevel(price);
         Level* level_ptr = _levels.get(level_index);
 
         // Update the price level volume
@@ -455,5 +462,12 @@ int main(int argc, char** argv)
     std::cout << "ITCH message latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod((timestamp_stop - timestamp_start) / total_messages) << std::endl;
     std::cout << "ITCH message throughput: " << total_messages * 1000000000 / (timestamp_stop - timestamp_start) << " msg/s" << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Memory statistics: " << std::endl;
+    std::cout << "Order size: " << sizeof(Order) << " bytes" << std::endl;
+    std::cout << "Price level size: " << sizeof(Level) << " bytes" << std::endl;
+    std::cout << "Price level link size: " << sizeof(PriceLevel) << " bytes" << std::endl;
+
     return 0;
 }
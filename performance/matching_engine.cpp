@@ -58,6 +58,7 @@ protected:
     void onAddOrder(const Order& order) override { ++_updates; ++_orders; _max_orders = std::max(_orders, _max_orders); ++_add_orders; }
     void onUpdateOrder(const Order& order) override { ++_updates; ++_update_orders; }
     void onDeleteOrder(const Order& order) override { ++_updates; --_orders; ++_delete_orders; }
+    void onDeleteOrders(const OrderBook& order_book, size_t orders, uint64_t volume) override { ++_updates; }
     void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { ++_updates; ++_execute_orders; }
 
 private:
@@ -196,5 +197,13 @@ int main(int argc, char** argv)
     std::cout << "Delete order operations: " << market_handler.delete_orders() << std::endl;
     std::cout << "Execute order operations: " << market_handler.execute_orders() << std::endl;
 
+    std::cout << std::endl;
+
+    std::cout << "Memory statistics: " << std::endl;
+    std::cout << "Order size: " << sizeof(Order) << " bytes" << std::endl;
+    std::cout << "Order node size: " << sizeof(OrderNode) << " bytes" << std::endl;
+    std::cout << "Price level node size: " << sizeof(LevelNode) << " bytes" << std::endl;
+    std::cout << "Max orders memory: " << market_handler.max_orders() * sizeof(OrderNode) << " bytes" << std::endl;
+
     return 0;
 }
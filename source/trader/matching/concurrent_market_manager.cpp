@@ -0,0 +1,334 @@
+/*!
+    \file concurrent_market_manager.cpp
+    \brief Concurrent market manager implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/concurrent_market_manager.h"
+
+namespace CppTrader {
+namespace Matching {
+
+ConcurrentMarketManager::ConcurrentMarketManager(MarketHandler& market_handler, size_t symbols, size_t stripes)
+    : _market_handler(market_handler),
+      _router(*this),
+      _matching(false),
+      _symbols(symbols),
+      _books(new Book[symbols]),
+      _stripes_count(stripes),
+      _stripes(new Stripe[stripes])
+{
+    assert(((stripes > 0) && ((stripes & (stripes - 1)) == 0)) && "Order routes stripes count must be a power of two!");
+}
+
+ErrorCode ConcurrentMarketManager::AddOrderBook(const Symbol& symbol)
+{
+    assert((symbol.Id < _symbols) && "Symbol Id is out of the concurrent market manager capacity!");
+    if (symbol.Id >= _symbols)
+        return ErrorCode::SYMBOL_NOT_FOUND;
+
+    Book& book = _books[symbol.Id];
+    CppCommon::Locker<CppCommon::SpinLock> locker(book.Lock);
+
+    if (book.Manager)
+        return ErrorCode::ORDER_BOOK_DUPLICATE;
+
+    // Create the market manager of the order book
+    auto manager = std::make_unique<MarketManager>(_router);
+    ErrorCode result = manager->AddSymbol(symbol);
+    if (result != ErrorCode::OK)
+        return result;
+    result = manager->AddOrderBook(symbol);
+    if (result != ErrorCode::OK)
+        return result;
+    if (_matching.load(std::memory_order_acquire))
+        manager->EnableMatching();
+
+    book.Manager = std::move(manager);
+    return ErrorCode::OK;
+}
+
+ErrorCode ConcurrentMarketManager::DeleteOrderBook(uint32_t id)
+{
+    if (id >= _symbols)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    Book& book = _books[id];
+    CppCommon::Locker<CppCommon::SpinLock> locker(book.Lock);
+
+    if (!book.Manager)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Routes of deleted orders are erased by the router one by one
+    book.Manager->DeleteOrderBook(id);
+    book.Manager->DeleteSymbol(id);
+    book.Manager.reset();
+    return ErrorCode::OK;
+}
+
+ErrorCode ConcurrentMarketManager::AddOrder(const Order& order)
+{
+    assert((order.Id > 0) && "Order Id must be greater than zero!");
+    if (order.Id == 0)
+        return ErrorCode::ORDER_ID_INVALID;
+    if (order.SymbolId >= _symbols)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    Book& book = _books[order.SymbolId];
+    CppCommon::Locker<CppCommon::SpinLock> locker(book.Lock);
+
+    if (!book.Manager)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Reserve the order route to reject duplicate order Ids across all order books
+    if (!InsertRoute(order.Id, order.SymbolId))
+        return ErrorCode::ORDER_DUPLICATE;
+
+    ErrorCode result = book.Manager->AddOrder(order);
+
+    // Erase the route of the rejected order
+    if ((result != ErrorCode::OK) && (book.Manager->GetOrder(order.Id) == nullptr))
+        EraseRoute(order.Id);
+
+    return result;
+}
+
+ErrorCode ConcurrentMarketManager::ReduceOrder(uint64_t id, uint64_t quantity)
+{
+    return RouteOrder(id, [=](MarketManager& manager) { return manager.ReduceOrder(id, quantity); });
+}
+
+ErrorCode ConcurrentMarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
+{
+    return RouteOrder(id, [=](MarketManager& manager) { return manager.ModifyOrder(id, new_price, new_quantity); });
+}
+
+ErrorCode ConcurrentMarketManager::MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
+{
+    return RouteOrder(id, [=](MarketManager& manager) { return manager.MitigateOrder(id, new_price, new_quantity); });
+}
+
+ErrorCode ConcurrentMarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity)
+{
+    assert((new_id > 0) && "New order Id must be greater than zero!");
+    if (new_id == 0)
+        return ErrorCode::ORDER_ID_INVALID;
+
+    return RouteOrder(id, [this, id, new_id, new_price, new_quantity](MarketManager& manager)
+    {
+        const Order* order_ptr = manager.GetOrder(id);
+
+        // Reserve the new order route to reject duplicate order Ids across all order books
+        if ((new_id != id) && !InsertRoute(new_id, order_ptr->SymbolId))
+            return ErrorCode::ORDER_DUPLICATE;
+
+        ErrorCode result = manager.ReplaceOrder(id, new_id, new_price, new_quantity);
+
+        // Erase the new order route if the order was not replaced
+        if ((result != ErrorCode::OK) && (new_id != id) && (manager.GetOrder(new_id) == nullptr))
+            EraseRoute(new_id);
+
+        return result;
+    });
+}
+
+ErrorCode ConcurrentMarketManager::DeleteOrder(uint64_t id)
+{
+    return RouteOrder(id, [=](MarketManager& manager) { return manager.DeleteOrder(id); });
+}
+
+ErrorCode ConcurrentMarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
+{
+    return RouteOrder(id, [=](MarketManager& manager) { return manager.ExecuteOrder(id, quantity); });
+}
+
+ErrorCode ConcurrentMarketManager::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity)
+{
+    return RouteOrder(id, [=](MarketManager& manager) { return manager.ExecuteOrder(id, price, quantity); });
+}
+
+ErrorCode ConcurrentMarketManager::DeleteOrders(uint32_t id)
+{
+    if (id >= _symbols)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    Book& book = _books[id];
+    CppCommon::Locker<CppCommon::SpinLock> locker(book.Lock);
+
+    if (!book.Manager)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Routes of deleted orders are erased by the router one by one
+    return book.Manager->DeleteOrders(id);
+}
+
+ErrorCode ConcurrentMarketManager::DeleteOwnerOrders(uint32_t owner)
+{
+    assert((owner > 0) && "Order owner Id must be greater than zero!");
+    if (owner == 0)
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+
+    LockAll();
+
+    // Routes of deleted orders are erased by the router one by one
+    for (size_t i = 0; i < _symbols; ++i)
+        if (_books[i].Manager)
+            _books[i].Manager->DeleteOwnerOrders(owner);
+
+    UnlockAll();
+
+    return ErrorCode::OK;
+}
+
+void ConcurrentMarketManager::EnableMatching()
+{
+    LockAll();
+
+    _matching.store(true, std::memory_order_release);
+    for (size_t i = 0; i < _symbols; ++i)
+        if (_books[i].Manager)
+            _books[i].Manager->EnableMatching();
+
+    UnlockAll();
+}
+
+void ConcurrentMarketManager::DisableMatching()
+{
+    LockAll();
+
+    _matching.store(false, std::memory_order_release);
+    for (size_t i = 0; i < _symbols; ++i)
+        if (_books[i].Manager)
+            _books[i].Manager->DisableMatching();
+
+    UnlockAll();
+}
+
+bool ConcurrentMarketManager::FindRoute(uint64_t id, uint32_t& symbol)
+{
+    Stripe& stripe = GetStripe(id);
+    CppCommon::Locker<CppCommon::SpinLock> locker(stripe.Lock);
+
+    auto it = stripe.Routes.find(id);
+    if (it == stripe.Routes.end())
+        return false;
+
+    symbol = it->second;
+    return true;
+}
+
+bool ConcurrentMarketManager::InsertRoute(uint64_t id, uint32_t symbol)
+{
+    Stripe& stripe = GetStripe(id);
+    CppCommon::Locker<CppCommon::SpinLock> locker(stripe.Lock);
+
+    return stripe.Routes.insert(std::make_pair(id, symbol)).second;
+}
+
+void ConcurrentMarketManager::EraseRoute(uint64_t id)
+{
+    Stripe& stripe = GetStripe(id);
+    CppCommon::Locker<CppCommon::SpinLock> locker(stripe.Lock);
+
+    stripe.Routes.erase(id);
+}
+
+void ConcurrentMarketManager::LockAll() noexcept
+{
+    // Lock all order books in ascending symbol Id order
+    for (size_t i = 0; i < _symbols; ++i)
+        _books[i].Lock.Lock();
+}
+
+void ConcurrentMarketManager::UnlockAll() noexcept
+{
+    for (size_t i = _symbols; i-- > 0;)
+        _books[i].Lock.Unlock();
+}
+
+void ConcurrentMarketManager::Router::onAddSymbol(const Symbol& symbol)
+{
+    _manager._market_handler.onAddSymbol(symbol);
+}
+
+void ConcurrentMarketManager::Router::onDeleteSymbol(const Symbol& symbol)
+{
+    _manager._market_handler.onDeleteSymbol(symbol);
+}
+
+void ConcurrentMarketManager::Router::onAddOrderBook(const OrderBook& order_book)
+{
+    _manager._market_handler.onAddOrderBook(order_book);
+}
+
+void ConcurrentMarketManager::Router::onUpdateOrderBook(const OrderBook& order_book, bool top)
+{
+    _manager._market_handler.onUpdateOrderBook(order_book, top);
+}
+
+void ConcurrentMarketManager::Router::onDeleteOrderBook(const OrderBook& order_book)
+{
+    _manager._market_handler.onDeleteOrderBook(order_book);
+}
+
+void ConcurrentMarketManager::Router::onUpdateAuction(const OrderBook& order_book, const Auction& auction)
+{
+    _manager._market_handler.onUpdateAuction(order_book, auction);
+}
+
+void ConcurrentMarketManager::Router::onAddLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    _manager._market_handler.onAddLevel(order_book, level, top);
+}
+
+void ConcurrentMarketManager::Router::onUpdateLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    _manager._market_handler.onUpdateLevel(order_book, level, top);
+}
+
+void ConcurrentMarketManager::Router::onDeleteLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    _manager._market_handler.onDeleteLevel(order_book, level, top);
+}
+
+void ConcurrentMarketManager::Router::onAddOrder(const Order& order)
+{
+    _manager._market_handler.onAddOrder(order);
+}
+
+void ConcurrentMarketManager::Router::onUpdateOrder(const Order& order)
+{
+    _manager._market_handler.onUpdateOrder(order);
+}
+
+void ConcurrentMarketManager::Router::onReplaceOrder(const Order& old_order, const Order& order)
+{
+    // Order route is moved to the new order Id
+    if (old_order.Id != order.Id)
+        _manager.EraseRoute(old_order.Id);
+
+    _manager._market_handler.onReplaceOrder(old_order, order);
+}
+
+void ConcurrentMarketManager::Router::onDeleteOrder(const Order& order)
+{
+    // Deleted order is not routed any more
+    _manager.EraseRoute(order.Id);
+
+    _manager._market_handler.onDeleteOrder(order);
+}
+
+void ConcurrentMarketManager::Router::onDeleteOrders(const OrderBook& order_book, size_t orders, uint64_t volume)
+{
+    _manager._market_handler.onDeleteOrders(order_book, orders, volume);
+}
+
+void ConcurrentMarketManager::Router::onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity)
+{
+    _manager._market_handler.onExecuteOrder(order, price, quantity);
+}
+
+} // namespace Matching
+} // namespace CppTrader
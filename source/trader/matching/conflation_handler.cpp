@@ -0,0 +1,226 @@
+/*!
+    \file conflation_handler.cpp
+    \brief Conflation market handler implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/conflation_handler.h"
+
+#include "trader/matching/order_book.h"
+
+namespace CppTrader {
+namespace Matching {
+
+namespace {
+
+// Price levels hash map blank key
+const uint64_t BLANK = std::numeric_limits<uint64_t>::max();
+
+} // namespace
+
+ConflationHandler::ConflatedBook::ConflatedBook(uint32_t id)
+    : Id(id),
+      Published(false),
+      Deleted(false),
+      Dirty(false),
+      Bids(128, BLANK),
+      Asks(128, BLANK)
+{
+}
+
+ConflationHandler::ConflationHandler(uint64_t interval)
+    : _interval(interval),
+      _timestamp(0)
+{
+}
+
+size_t ConflationHandler::Flush()
+{
+    size_t count = 0;
+
+    for (uint32_t id : _dirty_books)
+    {
+        ConflatedBook& book = *_books[id];
+        count += FlushBook(book);
+
+        // Forget the deleted order book
+        if (book.Deleted)
+            _books[id].reset();
+    }
+    _dirty_books.clear();
+
+    return count;
+}
+
+size_t ConflationHandler::Flush(uint64_t timestamp)
+{
+    // Check the conflation interval
+    if ((timestamp - _timestamp) < _interval)
+        return 0;
+
+    _timestamp = timestamp;
+    return Flush();
+}
+
+void ConflationHandler::onAddOrderBook(const OrderBook& order_book)
+{
+    // Cancel the pending deletion of the order book with the same Id
+    ConflatedBook& book = GetBook(order_book.symbol().Id);
+    book.Deleted = false;
+    MarkDirty(book);
+}
+
+void ConflationHandler::onDeleteOrderBook(const OrderBook& order_book)
+{
+    ConflatedBook& book = GetBook(order_book.symbol().Id);
+    book.Deleted = true;
+    MarkDirty(book);
+}
+
+void ConflationHandler::onAddLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    UpdateLevel(order_book, level, true);
+}
+
+void ConflationHandler::onUpdateLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    UpdateLevel(order_book, level, true);
+}
+
+void ConflationHandler::onDeleteLevel(const OrderBook& order_book, const Level& level, bool top)
+{
+    UpdateLevel(order_book, level, false);
+}
+
+ConflationHandler::ConflatedBook& ConflationHandler::GetBook(uint32_t id)
+{
+    // Resize the order books container
+    if (_books.size() <= id)
+        _books.resize(id + 1);
+
+    if (!_books[id])
+        _books[id] = std::make_unique<ConflatedBook>(id);
+
+    return *_books[id];
+}
+
+void ConflationHandler::MarkDirty(ConflatedBook& book)
+{
+    if (!book.Dirty)
+    {
+        book.Dirty = true;
+        _dirty_books.push_back(book.Id);
+    }
+}
+
+void ConflationHandler::UpdateLevel(const OrderBook& order_book, const Level& level, bool exists)
+{
+    ConflatedBook& book = GetBook(order_book.symbol().Id);
+    Levels& levels = level.IsBid() ? book.Bids : book.Asks;
+
+    // Find or create the conflated price level
+    auto it = levels.find(level.Price);
+    if (it == levels.end())
+        it = levels.insert(std::make_pair(level.Price, ConflatedLevel{ false, 0, 0, 0, false, false, 0, 0, 0 })).first;
+
+    // Overwrite the current state of the price level
+    ConflatedLevel& conflated = it->second;
+    conflated.Exists = exists;
+    conflated.Volume = level.TotalVolume;
+    conflated.Visible = level.VisibleVolume;
+    conflated.Orders = level.Orders;
+
+    // Mark the price level and the order book as dirty
+    if (!conflated.Dirty)
+    {
+        conflated.Dirty = true;
+        book.DirtyLevels.emplace_back(level.IsBid(), level.Price);
+    }
+    MarkDirty(book);
+}
+
+size_t ConflationHandler::FlushBook(ConflatedBook& book)
+{
+    size_t count = 0;
+
+    MarketEvent event = {};
+    event.SymbolId = book.Id;
+
+    if (book.Deleted)
+    {
+        // Publish the order book deletion only if its addition was published
+        if (book.Published)
+        {
+            event.Type = MarketEventType::DELETE_ORDER_BOOK;
+            onConflatedEvent(event);
+            ++count;
+        }
+        return count;
+    }
+
+    if (!book.Published)
+    {
+        book.Published = true;
+        event.Type = MarketEventType::ADD_ORDER_BOOK;
+        onConflatedEvent(event);
+        ++count;
+    }
+
+    for (const auto& dirty : book.DirtyLevels)
+    {
+        Levels& levels = dirty.first ? book.Bids : book.Asks;
+        auto it = levels.find(dirty.second);
+        ConflatedLevel& conflated = it->second;
+        conflated.Dirty = false;
+
+        // Calculate the net change of the price level
+        if (conflated.Exists)
+        {
+            if (!conflated.Published)
+                event.Type = MarketEventType::ADD_LEVEL;
+            else if ((conflated.Volume != conflated.PublishedVolume) || (conflated.Visible != conflated.PublishedVisible) || (conflated.Orders != conflated.PublishedOrders))
+                event.Type = MarketEventType::UPDATE_LEVEL;
+            else
+                continue;
+        }
+        else
+        {
+            // Skip the price level which was added and deleted inside the interval
+            if (!conflated.Published)
+            {
+                levels.erase(dirty.second);
+                continue;
+            }
+            event.Type = MarketEventType::DELETE_LEVEL;
+        }
+
+        event.Side = dirty.first ? OrderSide::BUY : OrderSide::SELL;
+        event.Price = dirty.second;
+        event.Quantity = conflated.Volume;
+        event.Visible = conflated.Visible;
+        event.Value = conflated.Orders;
+        onConflatedEvent(event);
+        ++count;
+
+        // Update the published state of the price level
+        if (conflated.Exists)
+        {
+            conflated.Published = true;
+            conflated.PublishedVolume = conflated.Volume;
+            conflated.PublishedVisible = conflated.Visible;
+            conflated.PublishedOrders = conflated.Orders;
+        }
+        else
+            levels.erase(dirty.second);
+    }
+
+    book.DirtyLevels.clear();
+    book.Dirty = false;
+
+    return count;
+}
+
+} // namespace Matching
+} // namespace CppTrader
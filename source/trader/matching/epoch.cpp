@@ -0,0 +1,79 @@
+/*!
+    \file epoch.cpp
+    \brief Epoch-based reclamation implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/epoch.h"
+
+namespace CppTrader {
+namespace Matching {
+
+EpochManager::EpochManager(size_t readers)
+    : _epoch(1),
+      _readers(readers),
+      _slots(new Slot[readers])
+{
+    for (size_t i = 0; i < _readers; ++i)
+    {
+        _slots[i].Epoch.store(0, std::memory_order_relaxed);
+        _slots[i].Registered.store(false, std::memory_order_relaxed);
+    }
+}
+
+size_t EpochManager::RegisterReader() noexcept
+{
+    // Find and capture the free reader slot
+    for (size_t i = 0; i < _readers; ++i)
+    {
+        bool registered = false;
+        if (_slots[i].Registered.compare_exchange_strong(registered, true, std::memory_order_acq_rel))
+            return i;
+    }
+    return INVALID_READER;
+}
+
+void EpochManager::UnregisterReader(size_t reader) noexcept
+{
+    assert((reader < _readers) && _slots[reader].Registered.load(std::memory_order_relaxed) && "Reader is not registered!");
+    if (reader >= _readers)
+        return;
+
+    _slots[reader].Epoch.store(0, std::memory_order_release);
+    _slots[reader].Registered.store(false, std::memory_order_release);
+}
+
+uint64_t EpochManager::Synchronize() noexcept
+{
+    // Order all previous node unlinks before the scan of reader epochs
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint64_t epoch = _epoch.load(std::memory_order_relaxed);
+    uint64_t oldest = epoch;
+    bool active = false;
+    for (size_t i = 0; i < _readers; ++i)
+    {
+        uint64_t observed = _slots[i].Epoch.load(std::memory_order_acquire);
+        if (observed != 0)
+        {
+            active = true;
+            if (observed < oldest)
+                oldest = observed;
+        }
+    }
+
+    // Advance the global epoch if all active readers have observed the current one
+    if (oldest == epoch)
+        _epoch.store(epoch + 1, std::memory_order_release);
+
+    // Without active readers all retired nodes are unreachable
+    if (!active)
+        return epoch + 1;
+
+    return oldest;
+}
+
+} // namespace Matching
+} // namespace CppTrader
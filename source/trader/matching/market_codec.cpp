@@ -0,0 +1,396 @@
+/*!
+    \file market_codec.cpp
+    \brief Market binary codec implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_codec.h"
+
+#include <cassert>
+
+namespace CppTrader {
+namespace Matching {
+
+namespace {
+
+// Market event header byte layout
+const uint8_t TYPE_MASK = 0x1F;
+const uint8_t SELL_FLAG = 0x20;
+const uint8_t TOP_FLAG = 0x40;
+const uint8_t SYMBOL_FLAG = 0x80;
+
+static_assert((uint8_t)MarketEventType::UPDATE_AUCTION <= TYPE_MASK, "Market event type must fit into the header byte!");
+
+// Market event fields
+const uint8_t FIELD_ID = 0x01;
+const uint8_t FIELD_PRICE = 0x02;
+const uint8_t FIELD_QUANTITY = 0x04;
+const uint8_t FIELD_HIDDEN = 0x08;
+const uint8_t FIELD_VALUE = 0x10;
+const uint8_t FIELD_VALUE_DELTA = 0x20;
+
+uint8_t Fields(MarketEventType type) noexcept
+{
+    switch (type)
+    {
+        case MarketEventType::ADD_LEVEL:
+        case MarketEventType::UPDATE_LEVEL:
+        case MarketEventType::DELETE_LEVEL:
+        case MarketEventType::SNAPSHOT_LEVEL:
+            return FIELD_PRICE | FIELD_QUANTITY | FIELD_HIDDEN | FIELD_VALUE;
+        case MarketEventType::ADD_ORDER:
+        case MarketEventType::UPDATE_ORDER:
+        case MarketEventType::DELETE_ORDER:
+        case MarketEventType::SNAPSHOT_ORDER:
+            return FIELD_ID | FIELD_PRICE | FIELD_QUANTITY | FIELD_HIDDEN | FIELD_VALUE;
+        case MarketEventType::REPLACE_ORDER:
+            return FIELD_ID | FIELD_PRICE | FIELD_QUANTITY | FIELD_HIDDEN | FIELD_VALUE_DELTA;
+        case MarketEventType::EXECUTE_ORDER:
+            return FIELD_ID | FIELD_PRICE | FIELD_QUANTITY | FIELD_VALUE;
+        case MarketEventType::DELETE_ORDERS:
+            return FIELD_QUANTITY | FIELD_VALUE;
+        case MarketEventType::SNAPSHOT_BEGIN:
+        case MarketEventType::SNAPSHOT_BOOK:
+        case MarketEventType::ADD_SYMBOL:
+        case MarketEventType::DELETE_SYMBOL:
+            return FIELD_VALUE;
+        case MarketEventType::UPDATE_AUCTION:
+            // Executable volume never exceeds the bid volume, so the bid volume is encoded as the hidden delta
+            return FIELD_PRICE | FIELD_QUANTITY | FIELD_HIDDEN | FIELD_VALUE;
+        default:
+            return 0;
+    }
+}
+
+uint8_t* WriteVarint(uint8_t* buffer, uint64_t value) noexcept
+{
+    while (value >= 0x80)
+    {
+        *buffer++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *buffer++ = (uint8_t)value;
+    return buffer;
+}
+
+uint8_t* WriteDelta(uint8_t* buffer, uint64_t value, uint64_t previous) noexcept
+{
+    // Zigzag encoding of the signed delta
+    int64_t delta = (int64_t)(value - previous);
+    return WriteVarint(buffer, ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+}
+
+size_t VarintSize(uint64_t value) noexcept
+{
+    size_t size = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+bool ReadVarint(const uint8_t*& buffer, const uint8_t* end, uint64_t& value) noexcept
+{
+    value = 0;
+    for (size_t shift = 0; (buffer < end) && (shift < 64); shift += 7)
+    {
+        uint8_t byte = *buffer++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool ReadDelta(const uint8_t*& buffer, const uint8_t* end, uint64_t& value, uint64_t previous) noexcept
+{
+    uint64_t zigzag;
+    if (!ReadVarint(buffer, end, zigzag))
+        return false;
+    value = previous + ((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+    return true;
+}
+
+} // namespace
+
+MarketEncoder::MarketEncoder(size_t frame_size)
+    : _buffer(MAX_HEADER_SIZE + frame_size + MAX_EVENT_SIZE),
+      _size(MAX_HEADER_SIZE),
+      _frame_size(frame_size),
+      _sequence(0),
+      _count(0),
+      _bytes(0),
+      _symbol(0),
+      _id(0),
+      _price(0)
+{
+}
+
+void MarketEncoder::Encode(const MarketEvent& event)
+{
+    uint8_t fields = Fields(event.Type);
+
+    uint8_t* start = _buffer.data() + _size;
+    uint8_t* buffer = start + 1;
+
+    // Prepare the market event header byte
+    uint8_t header = (uint8_t)event.Type & TYPE_MASK;
+    if (event.Side == OrderSide::SELL)
+        header |= SELL_FLAG;
+    if (event.Top)
+        header |= TOP_FLAG;
+    if (event.SymbolId != _symbol)
+    {
+        header |= SYMBOL_FLAG;
+        buffer = WriteDelta(buffer, event.SymbolId, _symbol);
+        _symbol = event.SymbolId;
+    }
+    *start = header;
+
+    // Encode market event fields
+    if (fields & FIELD_ID)
+    {
+        buffer = WriteDelta(buffer, event.Id, _id);
+        _id = event.Id;
+    }
+    if (fields & FIELD_PRICE)
+    {
+        buffer = WriteDelta(buffer, event.Price, _price);
+        _price = event.Price;
+    }
+    if (fields & FIELD_QUANTITY)
+        buffer = WriteVarint(buffer, event.Quantity);
+    if (fields & FIELD_HIDDEN)
+        buffer = WriteDelta(buffer, event.Quantity, event.Visible);
+    if (fields & FIELD_VALUE)
+        buffer = WriteVarint(buffer, event.Value);
+    if (fields & FIELD_VALUE_DELTA)
+        buffer = WriteDelta(buffer, event.Value, event.Id);
+
+    _size = buffer - _buffer.data();
+    ++_count;
+
+    // Flush the full frame
+    if ((_size - MAX_HEADER_SIZE) >= _frame_size)
+        Flush();
+}
+
+void MarketEncoder::Flush()
+{
+    if (_count == 0)
+        return;
+
+    // Write the frame header right before the payload
+    size_t payload = _size - MAX_HEADER_SIZE;
+    size_t header = VarintSize(_sequence) + VarintSize(_count) + VarintSize(payload);
+    uint8_t* frame = _buffer.data() + MAX_HEADER_SIZE - header;
+    uint8_t* buffer = WriteVarint(frame, _sequence);
+    buffer = WriteVarint(buffer, _count);
+    WriteVarint(buffer, payload);
+
+    onEncodedFrame(frame, header + payload);
+
+    // Start the new frame with the reset delta state
+    _bytes += header + payload;
+    _sequence += _count;
+    _count = 0;
+    _size = MAX_HEADER_SIZE;
+    _symbol = 0;
+    _id = 0;
+    _price = 0;
+}
+
+MarketDecoder::MarketDecoder()
+    : _sequence(0),
+      _gaps(0)
+{
+}
+
+size_t MarketDecoder::Decode(const void* buffer, size_t size)
+{
+    const uint8_t* start = (const uint8_t*)buffer;
+    const uint8_t* end = start + size;
+    const uint8_t* current = start;
+
+    while (current < end)
+    {
+        // Decode the frame header
+        const uint8_t* frame = current;
+        uint64_t sequence, count, payload;
+        if (!ReadVarint(frame, end, sequence) || !ReadVarint(frame, end, count) || !ReadVarint(frame, end, payload))
+            break;
+
+        // Check for the incomplete frame
+        if ((uint64_t)(end - frame) < payload)
+            break;
+
+        // Check for the sequence gap
+        if (sequence != _sequence)
+            ++_gaps;
+        _sequence = sequence;
+
+        DecodeFrame(frame, (size_t)payload, count);
+        current = frame + payload;
+    }
+
+    return current - start;
+}
+
+void MarketDecoder::DecodeFrame(const uint8_t* buffer, size_t size, uint64_t count)
+{
+    const uint8_t* end = buffer + size;
+
+    // Reset the delta state of the frame
+    uint64_t symbol = 0;
+    uint64_t id = 0;
+    uint64_t price = 0;
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        assert((buffer < end) && "Invalid market event frame!");
+        if (buffer >= end)
+            return;
+
+        uint8_t header = *buffer++;
+
+        MarketEvent event = {};
+        event.Type = (MarketEventType)(header & TYPE_MASK);
+        event.Side = (header & SELL_FLAG) ? OrderSide::SELL : OrderSide::BUY;
+        event.Top = (header & TOP_FLAG) != 0;
+
+        // Decode market event fields
+        uint8_t fields = Fields(event.Type);
+        uint64_t hidden = 0;
+        bool valid = true;
+        if (header & SYMBOL_FLAG)
+            valid = valid && ReadDelta(buffer, end, symbol, symbol);
+        if (fields & FIELD_ID)
+            valid = valid && ReadDelta(buffer, end, id, id);
+        if (fields & FIELD_PRICE)
+            valid = valid && ReadDelta(buffer, end, price, price);
+        if (fields & FIELD_QUANTITY)
+            valid = valid && ReadVarint(buffer, end, event.Quantity);
+        if (fields & FIELD_HIDDEN)
+            valid = valid && ReadDelta(buffer, end, hidden, 0);
+        if (fields & FIELD_VALUE)
+            valid = valid && ReadVarint(buffer, end, event.Value);
+        if (fields & FIELD_VALUE_DELTA)
+            valid = valid && ReadDelta(buffer, end, event.Value, id);
+        assert(valid && "Invalid market event frame!");
+        if (!valid)
+            return;
+
+        event.SymbolId = (uint32_t)symbol;
+        if (fields & FIELD_ID)
+            event.Id = id;
+        if (fields & FIELD_PRICE)
+            event.Price = price;
+        if (fields & FIELD_HIDDEN)
+            event.Visible = event.Quantity - hidden;
+
+        ++_sequence;
+        Apply(event);
+        onDecodedEvent(event);
+    }
+}
+
+void MarketDecoder::Apply(const MarketEvent& event)
+{
+    switch (event.Type)
+    {
+        case MarketEventType::ADD_ORDER_BOOK:
+            GetOrCreateOrderBook(event.SymbolId);
+            break;
+        case MarketEventType::DELETE_ORDER_BOOK:
+            if (event.SymbolId < _order_books.size())
+                _order_books[event.SymbolId].reset();
+            break;
+        case MarketEventType::ADD_LEVEL:
+        case MarketEventType::UPDATE_LEVEL:
+        case MarketEventType::SNAPSHOT_LEVEL:
+        {
+            DecodedOrderBook& order_book = GetOrCreateOrderBook(event.SymbolId);
+            DecodedLevel level = { event.Quantity, event.Visible, event.Value };
+            if (event.Side == OrderSide::BUY)
+                order_book.Bids[event.Price] = level;
+            else
+                order_book.Asks[event.Price] = level;
+            break;
+        }
+        case MarketEventType::DELETE_LEVEL:
+        {
+            DecodedOrderBook& order_book = GetOrCreateOrderBook(event.SymbolId);
+            if (event.Side == OrderSide::BUY)
+                order_book.Bids.erase(event.Price);
+            else
+                order_book.Asks.erase(event.Price);
+            break;
+        }
+        case MarketEventType::ADD_ORDER:
+        case MarketEventType::UPDATE_ORDER:
+        case MarketEventType::SNAPSHOT_ORDER:
+        {
+            DecodedOrderBook& order_book = GetOrCreateOrderBook(event.SymbolId);
+            order_book.Orders[event.Id] = DecodedOrder{ event.Side, event.Price, event.Quantity, event.Visible };
+            break;
+        }
+        case MarketEventType::REPLACE_ORDER:
+        {
+            DecodedOrderBook& order_book = GetOrCreateOrderBook(event.SymbolId);
+            order_book.Orders.erase(event.Value);
+            order_book.Orders[event.Id] = DecodedOrder{ event.Side, event.Price, event.Quantity, event.Visible };
+            break;
+        }
+        case MarketEventType::DELETE_ORDER:
+        {
+            DecodedOrderBook& order_book = GetOrCreateOrderBook(event.SymbolId);
+            order_book.Orders.erase(event.Id);
+            break;
+        }
+        case MarketEventType::DELETE_ORDERS:
+        {
+            // Orders of the mass cancel are already deleted one by one
+            break;
+        }
+        case MarketEventType::SNAPSHOT_BOOK:
+        {
+            // Snapshot replaces all price levels and orders of the order book
+            DecodedOrderBook& order_book = GetOrCreateOrderBook(event.SymbolId);
+            order_book.Bids.clear();
+            order_book.Asks.clear();
+            order_book.Orders.clear();
+            order_book.Auction = {};
+            break;
+        }
+        case MarketEventType::UPDATE_AUCTION:
+        {
+            DecodedOrderBook& order_book = GetOrCreateOrderBook(event.SymbolId);
+            order_book.Auction = DecodedAuction{ event.Price, event.Quantity, event.Visible, event.Value };
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+DecodedOrderBook& MarketDecoder::GetOrCreateOrderBook(uint32_t id)
+{
+    // Resize the order books container
+    if (_order_books.size() <= id)
+        _order_books.resize(id + 1);
+
+    if (!_order_books[id])
+    {
+        _order_books[id] = std::make_unique<DecodedOrderBook>();
+        _order_books[id]->Id = id;
+    }
+
+    return *_order_books[id];
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,119 @@
+/*!
+    \file market_command_queue.cpp
+    \brief Market command queue implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_command_queue.h"
+
+namespace CppTrader {
+namespace Matching {
+
+MarketCommandQueue::MarketCommandQueue(size_t capacity, size_t producers, size_t completions, size_t batch)
+    : _capacity(capacity),
+      _slots(new Slot[capacity]),
+      _producers_count(producers),
+      _completions(completions),
+      _producers(new Producer[producers]),
+      _batch(batch),
+      _enqueue(0),
+      _dequeue(0)
+{
+    assert(((capacity > 0) && ((capacity & (capacity - 1)) == 0)) && "Market command queue capacity must be a power of two!");
+    assert(((completions > 0) && ((completions & (completions - 1)) == 0)) && "Market completion ring capacity must be a power of two!");
+    assert((batch > 0) && "Market command batch size must be greater than zero!");
+
+    for (size_t i = 0; i < _capacity; ++i)
+        _slots[i].Sequence.store(i, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < _producers_count; ++i)
+    {
+        _producers[i].Submitted = 0;
+        _producers[i].Tail.store(0, std::memory_order_relaxed);
+        _producers[i].Head.store(0, std::memory_order_relaxed);
+        _producers[i].Completions.reset(new MarketCompletion[_completions]);
+    }
+}
+
+size_t MarketCommandQueue::Drain(MarketManager& market, size_t limit)
+{
+    if (limit > _batch.size())
+        limit = _batch.size();
+
+    // Dequeue the batch of commands
+    size_t count = 0;
+    while ((count < limit) && TryDequeue(_batch[count]))
+        ++count;
+
+    // Prefetch order nodes of the whole batch
+    for (size_t i = 0; i < count; ++i)
+        if ((_batch[i].Type != MarketCommandType::ADD_ORDER) && (_batch[i].Id != 0))
+            market.PrefetchOrder(_batch[i].Id);
+
+    // Apply commands and complete them
+    for (size_t i = 0; i < count; ++i)
+    {
+        const MarketCommand& command = _batch[i];
+
+        MarketCompletion completion;
+        completion.Tag = command.Tag;
+        completion.Id = command.Id;
+        completion.Type = command.Type;
+        completion.Result = Apply(market, command);
+
+        Producer& owner = _producers[command.Producer];
+        uint64_t head = owner.Head.load(std::memory_order_relaxed);
+        owner.Completions[head & (_completions - 1)] = completion;
+        owner.Head.store(head + 1, std::memory_order_release);
+    }
+
+    return count;
+}
+
+ErrorCode MarketCommandQueue::Apply(MarketManager& market, const MarketCommand& command)
+{
+    // Validate the command before the market manager asserts
+    if (command.Type == MarketCommandType::ADD_ORDER)
+    {
+        if (command.NewOrder.Id == 0)
+            return ErrorCode::ORDER_ID_INVALID;
+        if (market.GetOrderBook(command.NewOrder.SymbolId) == nullptr)
+            return ErrorCode::ORDER_BOOK_NOT_FOUND;
+        if (market.GetOrder(command.NewOrder.Id) != nullptr)
+            return ErrorCode::ORDER_DUPLICATE;
+        return market.AddOrder(command.NewOrder);
+    }
+
+    // Validate the order Id, missing orders are reported by the market manager
+    if (command.Id == 0)
+        return ErrorCode::ORDER_ID_INVALID;
+
+    switch (command.Type)
+    {
+        case MarketCommandType::REDUCE_ORDER:
+            return market.ReduceOrder(command.Id, command.Quantity);
+        case MarketCommandType::MODIFY_ORDER:
+            return market.ModifyOrder(command.Id, command.Price, command.Quantity);
+        case MarketCommandType::MITIGATE_ORDER:
+            return market.MitigateOrder(command.Id, command.Price, command.Quantity);
+        case MarketCommandType::REPLACE_ORDER:
+            if (command.NewId == 0)
+                return ErrorCode::ORDER_ID_INVALID;
+            if ((command.NewId != command.Id) && (market.GetOrder(command.NewId) != nullptr))
+                return ErrorCode::ORDER_DUPLICATE;
+            return market.ReplaceOrder(command.Id, command.NewId, command.Price, command.Quantity);
+        case MarketCommandType::DELETE_ORDER:
+            return market.DeleteOrder(command.Id);
+        case MarketCommandType::EXECUTE_ORDER:
+            if (command.Price == 0)
+                return market.ExecuteOrder(command.Id, command.Quantity);
+            return market.ExecuteOrder(command.Id, command.Price, command.Quantity);
+        default:
+            return ErrorCode::ORDER_PARAMETER_INVALID;
+    }
+}
+
+} // namespace Matching
+} // namespace CppTrader
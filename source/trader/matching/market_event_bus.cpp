@@ -0,0 +1,46 @@
+/*!
+    \file market_event_bus.cpp
+    \brief Market event bus implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_event_bus.h"
+
+#include <cassert>
+
+namespace CppTrader {
+namespace Matching {
+
+MarketEventBusConsumer::MarketEventBusConsumer(const MarketEventBus& bus, const std::vector<const MarketEventBusConsumer*>& dependencies)
+    : _sequence(bus._sequence),
+      _bus(bus),
+      _dependencies(dependencies)
+{
+}
+
+MarketEventBus::MarketEventBus(size_t capacity)
+    : _events(capacity),
+      _mask(capacity - 1),
+      _sequence(0),
+      _gating(0),
+      _published(0)
+{
+    assert(((capacity > 0) && ((capacity & (capacity - 1)) == 0)) && "Market event bus capacity must be a power of two!");
+}
+
+MarketEventBusConsumer& MarketEventBus::AddConsumer(const std::vector<const MarketEventBusConsumer*>& dependencies)
+{
+    // Consumers should be added before publishing
+    assert((_sequence == 0) && "Market event bus consumers should be added before the first market event is published!");
+
+    for ([[maybe_unused]] auto dependency : dependencies)
+        assert(((dependency != nullptr) && (&dependency->_bus == this)) && "Consumer dependency must belong to the same market event bus!");
+
+    _consumers.emplace_back(new MarketEventBusConsumer(*this, dependencies));
+    return *_consumers.back();
+}
+
+} // namespace Matching
+} // namespace CppTrader
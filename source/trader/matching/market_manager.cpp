@@ -11,10 +11,75 @@
 namespace CppTrader {
 namespace Matching {
 
+namespace {
+
+// Calculate (a * b) / c and its remainder without the intermediate overflow (a must not be greater than c)
+uint64_t MulDiv(uint64_t a, uint64_t b, uint64_t c, uint64_t& remainder) noexcept
+{
+    assert((a <= c) && "Multiplier must not be greater than the divisor!");
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    remainder = (uint64_t)(product % c);
+    return (uint64_t)(product / c);
+#else
+    if (a == c)
+    {
+        remainder = 0;
+        return b;
+    }
+
+    // Binary long multiplication modulo c
+    uint64_t quotient = 0;
+    uint64_t rest = 0;
+    for (int bit = 63; bit >= 0; --bit)
+    {
+        // Double the quotient and the remainder
+        quotient <<= 1;
+        if (rest >= (c - rest))
+        {
+            rest -= (c - rest);
+            quotient += 1;
+        }
+        else
+            rest <<= 1;
+
+        // Add the multiplier
+        if ((b >> bit) & 1)
+        {
+            if (rest >= (c - a))
+            {
+                rest -= (c - a);
+                quotient += 1;
+            }
+            else
+                rest += a;
+        }
+    }
+    remainder = rest;
+    return quotient;
+#endif
+}
+
+} // namespace
+
 MarketHandler MarketManager::_default;
 
 MarketManager::~MarketManager()
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    // Recycle all retired nodes, reader threads must be stopped here
+    for (const auto& retired : _retired_orders)
+        _order_pool.Release(retired.second);
+    _retired_orders.clear();
+    for (const auto& retired : _retired_order_books)
+        _order_book_pool.Release(retired.second);
+    _retired_order_books.clear();
+    for (const auto& retired : _retired_levels)
+        _level_pool.Release(retired.second);
+    _retired_levels.clear();
+
     // Release orders
     for (const auto& order : _orders)
         _order_pool.Release(order.second);
@@ -35,6 +100,9 @@ MarketManager::~MarketManager()
 
 ErrorCode MarketManager::AddSymbol(const Symbol& symbol)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     // Resize the symbol container
     if (_symbols.size() <= symbol.Id)
         _symbols.resize(symbol.Id + 1, nullptr);
@@ -60,6 +128,9 @@ ErrorCode MarketManager::AddSymbol(const Symbol& symbol)
 
 ErrorCode MarketManager::DeleteSymbol(uint32_t id)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     assert(((id < _symbols.size()) && (_symbols[id] != nullptr)) && "Symbol not found!");
     if ((_symbols.size() <= id) || (_symbols[id] == nullptr))
         return ErrorCode::SYMBOL_NOT_FOUND;
@@ -81,6 +152,9 @@ ErrorCode MarketManager::DeleteSymbol(uint32_t id)
 
 ErrorCode MarketManager::AddOrderBook(const Symbol& symbol)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     assert(((symbol.Id < _symbols.size()) && (_symbols[symbol.Id] != nullptr)) && "Symbol not found!");
     if ((_symbols.size() <= symbol.Id) || (_symbols[symbol.Id] == nullptr))
         return ErrorCode::SYMBOL_NOT_FOUND;
@@ -113,6 +187,9 @@ ErrorCode MarketManager::AddOrderBook(const Symbol& symbol)
 
 ErrorCode MarketManager::DeleteOrderBook(uint32_t id)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
     if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
@@ -120,6 +197,9 @@ ErrorCode MarketManager::DeleteOrderBook(uint32_t id)
     // Get the order book by Id
     OrderBook* order_book_ptr = _order_books[id];
 
+    // Delete all orders of the order book
+    DeleteOrders(order_book_ptr, true, true, 0, std::numeric_limits<price_t>::max());
+
     // Call the corresponding handler
     _market_handler.onDeleteOrderBook(*order_book_ptr);
 
@@ -127,31 +207,288 @@ ErrorCode MarketManager::DeleteOrderBook(uint32_t id)
     _order_books[id] = nullptr;
 
     // Release the order book
-    _order_book_pool.Release(order_book_ptr);
+    ReleaseOrderBook(order_book_ptr);
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::EnableOrderBookDepth(uint32_t id, size_t levels)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+    assert((levels > 0) && "Order book depth must be greater than zero!");
+    if (levels == 0)
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+
+    // Enable the order book depth
+    _order_books[id]->EnableDepth(levels);
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::DisableOrderBookDepth(uint32_t id)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Disable the order book depth
+    _order_books[id]->DisableDepth();
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::EnableOrderBookBBO(uint32_t id)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Enable the order book best bid and offer block
+    _order_books[id]->EnableBBO();
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::SetOrderBookAllocation(uint32_t id, const Allocation& allocation)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Set the order book allocation policy
+    _order_books[id]->_allocation = allocation;
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::EnableOrderBookAuction(uint32_t id)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    OrderBook* order_book_ptr = _order_books[id];
+
+    // Call and batch auction modes are exclusive
+    if (order_book_ptr->IsBatch())
+        return ErrorCode::ORDER_BOOK_MODE_INVALID;
+
+    // Enable the order book call auction mode
+    order_book_ptr->_auction = true;
+
+    // Call the corresponding handler
+    _market_handler.onUpdateAuction(*order_book_ptr, order_book_ptr->GetAuction());
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::UncrossOrderBook(uint32_t id)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    OrderBook* order_book_ptr = _order_books[id];
+
+    // Disable the order book call auction mode
+    order_book_ptr->_auction = false;
+
+    // Uncross the order book at the equilibrium price
+    Uncross(order_book_ptr);
+
+    // Automatic order matching
+    if (IsAutomaticMatching(order_book_ptr))
+        Match(order_book_ptr);
+
+    // Reset matching price
+    order_book_ptr->ResetMatchingPrice();
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::EnableOrderBookBatch(uint32_t id)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    OrderBook* order_book_ptr = _order_books[id];
+
+    // Call and batch auction modes are exclusive
+    if (order_book_ptr->IsAuction())
+        return ErrorCode::ORDER_BOOK_MODE_INVALID;
+
+    // Enable the order book batch auction mode
+    order_book_ptr->_batch = true;
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::DisableOrderBookBatch(uint32_t id)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    OrderBook* order_book_ptr = _order_books[id];
+
+    // Match the current batch
+    MatchOrderBookBatch(id);
+
+    // Disable the order book batch auction mode
+    order_book_ptr->_batch = false;
+
+    // Automatic order matching
+    if (IsAutomaticMatching(order_book_ptr))
+        Match(order_book_ptr);
+
+    // Reset matching price
+    order_book_ptr->ResetMatchingPrice();
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::MatchOrderBookBatch(uint32_t id)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    OrderBook* order_book_ptr = _order_books[id];
+    auto& ioc_orders = order_book_ptr->_batch_ioc_orders;
+
+    // Add all orders of the current batch into the order book without matching
+    OrderNode* order_ptr;
+    while ((order_ptr = order_book_ptr->_batch_orders.pop_front()) != nullptr)
+    {
+        // Remember 'Immediate-Or-Cancel' orders to delete their remaining parts after the uncross
+        if (order_ptr->IsIOC())
+            ioc_orders.push_back(order_ptr->Id);
+
+        // Add the order into the order book
+        UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr));
+    }
+
+    // Uncross the order book at the clearing price
+    Uncross(order_book_ptr);
+
+    // Delete remaining parts of 'Immediate-Or-Cancel' orders
+    for (auto ioc_id : ioc_orders)
+        if (_orders.find(ioc_id) != _orders.end())
+            DeleteOrder(ioc_id, true);
+    ioc_orders.clear();
+
+    // Activate stop orders reached by the clearing price
+    ActivateStopOrders(order_book_ptr);
+
+    // Reset matching price
+    order_book_ptr->ResetMatchingPrice();
 
     return ErrorCode::OK;
 }
 
 ErrorCode MarketManager::AddOrder(const Order& order)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     // Validate order parameters
     ErrorCode result = order.Validate();
     if (result != ErrorCode::OK)
         return result;
 
+    // Accept the limit order into the current batch of the order book
+    OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order.SymbolId);
+    if ((order_book_ptr != nullptr) && order_book_ptr->IsBatch())
+    {
+        // Market orders could not be priced by the batch auction
+        if (order.IsMarket())
+            return ErrorCode::ORDER_TYPE_INVALID;
+
+        if (order.IsLimit())
+            return AddBatchOrder(order_book_ptr, order);
+    }
+
+    return AddOrder(order, false);
+}
+
+ErrorCode MarketManager::AddBatchOrder(OrderBook* order_book_ptr, const Order& order)
+{
+    // 'Fill-Or-Kill'/'All-Or-None' orders could not be partially filled by the batch auction
+    if (order.IsFOK() || order.IsAON())
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+
+    // Call the corresponding handler
+    _market_handler.onAddOrder(order);
+
+    // Create a new order
+    OrderNode* order_ptr = _order_pool.Create(order);
+
+    // Insert the order
+    if (!_orders.insert(std::make_pair(order_ptr->Id, order_ptr)).second)
+    {
+        // Call the corresponding handler
+        _market_handler.onDeleteOrder(*order_ptr);
+
+        // Release the order
+        _order_pool.Release(order_ptr);
+
+        return ErrorCode::ORDER_DUPLICATE;
+    }
+
+    // Index the order by its owner
+    AddOwnerOrder(order_ptr);
+
+    // Append the new order to the current batch
+    order_book_ptr->_batch_orders.push_back(*order_ptr);
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::AddOrder(const Order& order, bool recursive)
+{
     // Add the corresponding order type
     switch (order.Type)
     {
         case OrderType::MARKET:
-            return AddMarketOrder(order, false);
+            return AddMarketOrder(order, recursive);
         case OrderType::LIMIT:
-            return AddLimitOrder(order, false);
+            return AddLimitOrder(order, recursive);
         case OrderType::STOP:
         case OrderType::TRAILING_STOP:
-            return AddStopOrder(order, false);
+            return AddStopOrder(order, recursive);
         case OrderType::STOP_LIMIT:
         case OrderType::TRAILING_STOP_LIMIT:
-            return AddStopLimitOrder(order, false);
+            return AddStopLimitOrder(order, recursive);
         default:
             return ErrorCode::ORDER_TYPE_INVALID;
     }
@@ -170,14 +507,14 @@ ErrorCode MarketManager::AddMarketOrder(const Order& order, bool recursive)
     _market_handler.onAddOrder(new_order);
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         MatchMarket(order_book_ptr, &new_order);
 
     // Call the corresponding handler
     _market_handler.onDeleteOrder(new_order);
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         Match(order_book_ptr);
 
     // Reset matching price
@@ -199,7 +536,7 @@ ErrorCode MarketManager::AddLimitOrder(const Order& order, bool recursive)
     _market_handler.onAddOrder(new_order);
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         MatchLimit(order_book_ptr, &new_order);
 
     // Add a new order or delete remaining part in case of 'Immediate-Or-Cancel'/'Fill-Or-Kill' order
@@ -220,6 +557,9 @@ ErrorCode MarketManager::AddLimitOrder(const Order& order, bool recursive)
             return ErrorCode::ORDER_DUPLICATE;
         }
 
+        // Index the order by its owner
+        AddOwnerOrder(order_ptr);
+
         // Add the new limit order into the order book
         UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr));
     }
@@ -230,7 +570,7 @@ ErrorCode MarketManager::AddLimitOrder(const Order& order, bool recursive)
     }
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         Match(order_book_ptr);
 
     // Reset matching price
@@ -256,10 +596,10 @@ ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
     _market_handler.onAddOrder(new_order);
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
     {
         // Find the price to match the stop order
-        uint64_t stop_price = new_order.IsBuy() ? order_book_ptr->GetMarketPriceAsk() : order_book_ptr->GetMarketPriceBid();
+        price_t stop_price = new_order.IsBuy() ? order_book_ptr->GetMarketPriceAsk() : order_book_ptr->GetMarketPriceBid();
 
         // Check the arbitrage bid/ask prices
         bool arbitrage = new_order.IsBuy() ? (new_order.StopPrice <= stop_price) : (new_order.StopPrice >= stop_price);
@@ -281,7 +621,7 @@ ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
             _market_handler.onDeleteOrder(new_order);
 
             // Automatic order matching
-            if (_matching && !recursive)
+            if (IsAutomaticMatching(order_book_ptr) && !recursive)
                 Match(order_book_ptr);
 
             // Reset matching price
@@ -309,6 +649,9 @@ ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
             return ErrorCode::ORDER_DUPLICATE;
         }
 
+        // Index the order by its owner
+        AddOwnerOrder(order_ptr);
+
         // Add the new stop order into the order book
         if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
             order_book_ptr->AddTrailingStopOrder(order_ptr);
@@ -322,7 +665,7 @@ ErrorCode MarketManager::AddStopOrder(const Order& order, bool recursive)
     }
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         Match(order_book_ptr);
 
     // Reset matching price
@@ -352,10 +695,10 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
     _market_handler.onAddOrder(new_order);
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
     {
         // Find the price to match the stop-limit order
-        uint64_t stop_price = new_order.IsBuy() ? order_book_ptr->GetMarketPriceAsk() : order_book_ptr->GetMarketPriceBid();
+        price_t stop_price = new_order.IsBuy() ? order_book_ptr->GetMarketPriceAsk() : order_book_ptr->GetMarketPriceBid();
 
         // Check the arbitrage bid/ask prices
         bool arbitrage = new_order.IsBuy() ? (new_order.StopPrice <= stop_price) : (new_order.StopPrice >= stop_price);
@@ -389,6 +732,9 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
                     return ErrorCode::ORDER_DUPLICATE;
                 }
 
+                // Index the order by its owner
+                AddOwnerOrder(order_ptr);
+
                 // Add the new limit order into the order book
                 UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr));
             }
@@ -399,7 +745,7 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
             }
 
             // Automatic order matching
-            if (_matching && !recursive)
+            if (IsAutomaticMatching(order_book_ptr) && !recursive)
                 Match(order_book_ptr);
 
             // Reset matching price
@@ -427,6 +773,9 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
             return ErrorCode::ORDER_DUPLICATE;
         }
 
+        // Index the order by its owner
+        AddOwnerOrder(order_ptr);
+
         // Add the new stop order into the order book
         if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
             order_book_ptr->AddTrailingStopOrder(order_ptr);
@@ -440,7 +789,7 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
     }
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         Match(order_book_ptr);
 
     // Reset matching price
@@ -451,6 +800,9 @@ ErrorCode MarketManager::AddStopLimitOrder(const Order& order, bool recursive)
 
 ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     return ReduceOrder(id, quantity, false);
 }
 
@@ -466,21 +818,23 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
 
     // Get the order to reduce
     auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
     if (order_it == _orders.end())
         return ErrorCode::ORDER_NOT_FOUND;
     OrderNode* order_ptr = (OrderNode*)order_it->second;
 
+    // Materialize the stop price of the trailing stop order
+    OrderBook::MaterializeTrailingStopOrder(order_ptr);
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
     // Calculate the minimal possible order quantity to reduce
-    quantity = std::min(quantity, order_ptr->LeavesQuantity);
+    quantity = std::min(quantity, (uint64_t)order_ptr->LeavesQuantity);
 
-    uint64_t hidden = order_ptr->HiddenQuantity();
-    uint64_t visible = order_ptr->VisibleQuantity();
+    quantity_t hidden = order_ptr->HiddenQuantity();
+    quantity_t visible = order_ptr->VisibleQuantity();
 
     // Reduce the order leaves quantity
     order_ptr->LeavesQuantity -= quantity;
@@ -498,7 +852,9 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
         switch (order_ptr->Type)
         {
             case OrderType::LIMIT:
-                UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
+                // Orders of the current batch are reduced in place
+                if (!IsBatchOrder(order_ptr))
+                    UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
                 break;
             case OrderType::STOP:
             case OrderType::STOP_LIMIT:
@@ -522,7 +878,10 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
         switch (order_ptr->Type)
         {
             case OrderType::LIMIT:
-                UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
+                if (IsBatchOrder(order_ptr))
+                    order_book_ptr->_batch_orders.pop_current(*order_ptr);
+                else
+                    UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
                 break;
             case OrderType::STOP:
             case OrderType::STOP_LIMIT:
@@ -541,11 +900,11 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
         _orders.erase(order_it);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_ptr);
     }
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         Match(order_book_ptr);
 
     // Reset matching price
@@ -556,11 +915,17 @@ ErrorCode MarketManager::ReduceOrder(uint64_t id, uint64_t quantity, bool recurs
 
 ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     return ModifyOrder(id, new_price, new_quantity, false, false);
 }
 
 ErrorCode MarketManager::MitigateOrder(uint64_t id, uint64_t new_price, uint64_t new_quantity)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     return ModifyOrder(id, new_price, new_quantity, true, false);
 }
 
@@ -573,24 +938,38 @@ ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t n
     assert((new_quantity > 0) && "Order quantity must be greater than zero!");
     if (new_quantity == 0)
         return ErrorCode::ORDER_QUANTITY_INVALID;
+    assert(IsValidQuantity(new_quantity) && "Order quantity is out of the quantity type range!");
+    if (!IsValidQuantity(new_quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+    assert(IsValidPrice(new_price) && "Order price is out of the price type range!");
+    if (!IsValidPrice(new_price))
+        return ErrorCode::ORDER_PRICE_INVALID;
 
     // Get the order to modify
     auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
     if (order_it == _orders.end())
         return ErrorCode::ORDER_NOT_FOUND;
     OrderNode* order_ptr = (OrderNode*)order_it->second;
 
+    // Materialize the stop price of the trailing stop order
+    OrderBook::MaterializeTrailingStopOrder(order_ptr);
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
+    // Modified order of the current batch stays in the batch
+    bool batch = IsBatchOrder(order_ptr);
+
     // Delete the order from the order book
     switch (order_ptr->Type)
     {
         case OrderType::LIMIT:
-            UpdateLevel(*order_book_ptr, order_book_ptr->DeleteOrder(order_ptr));
+            if (batch)
+                order_book_ptr->_batch_orders.pop_current(*order_ptr);
+            else
+                UpdateLevel(*order_book_ptr, order_book_ptr->DeleteOrder(order_ptr));
             break;
         case OrderType::STOP:
         case OrderType::STOP_LIMIT:
@@ -627,7 +1006,7 @@ ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t n
         _market_handler.onUpdateOrder(*order_ptr);
 
         // Automatic order matching
-        if (_matching && !recursive)
+        if (IsAutomaticMatching(order_book_ptr) && !recursive)
             MatchLimit(order_book_ptr, order_ptr);
 
         // Add non empty order into the order book
@@ -637,7 +1016,10 @@ ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t n
             switch (order_ptr->Type)
             {
                 case OrderType::LIMIT:
-                    UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr));
+                    if (batch)
+                        order_book_ptr->_batch_orders.push_back(*order_ptr);
+                    else
+                        UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr));
                     break;
                 case OrderType::STOP:
                 case OrderType::STOP_LIMIT:
@@ -664,11 +1046,11 @@ ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t n
         _orders.erase(order_it);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_ptr);
     }
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         Match(order_book_ptr);
 
     // Reset matching price
@@ -679,6 +1061,9 @@ ErrorCode MarketManager::ModifyOrder(uint64_t id, uint64_t new_price, uint64_t n
 
 ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     return ReplaceOrder(id, new_id, new_price, new_quantity, false);
 }
 
@@ -694,10 +1079,15 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new
     assert((new_quantity > 0) && "Order quantity must be greater than zero!");
     if (new_quantity == 0)
         return ErrorCode::ORDER_QUANTITY_INVALID;
+    assert(IsValidQuantity(new_quantity) && "Order quantity is out of the quantity type range!");
+    if (!IsValidQuantity(new_quantity))
+        return ErrorCode::ORDER_QUANTITY_INVALID;
+    assert(IsValidPrice(new_price) && "Order price is out of the price type range!");
+    if (!IsValidPrice(new_price))
+        return ErrorCode::ORDER_PRICE_INVALID;
 
     // Get the order to replace
     auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
     if (order_it == _orders.end())
         return ErrorCode::ORDER_NOT_FOUND;
     OrderNode* order_ptr = (OrderNode*)order_it->second;
@@ -710,89 +1100,92 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
-    // Delete the old order from the order book
-    switch (order_ptr->Type)
+    // Check the new order Id before any changes
+    if ((new_id != id) && (_orders.find(new_id) != _orders.end()))
+        return ErrorCode::ORDER_DUPLICATE;
+
+    // Keep the old order for the corresponding handler
+    Order old_order(*order_ptr);
+
+    // Replace the order of the current batch in place
+    if (IsBatchOrder(order_ptr))
     {
-        case OrderType::LIMIT:
-            UpdateLevel(*order_book_ptr, order_book_ptr->DeleteOrder(order_ptr));
-            break;
-        case OrderType::STOP:
-        case OrderType::STOP_LIMIT:
-            order_book_ptr->DeleteStopOrder(order_ptr);
-            break;
-        case OrderType::TRAILING_STOP:
-        case OrderType::TRAILING_STOP_LIMIT:
-            order_book_ptr->DeleteTrailingStopOrder(order_ptr);
-            break;
-        default:
-            assert(false && "Unsupported order type!");
-            break;
+        // Rekey the order
+        _orders.erase(order_it);
+        order_ptr->Id = new_id;
+        _orders.insert(std::make_pair(order_ptr->Id, order_ptr));
+
+        // Replace the order
+        order_ptr->Price = new_price;
+        order_ptr->Quantity = new_quantity;
+        order_ptr->ExecutedQuantity = 0;
+        order_ptr->LeavesQuantity = new_quantity;
+
+        // Move the order to the end of the current batch
+        order_book_ptr->_batch_orders.pop_current(*order_ptr);
+        order_book_ptr->_batch_orders.push_back(*order_ptr);
+
+        // Call the corresponding handler
+        _market_handler.onReplaceOrder(old_order, *order_ptr);
     }
+    // Replace the order in place at the same price level
+    else if (order_ptr->Price == new_price)
+    {
+        // Rekey the order
+        _orders.erase(order_it);
+        order_ptr->Id = new_id;
+        _orders.insert(std::make_pair(order_ptr->Id, order_ptr));
 
-    // Call the corresponding handler
-    _market_handler.onDeleteOrder(*order_ptr);
+        // Replace the order quantity and move it to the end of the price level
+        auto level_updates = order_book_ptr->ReplaceOrder(order_ptr, new_quantity);
 
-    // Erase the order
-    _orders.erase(order_it);
+        // Publish the price level without and with the replaced order as the delete and the add of the order do
+        UpdateLevel(*order_book_ptr, level_updates.first);
+        _market_handler.onReplaceOrder(old_order, *order_ptr);
+        UpdateLevel(*order_book_ptr, level_updates.second);
+    }
+    else
+    {
+        // Delete the old order from its price level
+        UpdateLevel(*order_book_ptr, order_book_ptr->DeleteOrder(order_ptr));
 
-    // Replace the order
-    order_ptr->Id = new_id;
-    order_ptr->Price = new_price;
-    order_ptr->Quantity = new_quantity;
-    order_ptr->ExecutedQuantity = 0;
-    order_ptr->LeavesQuantity = new_quantity;
+        // Erase the order
+        _orders.erase(order_it);
 
-    // Call the corresponding handler
-    _market_handler.onAddOrder(*order_ptr);
+        // Replace the order
+        order_ptr->Id = new_id;
+        order_ptr->Price = new_price;
+        order_ptr->Quantity = new_quantity;
+        order_ptr->ExecutedQuantity = 0;
+        order_ptr->LeavesQuantity = new_quantity;
 
-    // Automatic order matching
-    if (_matching && !recursive)
-        MatchLimit(order_book_ptr, order_ptr);
+        // Call the corresponding handler
+        _market_handler.onReplaceOrder(old_order, *order_ptr);
 
-    if (order_ptr->LeavesQuantity > 0)
-    {
-        // Insert the order
-        if (!_orders.insert(std::make_pair(order_ptr->Id, order_ptr)).second)
+        // Automatic order matching
+        if (IsAutomaticMatching(order_book_ptr) && !recursive)
+            MatchLimit(order_book_ptr, order_ptr);
+
+        if (order_ptr->LeavesQuantity > 0)
+        {
+            // Insert the order
+            _orders.insert(std::make_pair(order_ptr->Id, order_ptr));
+
+            // Add the replaced order into the new price level
+            UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr));
+        }
+        else
         {
             // Call the corresponding handler
             _market_handler.onDeleteOrder(*order_ptr);
 
             // Release the order
-            _order_pool.Release(order_ptr);
-
-            return ErrorCode::ORDER_DUPLICATE;
+            ReleaseOrder(order_ptr);
         }
-
-        // Add the modified order into the order book
-        switch (order_ptr->Type)
-        {
-            case OrderType::LIMIT:
-                UpdateLevel(*order_book_ptr, order_book_ptr->AddOrder(order_ptr));
-                break;
-            case OrderType::STOP:
-            case OrderType::STOP_LIMIT:
-                order_book_ptr->AddStopOrder(order_ptr);
-                break;
-            case OrderType::TRAILING_STOP:
-            case OrderType::TRAILING_STOP_LIMIT:
-                order_book_ptr->AddTrailingStopOrder(order_ptr);
-                break;
-            default:
-                assert(false && "Unsupported order type!");
-                break;
-        }
-    }
-    else
-    {
-        // Call the corresponding handler
-        _market_handler.onDeleteOrder(*order_ptr);
-
-        // Relase the order
-        _order_pool.Release(order_ptr);
-    }
+    }
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
         Match(order_book_ptr);
 
     // Reset matching price
@@ -803,6 +1196,9 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new
 
 ErrorCode MarketManager::ReplaceOrder(uint64_t id, const Order& new_order)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     // Delete the previous order by Id
     ErrorCode result = DeleteOrder(id);
     if (result != ErrorCode::OK)
@@ -814,6 +1210,9 @@ ErrorCode MarketManager::ReplaceOrder(uint64_t id, const Order& new_order)
 
 ErrorCode MarketManager::DeleteOrder(uint64_t id)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     return DeleteOrder(id, false);
 }
 
@@ -826,11 +1225,13 @@ ErrorCode MarketManager::DeleteOrder(uint64_t id, bool recursive)
 
     // Get the order to delete
     auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
     if (order_it == _orders.end())
         return ErrorCode::ORDER_NOT_FOUND;
     OrderNode* order_ptr = (OrderNode*)order_it->second;
 
+    // Materialize the stop price of the trailing stop order
+    OrderBook::MaterializeTrailingStopOrder(order_ptr);
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
@@ -840,7 +1241,10 @@ ErrorCode MarketManager::DeleteOrder(uint64_t id, bool recursive)
     switch (order_ptr->Type)
     {
         case OrderType::LIMIT:
-            UpdateLevel(*order_book_ptr, order_book_ptr->DeleteOrder(order_ptr));
+            if (IsBatchOrder(order_ptr))
+                order_book_ptr->_batch_orders.pop_current(*order_ptr);
+            else
+                UpdateLevel(*order_book_ptr, order_book_ptr->DeleteOrder(order_ptr));
             break;
         case OrderType::STOP:
         case OrderType::STOP_LIMIT:
@@ -862,20 +1266,205 @@ ErrorCode MarketManager::DeleteOrder(uint64_t id, bool recursive)
     _orders.erase(order_it);
 
     // Relase the order
-    _order_pool.Release(order_ptr);
+    ReleaseOrder(order_ptr);
+
+    // Automatic order matching
+    if (IsAutomaticMatching(order_book_ptr) && !recursive)
+        Match(order_book_ptr);
+
+    // Reset matching price
+    order_book_ptr->ResetMatchingPrice();
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::DeleteOrders(uint32_t id)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Delete all orders of the order book
+    DeleteOrders(_order_books[id], true, true, 0, std::numeric_limits<price_t>::max());
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::DeleteOrders(uint32_t id, OrderSide side, uint64_t min_price, uint64_t max_price)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert(((id < _order_books.size()) && (_order_books[id] != nullptr)) && "Order book not found!");
+    if ((_order_books.size() <= id) || (_order_books[id] == nullptr))
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+    assert((min_price <= max_price) && "Min price must not be greater than max price!");
+    if (min_price > max_price)
+        return ErrorCode::ORDER_PRICE_INVALID;
+
+    // Delete orders of the given side and price range
+    DeleteOrders(_order_books[id], (side == OrderSide::BUY), (side == OrderSide::SELL), SaturatePrice(min_price), SaturatePrice(max_price));
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::DeleteOwnerOrders(uint32_t owner)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    assert((owner > 0) && "Order owner Id must be greater than zero!");
+    if (owner == 0)
+        return ErrorCode::ORDER_PARAMETER_INVALID;
+
+    // Get the orders of the given owner
+    auto owner_it = _owner_orders.find(owner);
+    if ((owner_it == _owner_orders.end()) || owner_it->second.empty())
+        return ErrorCode::OK;
+
+    // Take the owner orders grouped by order books in the order of their Ids
+    _owner_orders_deleting.assign(owner_it->second.begin(), owner_it->second.end());
+    std::sort(_owner_orders_deleting.begin(), _owner_orders_deleting.end(), [](const OrderNode* order1, const OrderNode* order2)
+    {
+        return (order1->SymbolId < order2->SymbolId) || ((order1->SymbolId == order2->SymbolId) && (order1->Id < order2->Id));
+    });
+
+    // Delete the owner orders of each order book
+    size_t first = 0;
+    while (first < _owner_orders_deleting.size())
+    {
+        uint32_t symbol = _owner_orders_deleting[first]->SymbolId;
+        size_t last = first + 1;
+        while ((last < _owner_orders_deleting.size()) && (_owner_orders_deleting[last]->SymbolId == symbol))
+            ++last;
+
+        DeleteOwnerOrders(_order_books[symbol], &_owner_orders_deleting[first], last - first);
+
+        first = last;
+    }
+    _owner_orders_deleting.clear();
+
+    return ErrorCode::OK;
+}
+
+ErrorCode MarketManager::MassQuote(uint32_t id, const Quote* quotes, size_t count)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    // Get the valid order book for quotes
+    OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(id);
+    assert((order_book_ptr != nullptr) && "Order book not found!");
+    if (order_book_ptr == nullptr)
+        return ErrorCode::ORDER_BOOK_NOT_FOUND;
+
+    // Check for duplicate quotes
+    _quote_ids.clear();
+    for (size_t i = 0; i < count; ++i)
+        _quote_ids.push_back(quotes[i].Id);
+    std::sort(_quote_ids.begin(), _quote_ids.end());
+    if (std::adjacent_find(_quote_ids.begin(), _quote_ids.end()) != _quote_ids.end())
+        return ErrorCode::ORDER_DUPLICATE;
+
+    // Validate all quotes before any change
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Quote& quote = quotes[i];
+
+        assert((quote.Id > 0) && "Quote Id must be greater than zero!");
+        if (quote.Id == 0)
+            return ErrorCode::ORDER_ID_INVALID;
+
+        auto order_it = _orders.find(quote.Id);
+        if (order_it != _orders.end())
+        {
+            // Existing quote must be the limit order of the same order book
+            const OrderNode* order_ptr = order_it->second;
+            if (!order_ptr->IsLimit() || (order_ptr->SymbolId != id))
+                return ErrorCode::ORDER_TYPE_INVALID;
+            if ((quote.Quantity > 0) && (order_ptr->Side != quote.Side))
+                return ErrorCode::ORDER_PARAMETER_INVALID;
+        }
+        else if (quote.Quantity == 0)
+            return ErrorCode::ORDER_NOT_FOUND;
+
+        // Validate the quote limit order parameters
+        if (quote.Quantity > 0)
+        {
+            ErrorCode result = Order::Limit(quote.Id, id, quote.Side, quote.Price, quote.Quantity).Validate();
+            if (result != ErrorCode::OK)
+                return result;
+        }
+    }
+
+    // Coalesce order book updates
+    _coalescing = true;
+    _coalesced_top = false;
+
+    // Replace quotes without matching
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Quote& quote = quotes[i];
+
+        auto order_it = _orders.find(quote.Id);
+        if (order_it == _orders.end())
+        {
+            // Add a new quote
+            Order order = Order::Limit(quote.Id, id, quote.Side, quote.Price, quote.Quantity);
+            if (order_book_ptr->IsBatch())
+                AddBatchOrder(order_book_ptr, order);
+            else
+                AddLimitOrder(order, true);
+            continue;
+        }
+
+        const OrderNode* order_ptr = order_it->second;
+
+        // Delete the quote
+        if (quote.Quantity == 0)
+            DeleteOrder(quote.Id, true);
+        // Reduce the quote in place
+        else if ((quote.Price == order_ptr->Price) && (quote.Quantity <= order_ptr->LeavesQuantity))
+        {
+            if (quote.Quantity < order_ptr->LeavesQuantity)
+                ReduceOrder(quote.Id, order_ptr->LeavesQuantity - quote.Quantity, true);
+        }
+        // Modify the quote
+        else
+            ModifyOrder(quote.Id, quote.Price, quote.Quantity, false, true);
+    }
 
     // Automatic order matching
-    if (_matching && !recursive)
+    if (IsAutomaticMatching(order_book_ptr))
         Match(order_book_ptr);
 
     // Reset matching price
     order_book_ptr->ResetMatchingPrice();
 
+    // Publish net price level updates and the best bid and offer once for the whole ladder
+    _coalescing = false;
+    PublishCoalescedLevels(*order_book_ptr);
+    if (_coalesced_top)
+        order_book_ptr->PublishBBO();
+
+    // Call the corresponding handler with the coalesced order book update
+    _market_handler.onUpdateOrderBook(*order_book_ptr, _coalesced_top);
+
+    // Publish the indicative auction state
+    if (order_book_ptr->IsAuction())
+        _market_handler.onUpdateAuction(*order_book_ptr, order_book_ptr->GetAuction());
+
     return ErrorCode::OK;
 }
 
 ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     // Validate parameters
     assert((id > 0) && "Order Id must be greater than zero!");
     if (id == 0)
@@ -886,18 +1475,20 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
 
     // Get the order to execute
     auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
     if (order_it == _orders.end())
         return ErrorCode::ORDER_NOT_FOUND;
     OrderNode* order_ptr = (OrderNode*)order_it->second;
 
+    // Materialize the stop price of the trailing stop order
+    OrderBook::MaterializeTrailingStopOrder(order_ptr);
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
     // Calculate the minimal possible order quantity to execute
-    quantity = std::min(quantity, order_ptr->LeavesQuantity);
+    quantity = std::min(quantity, (uint64_t)order_ptr->LeavesQuantity);
 
     // Call the corresponding handler
     _market_handler.onExecuteOrder(*order_ptr, order_ptr->Price, quantity);
@@ -906,8 +1497,8 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
     order_book_ptr->UpdateLastPrice(*order_ptr, order_ptr->Price);
     order_book_ptr->UpdateMatchingPrice(*order_ptr, order_ptr->Price);
 
-    uint64_t hidden = order_ptr->HiddenQuantity();
-    uint64_t visible = order_ptr->VisibleQuantity();
+    quantity_t hidden = order_ptr->HiddenQuantity();
+    quantity_t visible = order_ptr->VisibleQuantity();
 
     // Increase the order executed quantity
     order_ptr->ExecutedQuantity += quantity;
@@ -922,7 +1513,14 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
     switch (order_ptr->Type)
     {
         case OrderType::LIMIT:
-            UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
+            if (IsBatchOrder(order_ptr))
+            {
+                // Orders of the current batch are reduced in place
+                if (order_ptr->LeavesQuantity == 0)
+                    order_book_ptr->_batch_orders.pop_current(*order_ptr);
+            }
+            else
+                UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
             break;
         case OrderType::STOP:
         case OrderType::STOP_LIMIT:
@@ -952,11 +1550,11 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
         _orders.erase(order_it);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_ptr);
     }
 
     // Automatic order matching
-    if (_matching)
+    if (IsAutomaticMatching(order_book_ptr))
         Match(order_book_ptr);
 
     // Reset matching price
@@ -967,6 +1565,9 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t quantity)
 
 ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quantity)
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     // Validate parameters
     assert((id > 0) && "Order Id must be greater than zero!");
     if (id == 0)
@@ -974,21 +1575,26 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quan
     assert((quantity > 0) && "Order quantity must be greater than zero!");
     if (quantity == 0)
         return ErrorCode::ORDER_QUANTITY_INVALID;
+    assert(IsValidPrice(price) && "Order price is out of the price type range!");
+    if (!IsValidPrice(price))
+        return ErrorCode::ORDER_PRICE_INVALID;
 
     // Get the order to execute
     auto order_it = _orders.find(id);
-    assert((order_it != _orders.end()) && "Order not found!");
     if (order_it == _orders.end())
         return ErrorCode::ORDER_NOT_FOUND;
     OrderNode* order_ptr = (OrderNode*)order_it->second;
 
+    // Materialize the stop price of the trailing stop order
+    OrderBook::MaterializeTrailingStopOrder(order_ptr);
+
     // Get the valid order book for the order
     OrderBook* order_book_ptr = (OrderBook*)GetOrderBook(order_ptr->SymbolId);
     if (order_book_ptr == nullptr)
         return ErrorCode::ORDER_BOOK_NOT_FOUND;
 
     // Calculate the minimal possible order quantity to execute
-    quantity = std::min(quantity, order_ptr->LeavesQuantity);
+    quantity = std::min(quantity, (uint64_t)order_ptr->LeavesQuantity);
 
     // Call the corresponding handler
     _market_handler.onExecuteOrder(*order_ptr, price, quantity);
@@ -997,8 +1603,8 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quan
     order_book_ptr->UpdateLastPrice(*order_ptr, price);
     order_book_ptr->UpdateMatchingPrice(*order_ptr, price);
 
-    uint64_t hidden = order_ptr->HiddenQuantity();
-    uint64_t visible = order_ptr->VisibleQuantity();
+    quantity_t hidden = order_ptr->HiddenQuantity();
+    quantity_t visible = order_ptr->VisibleQuantity();
 
     // Increase the order executed quantity
     order_ptr->ExecutedQuantity += quantity;
@@ -1013,7 +1619,14 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quan
     switch (order_ptr->Type)
     {
         case OrderType::LIMIT:
-            UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
+            if (IsBatchOrder(order_ptr))
+            {
+                // Orders of the current batch are reduced in place
+                if (order_ptr->LeavesQuantity == 0)
+                    order_book_ptr->_batch_orders.pop_current(*order_ptr);
+            }
+            else
+                UpdateLevel(*order_book_ptr, order_book_ptr->ReduceOrder(order_ptr, quantity, hidden, visible));
             break;
         case OrderType::STOP:
         case OrderType::STOP_LIMIT:
@@ -1043,11 +1656,11 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quan
         _orders.erase(order_it);
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_ptr);
     }
 
     // Automatic order matching
-    if (_matching)
+    if (IsAutomaticMatching(order_book_ptr))
         Match(order_book_ptr);
 
     // Reset matching price
@@ -1056,13 +1669,261 @@ ErrorCode MarketManager::ExecuteOrder(uint64_t id, uint64_t price, uint64_t quan
     return ErrorCode::OK;
 }
 
+void MarketManager::EnableReclamation(size_t readers, size_t threshold)
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    if (_epochs)
+        return;
+
+    _epochs = std::make_unique<EpochManager>(readers);
+    _reclaim_threshold = threshold;
+    _reclaim_trigger = threshold;
+}
+
+size_t MarketManager::Reclaim()
+{
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
+    if (!_epochs)
+        return 0;
+
+    // Nodes retired before the oldest observed epoch are unreachable for readers
+    uint64_t oldest = _epochs->Synchronize();
+
+    size_t count = 0;
+
+    // Recycle retired orders
+    while (!_retired_orders.empty() && (_retired_orders.front().first < oldest))
+    {
+        _order_pool.Release(_retired_orders.front().second);
+        _retired_orders.pop_front();
+        ++count;
+    }
+
+    // Recycle retired order books (their price levels are released with them)
+    while (!_retired_order_books.empty() && (_retired_order_books.front().first < oldest))
+    {
+        _order_book_pool.Release(_retired_order_books.front().second);
+        _retired_order_books.pop_front();
+        ++count;
+    }
+
+    // Recycle retired price levels
+    while (!_retired_levels.empty() && (_retired_levels.front().first < oldest))
+    {
+        _level_pool.Release(_retired_levels.front().second);
+        _retired_levels.pop_front();
+        ++count;
+    }
+
+    _retired -= count;
+
+    // Re-arm the trigger, so nodes kept by a stalled reader are not rescanned on each retirement
+    _reclaim_trigger = _retired + _reclaim_threshold;
+
+    return count;
+}
+
 void MarketManager::Match()
 {
+    // Select node pools of the market manager
+    NodeScope scope(*this);
+
     for (auto order_book_ptr : _order_books)
-        if (order_book_ptr != nullptr)
+        if ((order_book_ptr != nullptr) && !order_book_ptr->IsAuction() && !order_book_ptr->IsBatch())
             Match(order_book_ptr);
 }
 
+void MarketManager::DeleteOrders(OrderBook* order_book_ptr, bool buy, bool sell, price_t min_price, price_t max_price)
+{
+    OrderNodeList orders;
+
+    // Coalesce order book updates
+    _coalescing = true;
+    _coalesced_top = false;
+
+    // Unlink orders from bid/ask price levels
+    if (buy)
+        DeleteLevelsOrders(order_book_ptr, order_book_ptr->_best_bid, min_price, max_price, orders);
+    if (sell)
+        DeleteLevelsOrders(order_book_ptr, order_book_ptr->_best_ask, min_price, max_price, orders);
+
+    // Unlink orders from stop and trailing stop price levels
+    if (buy)
+    {
+        DeleteStopLevelsOrders(order_book_ptr, order_book_ptr->_best_buy_stop, false, min_price, max_price, orders);
+        DeleteStopLevelsOrders(order_book_ptr, order_book_ptr->_best_trailing_buy_stop, true, min_price, max_price, orders);
+    }
+    if (sell)
+    {
+        DeleteStopLevelsOrders(order_book_ptr, order_book_ptr->_best_sell_stop, false, min_price, max_price, orders);
+        DeleteStopLevelsOrders(order_book_ptr, order_book_ptr->_best_trailing_sell_stop, true, min_price, max_price, orders);
+    }
+
+    // Unlink matching orders of the current batch
+    OrderNode* batch_order_ptr = order_book_ptr->_batch_orders.front();
+    while (batch_order_ptr != nullptr)
+    {
+        OrderNode* next_batch_order_ptr = batch_order_ptr->next;
+
+        bool selected = (batch_order_ptr->IsBuy() ? buy : sell) && (batch_order_ptr->Price >= min_price) && (batch_order_ptr->Price <= max_price);
+        if (selected)
+        {
+            order_book_ptr->_batch_orders.pop_current(*batch_order_ptr);
+            orders.push_back(*batch_order_ptr);
+        }
+
+        batch_order_ptr = next_batch_order_ptr;
+    }
+
+    // Delete unlinked orders
+    DeleteUnlinkedOrders(order_book_ptr, orders);
+}
+
+void MarketManager::DeleteOwnerOrders(OrderBook* order_book_ptr, OrderNode* const* orders, size_t count)
+{
+    OrderNodeList unlinked;
+
+    // Coalesce order book updates
+    _coalescing = true;
+    _coalesced_top = false;
+
+    // Unlink the given orders from the order book
+    for (size_t i = 0; i < count; ++i)
+    {
+        OrderNode* order_ptr = orders[i];
+        switch (order_ptr->Type)
+        {
+            case OrderType::LIMIT:
+                if (IsBatchOrder(order_ptr))
+                    order_book_ptr->_batch_orders.pop_current(*order_ptr);
+                else
+                    UpdateLevel(*order_book_ptr, order_book_ptr->DeleteOrder(order_ptr));
+                break;
+            case OrderType::STOP:
+            case OrderType::STOP_LIMIT:
+                order_book_ptr->DeleteStopOrder(order_ptr);
+                break;
+            case OrderType::TRAILING_STOP:
+            case OrderType::TRAILING_STOP_LIMIT:
+                order_book_ptr->DeleteTrailingStopOrder(order_ptr);
+                break;
+            default:
+                assert(false && "Unsupported order type!");
+                break;
+        }
+        unlinked.push_back(*order_ptr);
+    }
+
+    // Delete unlinked orders
+    DeleteUnlinkedOrders(order_book_ptr, unlinked);
+}
+
+void MarketManager::DeleteUnlinkedOrders(OrderBook* order_book_ptr, OrderNodeList& orders)
+{
+    // Erase and release unlinked orders in a batch
+    size_t count = 0;
+    uint64_t volume = 0;
+    OrderNode* order_ptr;
+    while ((order_ptr = orders.pop_front()) != nullptr)
+    {
+        ++count;
+        volume += order_ptr->LeavesQuantity;
+
+        // Call the corresponding handler
+        _market_handler.onDeleteOrder(*order_ptr);
+
+        // Erase the order
+        _orders.erase(order_ptr->Id);
+
+        // Release the order
+        ReleaseOrder(order_ptr);
+    }
+
+    // Call the corresponding handler with the mass-cancel summary
+    if (count > 0)
+        _market_handler.onDeleteOrders(*order_book_ptr, count, volume);
+
+    // Automatic order matching
+    if ((count > 0) && IsAutomaticMatching(order_book_ptr))
+        Match(order_book_ptr);
+
+    // Reset matching price
+    order_book_ptr->ResetMatchingPrice();
+
+    // Call the corresponding handler with the coalesced order book update
+    _coalescing = false;
+    PublishCoalescedLevels(*order_book_ptr);
+    if (count > 0)
+    {
+        // Publish the best bid and offer once for the whole mass-cancel
+        if (_coalesced_top)
+            order_book_ptr->PublishBBO();
+
+        _market_handler.onUpdateOrderBook(*order_book_ptr, _coalesced_top);
+
+        // Publish the indicative auction state
+        if (order_book_ptr->IsAuction())
+            _market_handler.onUpdateAuction(*order_book_ptr, order_book_ptr->GetAuction());
+    }
+}
+
+void MarketManager::DeleteLevelsOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, price_t min_price, price_t max_price, OrderNodeList& orders)
+{
+    while (level_ptr != nullptr)
+    {
+        // Price levels are iterated from the best to the worst one
+        if (level_ptr->IsBid() ? (level_ptr->Price < min_price) : (level_ptr->Price > max_price))
+            break;
+
+        // Find the next price level before the current one is deleted
+        LevelNode* next_level_ptr = order_book_ptr->GetNextLevel(level_ptr);
+
+        // Unlink orders of the price level in bulk
+        if ((level_ptr->Price >= min_price) && (level_ptr->Price <= max_price))
+            UpdateLevel(*order_book_ptr, order_book_ptr->DeleteLevelOrders(level_ptr, orders));
+
+        level_ptr = next_level_ptr;
+    }
+}
+
+void MarketManager::DeleteStopLevelsOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, bool trailing, price_t min_price, price_t max_price, OrderNodeList& orders)
+{
+    while (level_ptr != nullptr)
+    {
+        // Stop price levels are iterated from the nearest to the farthest one
+        if (level_ptr->IsBid() ? (level_ptr->Price < min_price) : (level_ptr->Price > max_price))
+            break;
+
+        // Find the next stop price level before the current one is deleted
+        LevelNode* next_level_ptr = trailing ? order_book_ptr->GetNextTrailingStopLevel(level_ptr) : order_book_ptr->GetNextStopLevel(level_ptr);
+
+        if ((level_ptr->Price >= min_price) && (level_ptr->Price <= max_price))
+        {
+            OrderNode* order_ptr = level_ptr->OrderList.front();
+            while (order_ptr != nullptr)
+            {
+                OrderNode* next_order_ptr = order_ptr->next;
+
+                // Delete the order from the stop price level (the empty price level is deleted as well)
+                if (trailing)
+                    order_book_ptr->DeleteTrailingStopOrder(order_ptr);
+                else
+                    order_book_ptr->DeleteStopOrder(order_ptr);
+
+                orders.push_back(*order_ptr);
+
+                order_ptr = next_order_ptr;
+            }
+        }
+
+        level_ptr = next_level_ptr;
+    }
+}
+
 void MarketManager::Match(OrderBook* order_book_ptr)
 {
     // Matching loop
@@ -1091,23 +1952,31 @@ void MarketManager::Match(OrderBook* order_book_ptr)
                 // Special case for 'All-Or-None' orders
                 if (bid_order_ptr->IsAON() || ask_order_ptr->IsAON())
                 {
+                    // Matching chain was not found for the same bid/ask orders before
+                    if (order_book_ptr->_aon_unmatched_revision == order_book_ptr->_revision)
+                        return;
+
                     // Calculate the matching chain
-                    uint64_t chain = CalculateMatchingChain(order_book_ptr, bid_level_ptr, ask_level_ptr);
+                    volume_t chain = CalculateMatchingChain(order_book_ptr, bid_level_ptr, ask_level_ptr);
 
                     // Matching is not avaliable
                     if (chain == 0)
+                    {
+                        // Skip the matching chain calculation until bid/ask orders change
+                        order_book_ptr->_aon_unmatched_revision = order_book_ptr->_revision;
                         return;
+                    }
 
                     // Execute orders in the matching chain
                     if (bid_order_ptr->IsAON())
                     {
-                        uint64_t price = bid_order_ptr->Price;
+                        price_t price = bid_order_ptr->Price;
                         ExecuteMatchingChain(order_book_ptr, bid_level_ptr, price, chain);
                         ExecuteMatchingChain(order_book_ptr, ask_level_ptr, price, chain);
                     }
                     else
                     {
-                        uint64_t price = ask_order_ptr->Price;
+                        price_t price = ask_order_ptr->Price;
                         ExecuteMatchingChain(order_book_ptr, ask_level_ptr, price, chain);
                         ExecuteMatchingChain(order_book_ptr, bid_level_ptr, price, chain);
                     }
@@ -1122,10 +1991,10 @@ void MarketManager::Match(OrderBook* order_book_ptr)
                     std::swap(executing_order_ptr, reducing_order_ptr);
 
                 // Get the execution quantity
-                uint64_t quantity = executing_order_ptr->LeavesQuantity;
+                quantity_t quantity = executing_order_ptr->LeavesQuantity;
 
                 // Get the execution price
-                uint64_t price = executing_order_ptr->Price;
+                price_t price = executing_order_ptr->Price;
 
                 // Call the corresponding handler
                 _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
@@ -1179,8 +2048,8 @@ void MarketManager::MatchMarket(OrderBook* order_book_ptr, Order* order_ptr)
             return;
 
         order_ptr->Price = order_book_ptr->best_ask()->Price;
-        if (order_ptr->Price > (std::numeric_limits<uint64_t>::max() - order_ptr->Slippage))
-            order_ptr->Price = std::numeric_limits<uint64_t>::max();
+        if (order_ptr->Price > (std::numeric_limits<price_t>::max() - order_ptr->Slippage))
+            order_ptr->Price = std::numeric_limits<price_t>::max();
         else
             order_ptr->Price += order_ptr->Slippage;
     }
@@ -1191,8 +2060,8 @@ void MarketManager::MatchMarket(OrderBook* order_book_ptr, Order* order_ptr)
             return;
 
         order_ptr->Price = order_book_ptr->best_bid()->Price;
-        if (order_ptr->Price < (std::numeric_limits<uint64_t>::min() + order_ptr->Slippage))
-            order_ptr->Price = std::numeric_limits<uint64_t>::min();
+        if (order_ptr->Price < (std::numeric_limits<price_t>::min() + order_ptr->Slippage))
+            order_ptr->Price = std::numeric_limits<price_t>::min();
         else
             order_ptr->Price -= order_ptr->Slippage;
     }
@@ -1222,7 +2091,7 @@ void MarketManager::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
         if (order_ptr->IsFOK() || order_ptr->IsAON())
         {
             // Calculate the matching chain
-            uint64_t chain = CalculateMatchingChain(order_book_ptr, level_ptr, order_ptr->Price, order_ptr->LeavesQuantity);
+            quantity_t chain = order_book_ptr->CalculateMatchingChain(level_ptr, order_ptr->Price, order_ptr->LeavesQuantity);
 
             // Matching is not avaliable
             if (chain == 0)
@@ -1247,6 +2116,16 @@ void MarketManager::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
             return;
         }
 
+        // Allocate the order quantity across the price level with the order book allocation policy
+        if ((order_book_ptr->_allocation.Type != AllocationType::FIFO) && (level_ptr->AONOrders == 0) && (order_ptr->LeavesQuantity < level_ptr->TotalVolume))
+        {
+            if (order_book_ptr->_allocation.Type == AllocationType::PRO_RATA)
+                MatchProRata(order_book_ptr, level_ptr, order_ptr);
+            else
+                MatchSizePriority(order_book_ptr, level_ptr, order_ptr);
+            return;
+        }
+
         // Find the first order to execute
         OrderNode* executing_order_ptr = level_ptr->OrderList.front();
 
@@ -1257,51 +2136,236 @@ void MarketManager::MatchOrder(OrderBook* order_book_ptr, Order* order_ptr)
             OrderNode* next_executing_order_ptr = executing_order_ptr->next;
 
             // Get the execution quantity
-            uint64_t quantity = std::min(executing_order_ptr->LeavesQuantity, order_ptr->LeavesQuantity);
+            quantity_t quantity = std::min(executing_order_ptr->LeavesQuantity, order_ptr->LeavesQuantity);
 
             // Special case for 'All-Or-None' orders
             if (executing_order_ptr->IsAON() && (executing_order_ptr->LeavesQuantity > order_ptr->LeavesQuantity))
                 return;
 
-            // Get the execution price
-            uint64_t price = executing_order_ptr->Price;
+            // Execute matched orders
+            MatchOrders(order_book_ptr, executing_order_ptr, order_ptr, quantity);
+            if (order_ptr->LeavesQuantity == 0)
+                return;
 
-            // Call the corresponding handler
-            _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
+            // Move to the next order to execute at the same price level
+            executing_order_ptr = next_executing_order_ptr;
+        }
+    }
+}
 
-            // Update the corresponding market price
-            order_book_ptr->UpdateLastPrice(*executing_order_ptr, price);
-            order_book_ptr->UpdateMatchingPrice(*executing_order_ptr, price);
+void MarketManager::MatchOrders(OrderBook* order_book_ptr, OrderNode* executing_order_ptr, Order* order_ptr, quantity_t quantity)
+{
+    // Get the execution price
+    price_t price = executing_order_ptr->Price;
 
-            // Increase the order executed quantity
-            executing_order_ptr->ExecutedQuantity += quantity;
+    // Call the corresponding handler
+    _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
 
-            // Reduce the executing order in the order book
-            ReduceOrder(executing_order_ptr->Id, quantity, true);
+    // Update the corresponding market price
+    order_book_ptr->UpdateLastPrice(*executing_order_ptr, price);
+    order_book_ptr->UpdateMatchingPrice(*executing_order_ptr, price);
 
-            // Call the corresponding handler
-            _market_handler.onExecuteOrder(*order_ptr, price, quantity);
+    // Increase the order executed quantity
+    executing_order_ptr->ExecutedQuantity += quantity;
 
-            // Update the corresponding market price
-            order_book_ptr->UpdateLastPrice(*order_ptr, price);
-            order_book_ptr->UpdateMatchingPrice(*order_ptr, price);
+    // Reduce the executing order in the order book
+    ReduceOrder(executing_order_ptr->Id, quantity, true);
 
-            // Increase the order executed quantity
-            order_ptr->ExecutedQuantity += quantity;
+    // Call the corresponding handler
+    _market_handler.onExecuteOrder(*order_ptr, price, quantity);
 
-            // Reduce the order leaves quantity
-            order_ptr->LeavesQuantity -= quantity;
-            if (order_ptr->LeavesQuantity == 0)
-                return;
+    // Update the corresponding market price
+    order_book_ptr->UpdateLastPrice(*order_ptr, price);
+    order_book_ptr->UpdateMatchingPrice(*order_ptr, price);
+
+    // Increase the order executed quantity
+    order_ptr->ExecutedQuantity += quantity;
+
+    // Reduce the order leaves quantity
+    order_ptr->LeavesQuantity -= quantity;
+}
+
+void MarketManager::MatchProRata(OrderBook* order_book_ptr, LevelNode* level_ptr, Order* order_ptr)
+{
+    const Allocation& allocation = order_book_ptr->_allocation;
+    OrderNode* top_order_ptr = allocation.TopOrderPriority ? level_ptr->OrderList.front() : nullptr;
+    quantity_t quantity = order_ptr->LeavesQuantity;
+    volume_t volume = level_ptr->TotalVolume;
+
+    // Fill the top order before the allocation
+    quantity_t top = 0;
+    if (top_order_ptr != nullptr)
+    {
+        top = std::min(top_order_ptr->LeavesQuantity, quantity);
+        quantity -= top;
+        volume -= top_order_ptr->LeavesQuantity;
+    }
+
+    // Calculate integer pro-rata allocations in a single pass over the price level
+    _allocations.clear();
+    quantity_t allocated = 0;
+    size_t remainders = 0;
+    for (OrderNode* allocating_order_ptr = level_ptr->OrderList.front(); allocating_order_ptr != nullptr; allocating_order_ptr = allocating_order_ptr->next)
+    {
+        if (allocating_order_ptr == top_order_ptr)
+            continue;
+
+        uint64_t remainder = 0;
+        uint64_t share = ((quantity > 0) && (volume > 0)) ? MulDiv(allocating_order_ptr->LeavesQuantity, quantity, volume, remainder) : 0;
+
+        // Allocations less than the minimal quantity are moved to the residual
+        if (share < allocation.MinQuantity)
+            share = remainder = 0;
+        else
+            ++remainders;
+
+        _allocations.push_back({ allocating_order_ptr, (quantity_t)share, remainder, _allocations.size() });
+        allocated += (quantity_t)share;
+    }
+
+    // Rounding residual is allocated by one to orders with the largest remainders (ties in the time priority)
+    quantity_t residual = quantity - allocated;
+    size_t count = std::min((size_t)residual, remainders);
+    if (count > 0)
+    {
+        auto largest = [](const OrderAllocation& a, const OrderAllocation& b) { return (a.Remainder > b.Remainder) || ((a.Remainder == b.Remainder) && (a.Priority < b.Priority)); };
+        std::nth_element(_allocations.begin(), _allocations.begin() + (count - 1), _allocations.end(), largest);
+        for (size_t i = 0; i < count; ++i)
+            ++_allocations[i].Quantity;
+        residual -= (quantity_t)count;
+
+        // Restore the time priority
+        std::sort(_allocations.begin(), _allocations.end(), [](const OrderAllocation& a, const OrderAllocation& b) { return a.Priority < b.Priority; });
+    }
+
+    // Residual of allocations less than the minimal quantity is filled in the time priority
+    for (auto& order_allocation : _allocations)
+    {
+        if (residual == 0)
+            break;
+
+        quantity_t extra = std::min((quantity_t)(order_allocation.Order->LeavesQuantity - order_allocation.Quantity), residual);
+        order_allocation.Quantity += extra;
+        residual -= extra;
+    }
+
+    // Execute the top order
+    if ((top_order_ptr != nullptr) && (top > 0))
+        MatchOrders(order_book_ptr, top_order_ptr, order_ptr, top);
+
+    // Execute allocated orders in the time priority
+    for (const auto& order_allocation : _allocations)
+    {
+        quantity_t fill = std::min(order_allocation.Quantity, order_ptr->LeavesQuantity);
+        if (fill > 0)
+            MatchOrders(order_book_ptr, order_allocation.Order, order_ptr, fill);
+    }
+}
+
+void MarketManager::MatchSizePriority(OrderBook* order_book_ptr, LevelNode* level_ptr, Order* order_ptr)
+{
+    OrderNode* top_order_ptr = order_book_ptr->_allocation.TopOrderPriority ? level_ptr->OrderList.front() : nullptr;
+
+    // Collect orders of the price level in the time priority
+    _allocations.clear();
+    for (OrderNode* allocating_order_ptr = level_ptr->OrderList.front(); allocating_order_ptr != nullptr; allocating_order_ptr = allocating_order_ptr->next)
+        if (allocating_order_ptr != top_order_ptr)
+            _allocations.push_back({ allocating_order_ptr, allocating_order_ptr->LeavesQuantity, 0, _allocations.size() });
+
+    // Sort orders by size once (the first one in the time priority among equal orders)
+    std::sort(_allocations.begin(), _allocations.end(), [](const OrderAllocation& a, const OrderAllocation& b) { return (a.Quantity > b.Quantity) || ((a.Quantity == b.Quantity) && (a.Priority < b.Priority)); });
+
+    // Fill the top order before the allocation
+    if (top_order_ptr != nullptr)
+        MatchOrders(order_book_ptr, top_order_ptr, order_ptr, std::min(top_order_ptr->LeavesQuantity, order_ptr->LeavesQuantity));
+
+    // The order quantity is less than the price level volume, so the price level is never emptied
+    for (const auto& order_allocation : _allocations)
+    {
+        if (order_ptr->LeavesQuantity == 0)
+            break;
+
+        // Execute matched orders
+        MatchOrders(order_book_ptr, order_allocation.Order, order_ptr, std::min(order_allocation.Quantity, order_ptr->LeavesQuantity));
+    }
+}
+
+void MarketManager::Uncross(OrderBook* order_book_ptr)
+{
+    // Calculate the equilibrium price and the executable volume
+    Auction auction = order_book_ptr->GetAuction();
+    if (auction.Volume == 0)
+        return;
+
+    // Execute bids and asks at the equilibrium price
+    UncrossLevels(order_book_ptr, order_book_ptr->_best_bid, auction.Price, auction.Volume);
+    UncrossLevels(order_book_ptr, order_book_ptr->_best_ask, auction.Price, auction.Volume);
+}
+
+void MarketManager::UncrossLevels(OrderBook* order_book_ptr, LevelNode* level_ptr, price_t price, volume_t volume)
+{
+    // Travel through price levels
+    while ((level_ptr != nullptr) && (volume > 0))
+    {
+        // Check the arbitrage bid/ask prices
+        bool arbitrage = level_ptr->IsBid() ? (price <= level_ptr->Price) : (price >= level_ptr->Price);
+        if (!arbitrage)
+            return;
+
+        // Find the next price level before the current one might be deleted
+        LevelNode* next_level_ptr = order_book_ptr->GetNextLevel(level_ptr);
+
+        // Find the first order to execute
+        OrderNode* executing_order_ptr = level_ptr->OrderList.front();
+
+        // Execute orders at the current price level
+        while ((executing_order_ptr != nullptr) && (volume > 0))
+        {
+            // Find the next order to execute
+            OrderNode* next_executing_order_ptr = executing_order_ptr->next;
+
+            // 'All-Or-None' orders do not take part in the auction
+            if (!executing_order_ptr->IsAON())
+            {
+                // Get the execution quantity
+                quantity_t quantity = (quantity_t)std::min<volume_t>(executing_order_ptr->LeavesQuantity, volume);
+
+                // Call the corresponding handler
+                _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
+
+                // Update the corresponding market price
+                order_book_ptr->UpdateLastPrice(*executing_order_ptr, price);
+                order_book_ptr->UpdateMatchingPrice(*executing_order_ptr, price);
+
+                // Increase the order executed quantity
+                executing_order_ptr->ExecutedQuantity += quantity;
+
+                // Reduce the executing order in the order book
+                ReduceOrder(executing_order_ptr->Id, quantity, true);
+
+                volume -= quantity;
+            }
 
             // Move to the next order to execute at the same price level
             executing_order_ptr = next_executing_order_ptr;
         }
+
+        // Move to the next price level
+        level_ptr = next_level_ptr;
     }
 }
 
 bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr)
 {
+    // Fast path: nearest stop price levels are not reached by market prices
+    if (!order_book_ptr->IsBuyStopTriggered() && !order_book_ptr->IsSellStopTriggered())
+    {
+        // Recalculate trailing buy/sell stop orders
+        RecalculateTrailingStopPrice(order_book_ptr, order_book_ptr->_best_ask);
+        RecalculateTrailingStopPrice(order_book_ptr, order_book_ptr->_best_bid);
+        return false;
+    }
+
     bool result = false;
     bool stop = false;
 
@@ -1335,7 +2399,7 @@ bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr)
     return result;
 }
 
-bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t stop_price)
+bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, price_t stop_price)
 {
     bool result = false;
 
@@ -1346,15 +2410,14 @@ bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* lev
         if (!arbitrage)
             return result;
 
-        // Find the stop order to activate
-        OrderNode* activating_order_ptr = level_ptr->OrderList.front();
+        // Remove the whole stop price level from the order book at once
+        OrderNodeList activating;
+        order_book_ptr->ActivateStopLevel(level_ptr, activating);
 
-        // Activate all stop orders
-        while (activating_order_ptr != nullptr)
+        // Activate all stop orders of the removed price level
+        OrderNode* activating_order_ptr;
+        while ((activating_order_ptr = activating.pop_front()) != nullptr)
         {
-            // Find the next order to activate
-            OrderNode* next_activating_order_ptr = activating_order_ptr->next;
-
             // Activate the stop order
             switch (activating_order_ptr->Type)
             {
@@ -1369,11 +2432,7 @@ bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* lev
                 default:
                     assert(false && "Unsupported order type!");
                     break;
-
             }
-
-            // Move to the next order to activate at the same price level
-            activating_order_ptr = next_activating_order_ptr;
         }
     }
 
@@ -1382,12 +2441,6 @@ bool MarketManager::ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* lev
 
 bool MarketManager::ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* order_ptr)
 {
-    // Delete the stop order from the order book
-    if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
-        order_book_ptr->DeleteTrailingStopOrder(order_ptr);
-    else
-        order_book_ptr->DeleteStopOrder(order_ptr);
-
     // Convert the stop order into the market order
     order_ptr->Type = OrderType::MARKET;
     order_ptr->Price = 0;
@@ -1407,19 +2460,13 @@ bool MarketManager::ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* orde
     _orders.erase(_orders.find(order_ptr->Id));
 
     // Relase the order
-    _order_pool.Release(order_ptr);
+    ReleaseOrder(order_ptr);
 
     return true;
 }
 
 bool MarketManager::ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode* order_ptr)
 {
-    // Delete the stop order from the order book
-    if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
-        order_book_ptr->DeleteTrailingStopOrder(order_ptr);
-    else
-        order_book_ptr->DeleteStopOrder(order_ptr);
-
     // Convert the stop-limit order into the limit order
     order_ptr->Type = OrderType::LIMIT;
     order_ptr->StopPrice = 0;
@@ -1445,65 +2492,20 @@ bool MarketManager::ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode*
         _orders.erase(_orders.find(order_ptr->Id));
 
         // Relase the order
-        _order_pool.Release(order_ptr);
+        ReleaseOrder(order_ptr);
     }
 
     return true;
 }
 
-uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume)
-{
-    OrderNode* order_ptr = level_ptr->OrderList.front();
-    uint64_t available = 0;
-
-    // Travel through price levels
-    while (level_ptr != nullptr)
-    {
-        // Check the arbitrage bid/ask prices
-        bool arbitrage = level_ptr->IsBid() ? (price <= level_ptr->Price) : (price >= level_ptr->Price);
-        if (!arbitrage)
-            return 0;
-
-        // Travel through orders at current price levels
-        while (order_ptr != nullptr)
-        {
-            uint64_t need = volume - available;
-            uint64_t quantity = order_ptr->IsAON() ? order_ptr->LeavesQuantity : std::min(order_ptr->LeavesQuantity, need);
-            available += quantity;
-
-            // Matching is possible, return the chain size
-            if (volume == available)
-                return available;
-
-            // Matching is not possible
-            if (volume < available)
-                return 0;
-
-            // Take the next order
-            order_ptr = order_ptr->next;
-        }
-
-        // Switch to the next price level
-        if (order_ptr == nullptr)
-        {
-            level_ptr = order_book_ptr->GetNextLevel(level_ptr);
-            if (level_ptr != nullptr)
-                order_ptr = level_ptr->OrderList.front();
-        }
-    }
-
-    // Matching is not available
-    return 0;
-}
-
-uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* bid_level_ptr, LevelNode* ask_level_ptr)
+volume_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* bid_level_ptr, LevelNode* ask_level_ptr)
 {
     LevelNode* longest_level_ptr = bid_level_ptr;
     LevelNode* shortest_level_ptr = ask_level_ptr;
     OrderNode* longest_order_ptr = bid_level_ptr->OrderList.front();
     OrderNode* shortest_order_ptr = ask_level_ptr->OrderList.front();
-    uint64_t required = longest_order_ptr->LeavesQuantity;
-    uint64_t available = 0;
+    volume_t required = longest_order_ptr->LeavesQuantity;
+    volume_t available = 0;
 
     // Find the initial longest order chain
     if (longest_order_ptr->IsAON() && shortest_order_ptr->IsAON())
@@ -1525,14 +2527,33 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
         std::swap(longest_order_ptr, shortest_order_ptr);
     }
 
+    // Matching is not possible if the shortest side volume is not enough for the longest order
+    const LevelNode* shortest_root_ptr = shortest_level_ptr->IsBid() ? order_book_ptr->_bids.root() : order_book_ptr->_asks.root();
+    if (shortest_root_ptr->SubtreeVolume < required)
+        return 0;
+
     // Travel through price levels
     while ((longest_level_ptr != nullptr) && (shortest_level_ptr != nullptr))
     {
         // Travel through orders at current price levels
         while ((longest_order_ptr != nullptr) && (shortest_order_ptr != nullptr))
         {
-            uint64_t need = required - available;
-            uint64_t quantity = shortest_order_ptr->IsAON() ? shortest_order_ptr->LeavesQuantity : std::min(shortest_order_ptr->LeavesQuantity, need);
+            // Shortest price level without 'All-Or-None' orders is consumed without the orders walk
+            if ((shortest_level_ptr->AONOrders == 0) && (shortest_order_ptr == shortest_level_ptr->OrderList.front()))
+            {
+                volume_t need = required - available;
+
+                // Matching is possible, return the chain size
+                if (shortest_level_ptr->TotalVolume >= need)
+                    return required;
+
+                available += shortest_level_ptr->TotalVolume;
+                shortest_order_ptr = nullptr;
+                break;
+            }
+
+            volume_t need = required - available;
+            quantity_t quantity = shortest_order_ptr->IsAON() ? shortest_order_ptr->LeavesQuantity : (quantity_t)std::min<volume_t>(shortest_order_ptr->LeavesQuantity, need);
             available += quantity;
 
             // Matching is possible, return the chain size
@@ -1574,7 +2595,7 @@ uint64_t MarketManager::CalculateMatchingChain(OrderBook* order_book_ptr, LevelN
     return 0;
 }
 
-void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume)
+void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, price_t price, volume_t volume)
 {
     // Execute all orders in the matching chain
     while ((volume > 0) && (level_ptr != nullptr))
@@ -1591,7 +2612,7 @@ void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* l
             // Find the next order to execute
             OrderNode* next_executing_order_ptr = executing_order_ptr->next;
 
-            uint64_t quantity;
+            quantity_t quantity;
 
             // Execute order
             if (executing_order_ptr->IsAON())
@@ -1615,7 +2636,7 @@ void MarketManager::ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* l
             else
             {
                 // Get the execution quantity
-                quantity = std::min(executing_order_ptr->LeavesQuantity, volume);
+                quantity = (quantity_t)std::min<volume_t>(executing_order_ptr->LeavesQuantity, volume);
 
                 // Call the corresponding handler
                 _market_handler.onExecuteOrder(*executing_order_ptr, price, quantity);
@@ -1648,12 +2669,12 @@ void MarketManager::RecalculateTrailingStopPrice(OrderBook* order_book_ptr, Leve
     if (level_ptr == nullptr)
         return;
 
-    uint64_t new_trailing_price;
+    price_t new_trailing_price;
 
     // Check if we should skip the recalculation because of the market price goes to the wrong direction
     if (level_ptr->Type == LevelType::ASK)
     {
-        uint64_t old_trailing_price = order_book_ptr->_trailing_ask_price;
+        price_t old_trailing_price = order_book_ptr->_trailing_ask_price;
         new_trailing_price = order_book_ptr->GetMarketTrailingStopPriceAsk();
         order_book_ptr->_trailing_ask_price = new_trailing_price;
         if (new_trailing_price >= old_trailing_price)
@@ -1661,85 +2682,58 @@ void MarketManager::RecalculateTrailingStopPrice(OrderBook* order_book_ptr, Leve
     }
     if (level_ptr->Type == LevelType::BID)
     {
-        uint64_t old_trailing_price = order_book_ptr->_trailing_bid_price;
+        price_t old_trailing_price = order_book_ptr->_trailing_bid_price;
         new_trailing_price = order_book_ptr->GetMarketTrailingStopPriceBid();
         order_book_ptr->_trailing_bid_price = new_trailing_price;
         if (new_trailing_price <= old_trailing_price)
             return;
     }
 
-    // Recalculate trailing stop orders
-    LevelNode* previous = nullptr;
+    // Trailing stop orders with the same trailing distance and step share
+    // their price levels, so the whole price level is repriced at once and
+    // its orders are not touched (see OrderBook::MaterializeTrailingStopOrder()).
+    // Repriced price levels are collected during the single pass and linked
+    // back after it, price levels with the same new stop price are merged.
+    _repriced_levels.clear();
+
+    // Recalculate trailing stop price levels
     LevelNode* current = (level_ptr->Type == LevelType::ASK) ? order_book_ptr->_best_trailing_buy_stop : order_book_ptr->_best_trailing_sell_stop;
     while (current != nullptr)
     {
-        bool recalculated = false;
-
-        // Find the first order to recalculate
-        OrderNode* order_ptr = current->OrderList.front();
+        // Find the next stop price level before the current one is unlinked
+        LevelNode* next = order_book_ptr->GetNextTrailingStopLevel(current);
 
-        while (order_ptr != nullptr)
+        // Stop price of the price level must be changed
+        price_t new_stop_price = order_book_ptr->CalculateTrailingStopPrice(*current);
+        if (new_stop_price != current->Price)
         {
-            // Find the next order to recalculate
-            OrderNode* next_order_ptr = order_ptr->next;
-
-            uint64_t old_stop_price = order_ptr->StopPrice;
-            uint64_t new_stop_price = order_book_ptr->CalculateTrailingStopPrice(*order_ptr);
+            // Unlink the price level from the order book and update its stop price
+            order_book_ptr->UnlinkTrailingStopLevel(current);
+            current->Price = new_stop_price;
 
-            // Trailing distance for the order must be changed
-            if (new_stop_price != old_stop_price)
-            {
-                // Delete the order from the order book
-                order_book_ptr->DeleteTrailingStopOrder(order_ptr);
-
-                // Update the stop order price
-                switch (order_ptr->Type)
-                {
-                    case OrderType::TRAILING_STOP:
-                        order_ptr->StopPrice = new_stop_price;
-                        break;
-                    case OrderType::TRAILING_STOP_LIMIT:
-                    {
-                        int64_t diff = order_ptr->Price - order_ptr->StopPrice;
-                        order_ptr->StopPrice = new_stop_price;
-                        order_ptr->Price = order_ptr->StopPrice + diff;
-                        break;
-                    }
-                    default:
-                        assert(false && "Unsupported order type!");
-                        break;
-
-                }
-
-                // Call the corresponding handler
-                _market_handler.onUpdateOrder(*order_ptr);
-
-                // Add the new stop order into the order book
-                order_book_ptr->AddTrailingStopOrder(order_ptr);
-
-                recalculated = true;
-            }
-
-            // Move to the next order to recalculate at the same price level
-            order_ptr = next_order_ptr;
+            // Postpone linking the price level back into the order book
+            _repriced_levels.push_back(current);
         }
 
-        if (recalculated)
-        {
-            // Back to the previous stop price level
-            current = (previous != nullptr) ? previous : ((level_ptr->Type == LevelType::ASK) ? order_book_ptr->_best_trailing_buy_stop : order_book_ptr->_best_trailing_sell_stop);
-        }
-        else
-        {
-            // Move to the next stop price level
-            previous = current;
-            current = order_book_ptr->GetNextTrailingStopLevel(current);
-        }
+        // Move to the next stop price level
+        current = next;
     }
+
+    // Link repriced stop price levels into the order book
+    for (LevelNode* repriced_level_ptr : _repriced_levels)
+        order_book_ptr->LinkTrailingStopLevel(repriced_level_ptr);
 }
 
-void MarketManager::UpdateLevel(const OrderBook& order_book, const LevelUpdate& update) const
+void MarketManager::UpdateLevel(const OrderBook& order_book, const LevelUpdate& update)
 {
+    // Coalesce price level updates
+    if (_coalescing)
+    {
+        _coalesced_levels.push_back({ update.Update, (update.Type != UpdateType::ADD), update.Top, _coalesced_levels.size() });
+        _coalesced_top = _coalesced_top || update.Top;
+        return;
+    }
+
     switch (update.Type)
     {
         case UpdateType::ADD:
@@ -1755,7 +2749,137 @@ void MarketManager::UpdateLevel(const OrderBook& order_book, const LevelUpdate&
             break;
     }
 
+    // Publish the best bid and offer
+    if (update.Top)
+        order_book.PublishBBO();
+
     _market_handler.onUpdateOrderBook(order_book, update.Top);
+
+    // Publish the indicative auction state
+    if (order_book.IsAuction())
+        _market_handler.onUpdateAuction(order_book, order_book.GetAuction());
+}
+
+void MarketManager::PublishCoalescedLevels(const OrderBook& order_book)
+{
+    // Group coalesced updates by price levels in their order
+    std::sort(_coalesced_levels.begin(), _coalesced_levels.end(), [](const CoalescedLevel& a, const CoalescedLevel& b)
+    {
+        if (a.Update.IsBid() != b.Update.IsBid())
+            return a.Update.IsBid();
+        if (a.Update.Price != b.Update.Price)
+            return a.Update.Price < b.Update.Price;
+        return a.Sequence < b.Sequence;
+    });
+
+    for (size_t first = 0, last = 0; first < _coalesced_levels.size(); first = ++last)
+    {
+        // Find the last update of the price level
+        while (((last + 1) < _coalesced_levels.size()) && (_coalesced_levels[last + 1].Update.IsBid() == _coalesced_levels[first].Update.IsBid()) && (_coalesced_levels[last + 1].Update.Price == _coalesced_levels[first].Update.Price))
+            ++last;
+
+        const CoalescedLevel& before = _coalesced_levels[first];
+        const CoalescedLevel& after = _coalesced_levels[last];
+        const LevelNode* level_ptr = before.Update.IsBid() ? order_book.GetBid(before.Update.Price) : order_book.GetAsk(before.Update.Price);
+
+        // Call the corresponding handler with the net price level change
+        if (level_ptr != nullptr)
+        {
+            bool top = (level_ptr == (level_ptr->IsBid() ? order_book.best_bid() : order_book.best_ask()));
+            if (before.Existed)
+                _market_handler.onUpdateLevel(order_book, *level_ptr, top);
+            else
+                _market_handler.onAddLevel(order_book, *level_ptr, top);
+        }
+        else if (before.Existed)
+            _market_handler.onDeleteLevel(order_book, after.Update, after.Top);
+    }
+
+    _coalesced_levels.clear();
+}
+
+void MarketManager::ReleaseOrder(OrderNode* order_ptr)
+{
+    // Remove the order from the owner orders
+    DeleteOwnerOrder(order_ptr);
+
+    if (!_epochs)
+    {
+        _order_pool.Release(order_ptr);
+        return;
+    }
+
+    // Retire the order until reader threads leave the current epoch
+    _retired_orders.emplace_back(_epochs->epoch(), order_ptr);
+    if (++_retired >= _reclaim_trigger)
+        Reclaim();
+}
+
+void MarketManager::AddOwnerOrder(OrderNode* order_ptr)
+{
+    // Orders without the owner are not tracked
+    if (order_ptr->OwnerId == 0)
+        return;
+
+    // Find or create the owner orders
+    auto owner_it = _owner_orders.find(order_ptr->OwnerId);
+    if (owner_it == _owner_orders.end())
+        owner_it = _owner_orders.insert(std::make_pair(order_ptr->OwnerId, std::vector<OrderNode*>())).first;
+
+    // Append the order to the owner orders
+    std::vector<OrderNode*>& orders = owner_it->second;
+    assert((orders.size() < std::numeric_limits<uint32_t>::max()) && "Owner orders index overflow!");
+    order_ptr->OwnerIndex = (uint32_t)orders.size();
+    orders.push_back(order_ptr);
+}
+
+void MarketManager::DeleteOwnerOrder(OrderNode* order_ptr)
+{
+    // Orders without the owner are not tracked
+    if (order_ptr->OwnerId == 0)
+        return;
+
+    // Find the owner orders
+    auto owner_it = _owner_orders.find(order_ptr->OwnerId);
+    assert((owner_it != _owner_orders.end()) && "Order owner not found!");
+    if (owner_it == _owner_orders.end())
+        return;
+
+    // Swap the order with the last owner order and remove it
+    std::vector<OrderNode*>& orders = owner_it->second;
+    assert(((order_ptr->OwnerIndex < orders.size()) && (orders[order_ptr->OwnerIndex] == order_ptr)) && "Invalid owner order index!");
+    OrderNode* last_order_ptr = orders.back();
+    last_order_ptr->OwnerIndex = order_ptr->OwnerIndex;
+    orders[order_ptr->OwnerIndex] = last_order_ptr;
+    orders.pop_back();
+}
+
+void MarketManager::ReleaseLevel(LevelNode* level_ptr)
+{
+    if (!_epochs)
+    {
+        _level_pool.Release(level_ptr);
+        return;
+    }
+
+    // Retire the price level until reader threads leave the current epoch
+    _retired_levels.emplace_back(_epochs->epoch(), level_ptr);
+    if (++_retired >= _reclaim_trigger)
+        Reclaim();
+}
+
+void MarketManager::ReleaseOrderBook(OrderBook* order_book_ptr)
+{
+    if (!_epochs)
+    {
+        _order_book_pool.Release(order_book_ptr);
+        return;
+    }
+
+    // Retire the order book until reader threads leave the current epoch
+    _retired_order_books.emplace_back(_epochs->epoch(), order_book_ptr);
+    if (++_retired >= _reclaim_trigger)
+        Reclaim();
 }
 
 } // namespace Matching
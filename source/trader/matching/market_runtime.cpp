@@ -0,0 +1,251 @@
+/*!
+    \file market_runtime.cpp
+    \brief Market runtime implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_runtime.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace CppTrader {
+namespace Matching {
+
+namespace {
+
+// Count of poll loops between statistics publications (power of two)
+const uint64_t STATS_INTERVAL = 1024;
+
+static_assert((STATS_INTERVAL & (STATS_INTERVAL - 1)) == 0, "Statistics interval must be a power of two!");
+
+} // namespace
+
+MarketRuntime::MarketRuntime(bool realtime, bool lock_memory, uint32_t max_backoff, int priority)
+    : _realtime(realtime),
+      _lock_memory(lock_memory),
+      _max_backoff(max_backoff),
+      _priority(priority),
+      _memory_locked(false),
+      _running(false)
+{
+    assert((max_backoff > 0) && "Market runtime maximal backoff must be greater than zero!");
+    assert((priority > 0) && "Market runtime real-time priority must be greater than zero!");
+}
+
+MarketRuntime::~MarketRuntime()
+{
+    Stop();
+}
+
+size_t MarketRuntime::AddThread(const std::string& name, int core, const std::function<size_t()>& poll)
+{
+    assert(!running() && "Runtime threads could not be added to the running market runtime!");
+    assert(poll && "Runtime thread poll function must be valid!");
+
+    std::unique_ptr<Thread> thread(new Thread());
+    thread->Name = name;
+    thread->Core = core;
+    thread->Poll = poll;
+    thread->Pinned.store(false, std::memory_order_relaxed);
+    thread->Realtime.store(false, std::memory_order_relaxed);
+    thread->BusyLoops.store(0, std::memory_order_relaxed);
+    thread->IdleLoops.store(0, std::memory_order_relaxed);
+    thread->BusyCycles.store(0, std::memory_order_relaxed);
+    thread->IdleCycles.store(0, std::memory_order_relaxed);
+    thread->Work.store(0, std::memory_order_relaxed);
+    _threads.emplace_back(std::move(thread));
+    return _threads.size() - 1;
+}
+
+RuntimeStats MarketRuntime::stats(size_t thread) const noexcept
+{
+    assert((thread < _threads.size()) && "Invalid runtime thread!");
+    const Thread& instance = *_threads[thread];
+
+    RuntimeStats result;
+    result.Pinned = instance.Pinned.load(std::memory_order_relaxed);
+    result.Realtime = instance.Realtime.load(std::memory_order_relaxed);
+    result.BusyLoops = instance.BusyLoops.load(std::memory_order_relaxed);
+    result.IdleLoops = instance.IdleLoops.load(std::memory_order_relaxed);
+    result.BusyCycles = instance.BusyCycles.load(std::memory_order_relaxed);
+    result.IdleCycles = instance.IdleCycles.load(std::memory_order_relaxed);
+    result.Work = instance.Work.load(std::memory_order_relaxed);
+    result.Loops = result.BusyLoops + result.IdleLoops;
+    return result;
+}
+
+bool MarketRuntime::Start()
+{
+    if (running())
+        return false;
+
+    // Lock the process memory before the hot path is started
+    if (_lock_memory && !_memory_locked)
+        _memory_locked = LockMemory();
+
+    _running.store(true, std::memory_order_release);
+
+    // Start runtime threads
+    try
+    {
+        for (auto& thread : _threads)
+        {
+            Thread* instance = thread.get();
+            instance->Instance = std::thread([this, instance]() { Run(*instance); });
+        }
+    }
+    catch (...)
+    {
+        // Stop already started threads and unlock the process memory
+        Stop();
+        throw;
+    }
+
+    return true;
+}
+
+bool MarketRuntime::Stop()
+{
+    if (!running())
+        return false;
+
+    _running.store(false, std::memory_order_release);
+
+    // Wait for runtime threads
+    for (auto& thread : _threads)
+        if (thread->Instance.joinable())
+            thread->Instance.join();
+
+    // Unlock the process memory
+    if (_memory_locked)
+    {
+        UnlockMemory();
+        _memory_locked = false;
+    }
+
+    return true;
+}
+
+void MarketRuntime::Run(Thread& thread)
+{
+#if defined(__linux__)
+    // Linux thread names are limited with 15 characters
+    pthread_setname_np(pthread_self(), thread.Name.substr(0, 15).c_str());
+#endif
+
+    // Pin the thread and schedule it with the real-time policy
+    if (thread.Core != ANY_CORE)
+        thread.Pinned.store(PinThread(thread.Core), std::memory_order_relaxed);
+    if (_realtime)
+        thread.Realtime.store(SetRealtime(_priority), std::memory_order_relaxed);
+
+    uint64_t busy_loops = 0;
+    uint64_t idle_loops = 0;
+    uint64_t busy_cycles = 0;
+    uint64_t idle_cycles = 0;
+    uint64_t work = 0;
+    uint32_t backoff = 1;
+    bool busy = false;
+
+    // Publish statistics (single writer, so relaxed stores are enough)
+    auto publish = [&]()
+    {
+        thread.BusyLoops.store(busy_loops, std::memory_order_relaxed);
+        thread.IdleLoops.store(idle_loops, std::memory_order_relaxed);
+        thread.BusyCycles.store(busy_cycles, std::memory_order_relaxed);
+        thread.IdleCycles.store(idle_cycles, std::memory_order_relaxed);
+        thread.Work.store(work, std::memory_order_relaxed);
+    };
+
+    uint64_t timestamp = Cycles();
+    while (_running.load(std::memory_order_acquire))
+    {
+        size_t done = thread.Poll();
+        if (done > 0)
+        {
+            work += done;
+            ++busy_loops;
+            backoff = 1;
+
+            uint64_t current = Cycles();
+            busy_cycles += current - timestamp;
+            timestamp = current;
+        }
+        else
+        {
+            ++idle_loops;
+
+            // Back off with the exponentially growing count of pause instructions
+            for (uint32_t i = 0; i < backoff; ++i)
+                Pause();
+            if (backoff < _max_backoff)
+                backoff = (2 * backoff < _max_backoff) ? (2 * backoff) : _max_backoff;
+
+            uint64_t current = Cycles();
+            idle_cycles += current - timestamp;
+            timestamp = current;
+        }
+
+        // Publish statistics periodically and when the thread becomes idle
+        if ((((busy_loops + idle_loops) & (STATS_INTERVAL - 1)) == 0) || (busy && (done == 0)))
+            publish();
+        busy = (done > 0);
+    }
+
+    // Publish final statistics
+    publish();
+}
+
+bool MarketRuntime::PinThread(int core) noexcept
+{
+#if defined(__linux__)
+    if ((core < 0) || (core >= CPU_SETSIZE))
+        return false;
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core, &cpuset);
+    return (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0);
+#else
+    return false;
+#endif
+}
+
+bool MarketRuntime::SetRealtime(int priority) noexcept
+{
+#if defined(__linux__)
+    if ((priority < sched_get_priority_min(SCHED_FIFO)) || (priority > sched_get_priority_max(SCHED_FIFO)))
+        return false;
+
+    struct sched_param param = {};
+    param.sched_priority = priority;
+    return (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0);
+#else
+    return false;
+#endif
+}
+
+bool MarketRuntime::LockMemory() noexcept
+{
+#if defined(__linux__)
+    return (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+#else
+    return false;
+#endif
+}
+
+void MarketRuntime::UnlockMemory() noexcept
+{
+#if defined(__linux__)
+    munlockall();
+#endif
+}
+
+} // namespace Matching
+} // namespace CppTrader
@@ -0,0 +1,186 @@
+/*!
+    \file market_sequencer.cpp
+    \brief Market sequencer implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_sequencer.h"
+
+namespace CppTrader {
+namespace Matching {
+
+namespace {
+
+const size_t INVALID_STREAM = std::numeric_limits<size_t>::max();
+
+void WriteVarint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((uint8_t)value);
+}
+
+bool ReadVarint(const uint8_t*& buffer, const uint8_t* end, uint64_t& value) noexcept
+{
+    value = 0;
+    for (size_t shift = 0; (buffer < end) && (shift < 64); shift += 7)
+    {
+        uint8_t byte = *buffer++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+MarketSequencer::MarketSequencer(size_t streams, MergePolicy policy, size_t capacity, size_t batch)
+    : _streams_count(streams),
+      _policy(policy),
+      _capacity(capacity),
+      _streams(new Stream[streams]),
+      _arrival(0),
+      _sequence(0),
+      _replaying(false),
+      _batch(batch),
+      _sources(batch)
+{
+    assert((streams > 0) && "Market sequencer streams count must be greater than zero!");
+    assert(((capacity > 0) && ((capacity & (capacity - 1)) == 0)) && "Market sequencer stream capacity must be a power of two!");
+    assert((batch > 0) && "Market sequencer batch size must be greater than zero!");
+
+    for (size_t i = 0; i < _streams_count; ++i)
+    {
+        _streams[i].Tail.store(0, std::memory_order_relaxed);
+        _streams[i].CachedHead = 0;
+        _streams[i].Head.store(0, std::memory_order_relaxed);
+        _streams[i].CachedTail = 0;
+        _streams[i].Entries.reset(new Entry[_capacity]);
+    }
+}
+
+size_t MarketSequencer::Select() noexcept
+{
+    size_t selected = INVALID_STREAM;
+    uint64_t key = 0;
+
+    // Select the stream with the lowest merge key, ties are broken by the lower stream index
+    for (size_t i = 0; i < _streams_count; ++i)
+    {
+        Entry* entry = Peek(i);
+        if ((entry != nullptr) && ((selected == INVALID_STREAM) || (entry->Key < key)))
+        {
+            selected = i;
+            key = entry->Key;
+        }
+    }
+
+    return selected;
+}
+
+size_t MarketSequencer::Sequence(MarketManager& market, size_t limit)
+{
+    if (limit > _batch.size())
+        limit = _batch.size();
+
+    _journal.clear();
+    size_t run_stream = INVALID_STREAM;
+    uint64_t run_count = 0;
+
+    // Merge the batch of commands from input streams
+    size_t count = 0;
+    while (count < limit)
+    {
+        // Leave replay mode when the recorded merge journal is over
+        if (_replaying && _runs.empty())
+            _replaying = false;
+
+        size_t stream;
+        if (_replaying)
+        {
+            // Follow the recorded merge journal
+            stream = _runs.front().Stream;
+            if (Peek(stream) == nullptr)
+                break;
+            if (--_runs.front().Count == 0)
+                _runs.pop_front();
+        }
+        else
+        {
+            stream = Select();
+            if (stream == INVALID_STREAM)
+                break;
+        }
+
+        _batch[count] = *Peek(stream);
+        _sources[count] = stream;
+        Pop(stream);
+        ++count;
+
+        // Record the merge decision
+        if (stream != run_stream)
+        {
+            if (run_count > 0)
+            {
+                WriteVarint(_journal, run_stream);
+                WriteVarint(_journal, run_count);
+            }
+            run_stream = stream;
+            run_count = 0;
+        }
+        ++run_count;
+    }
+
+    if (count == 0)
+        return 0;
+
+    WriteVarint(_journal, run_stream);
+    WriteVarint(_journal, run_count);
+    onMergeJournal(_journal.data(), _journal.size());
+
+    // Prefetch order nodes of the whole batch
+    for (size_t i = 0; i < count; ++i)
+        if ((_batch[i].Command.Type != MarketCommandType::ADD_ORDER) && (_batch[i].Command.Id != 0))
+            market.PrefetchOrder(_batch[i].Command.Id);
+
+    // Apply commands in the merged order
+    for (size_t i = 0; i < count; ++i)
+    {
+        ErrorCode result = MarketCommandQueue::Apply(market, _batch[i].Command);
+        onSequencedCommand(_sequence++, _sources[i], _batch[i].Command, result);
+    }
+
+    return count;
+}
+
+bool MarketSequencer::Replay(const void* buffer, size_t size)
+{
+    const uint8_t* data = (const uint8_t*)buffer;
+    const uint8_t* end = data + size;
+
+    // Validate the whole journal buffer before appending its runs
+    std::vector<Run> runs;
+    while (data < end)
+    {
+        uint64_t stream;
+        uint64_t count;
+        if (!ReadVarint(data, end, stream) || !ReadVarint(data, end, count))
+            return false;
+        if ((stream >= _streams_count) || (count == 0))
+            return false;
+        runs.push_back(Run{ (size_t)stream, count });
+    }
+
+    _replaying = true;
+    _runs.insert(_runs.end(), runs.begin(), runs.end());
+    return true;
+}
+
+} // namespace Matching
+} // namespace CppTrader
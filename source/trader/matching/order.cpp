@@ -18,6 +18,21 @@ ErrorCode Order::Validate() const noexcept
     if (Id == 0)
         return ErrorCode::ORDER_ID_INVALID;
 
+    // Validate order price and quantity ranges. Compact price and quantity
+    // types reserve their maximal values for saturated out of range values.
+    if constexpr ((sizeof(price_t) < sizeof(uint64_t)) || (sizeof(quantity_t) < sizeof(uint64_t)))
+    {
+        assert((Price < std::numeric_limits<price_t>::max()) && "Order price is out of the price type range!");
+        if (Price == std::numeric_limits<price_t>::max())
+            return ErrorCode::ORDER_PRICE_INVALID;
+        assert((StopPrice < std::numeric_limits<price_t>::max()) && "Order stop price is out of the price type range!");
+        if (StopPrice == std::numeric_limits<price_t>::max())
+            return ErrorCode::ORDER_PRICE_INVALID;
+        assert((Quantity < std::numeric_limits<quantity_t>::max()) && "Order quantity is out of the quantity type range!");
+        if (Quantity == std::numeric_limits<quantity_t>::max())
+            return ErrorCode::ORDER_QUANTITY_INVALID;
+    }
+
     // Validate order quantity
     assert((Quantity >= LeavesQuantity) && "Order quantity must be greater than or equal to order leaves quantity!");
     if (Quantity < LeavesQuantity)
@@ -9,6 +9,8 @@
 #include "trader/matching/market_manager.h"
 #include "trader/matching/order_book.h"
 
+#include <cstdlib>
+
 namespace CppTrader {
 namespace Matching {
 
@@ -17,16 +19,23 @@ OrderBook::OrderBook(MarketManager& manager, const Symbol& symbol)
       _symbol(symbol),
       _best_bid(nullptr),
       _best_ask(nullptr),
+      _bid_depth(LevelType::BID),
+      _ask_depth(LevelType::ASK),
       _best_buy_stop(nullptr),
       _best_sell_stop(nullptr),
       _best_trailing_buy_stop(nullptr),
       _best_trailing_sell_stop(nullptr),
       _last_bid_price(0),
-      _last_ask_price(std::numeric_limits<uint64_t>::max()),
+      _last_ask_price(std::numeric_limits<price_t>::max()),
       _matching_bid_price(0),
-      _matching_ask_price(std::numeric_limits<uint64_t>::max()),
+      _matching_ask_price(std::numeric_limits<price_t>::max()),
       _trailing_bid_price(0),
-      _trailing_ask_price(std::numeric_limits<uint64_t>::max())
+      _trailing_ask_price(std::numeric_limits<price_t>::max()),
+      _allocation(),
+      _auction(false),
+      _batch(false),
+      _revision(0),
+      _aon_unmatched_revision(std::numeric_limits<uint64_t>::max())
 {
 }
 
@@ -100,6 +109,27 @@ LevelNode* OrderBook::DeleteLevel(OrderNode* order_ptr)
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
+    // Find price levels to rebuild subtree aggregates from after the erase.
+    // The price level with both children is replaced with its successor or
+    // predecessor, so both possible replacement parents are considered.
+    LevelNode* parent_ptr = level_ptr->parent;
+    LevelNode* successor_ptr = nullptr;
+    LevelNode* predecessor_ptr = nullptr;
+    if ((level_ptr->left != nullptr) && (level_ptr->right != nullptr))
+    {
+        successor_ptr = level_ptr->right;
+        while (successor_ptr->left != nullptr)
+            successor_ptr = successor_ptr->left;
+        if (successor_ptr->parent != level_ptr)
+            successor_ptr = successor_ptr->parent;
+
+        predecessor_ptr = level_ptr->left;
+        while (predecessor_ptr->right != nullptr)
+            predecessor_ptr = predecessor_ptr->right;
+        if (predecessor_ptr->parent != level_ptr)
+            predecessor_ptr = predecessor_ptr->parent;
+    }
+
     if (order_ptr->IsBuy())
     {
         // Update the best bid price level
@@ -119,12 +149,291 @@ LevelNode* OrderBook::DeleteLevel(OrderNode* order_ptr)
         _asks.erase(Levels::iterator(&_asks, level_ptr));
     }
 
+    // Rebuild the price levels subtree aggregates
+    if ((successor_ptr != nullptr) && (predecessor_ptr != nullptr))
+    {
+        RebuildSubtreePath(successor_ptr);
+        RebuildSubtreePath(predecessor_ptr);
+    }
+    else
+        RebuildSubtreePath(parent_ptr);
+
     // Release the price level
-    _manager._level_pool.Release(level_ptr);
+    _manager.ReleaseLevel(level_ptr);
+
+    return nullptr;
+}
+
+uint64_t OrderBook::GetCumulativeBidVolume(price_t price) const noexcept
+{
+    uint64_t volume = 0;
+
+    // Accumulate subtree volumes of bid price levels with prices greater than or equal to the given one
+    const LevelNode* level_ptr = _bids.root();
+    while (level_ptr != nullptr)
+    {
+        if (level_ptr->Price >= price)
+        {
+            volume += level_ptr->TotalVolume + ((level_ptr->right != nullptr) ? level_ptr->right->SubtreeVolume : 0);
+            level_ptr = level_ptr->left;
+        }
+        else
+            level_ptr = level_ptr->right;
+    }
+
+    return volume;
+}
+
+uint64_t OrderBook::GetCumulativeAskVolume(price_t price) const noexcept
+{
+    uint64_t volume = 0;
+
+    // Accumulate subtree volumes of ask price levels with prices less than or equal to the given one
+    const LevelNode* level_ptr = _asks.root();
+    while (level_ptr != nullptr)
+    {
+        if (level_ptr->Price <= price)
+        {
+            volume += level_ptr->TotalVolume + ((level_ptr->left != nullptr) ? level_ptr->left->SubtreeVolume : 0);
+            level_ptr = level_ptr->right;
+        }
+        else
+            level_ptr = level_ptr->left;
+    }
+
+    return volume;
+}
+
+size_t OrderBook::GetCumulativeBidOrders(price_t price) const noexcept
+{
+    size_t orders = 0;
+
+    // Accumulate subtree orders of bid price levels with prices greater than or equal to the given one
+    const LevelNode* level_ptr = _bids.root();
+    while (level_ptr != nullptr)
+    {
+        if (level_ptr->Price >= price)
+        {
+            orders += level_ptr->Orders + ((level_ptr->right != nullptr) ? level_ptr->right->SubtreeOrders : 0);
+            level_ptr = level_ptr->left;
+        }
+        else
+            level_ptr = level_ptr->right;
+    }
+
+    return orders;
+}
+
+size_t OrderBook::GetCumulativeAskOrders(price_t price) const noexcept
+{
+    size_t orders = 0;
+
+    // Accumulate subtree orders of ask price levels with prices less than or equal to the given one
+    const LevelNode* level_ptr = _asks.root();
+    while (level_ptr != nullptr)
+    {
+        if (level_ptr->Price <= price)
+        {
+            orders += level_ptr->Orders + ((level_ptr->left != nullptr) ? level_ptr->left->SubtreeOrders : 0);
+            level_ptr = level_ptr->right;
+        }
+        else
+            level_ptr = level_ptr->left;
+    }
+
+    return orders;
+}
+
+const LevelNode* OrderBook::GetBidForVolume(uint64_t volume) const noexcept
+{
+    // Descend from the best (highest) bid prices to the worst ones
+    const LevelNode* level_ptr = _bids.root();
+    while (level_ptr != nullptr)
+    {
+        uint64_t better = (level_ptr->right != nullptr) ? level_ptr->right->SubtreeVolume : 0;
+        if ((level_ptr->right != nullptr) && (volume <= better))
+            level_ptr = level_ptr->right;
+        else
+        {
+            volume -= better;
+            if (volume <= level_ptr->TotalVolume)
+                return level_ptr;
+            volume -= level_ptr->TotalVolume;
+            level_ptr = level_ptr->left;
+        }
+    }
+
+    return nullptr;
+}
+
+const LevelNode* OrderBook::GetAskForVolume(uint64_t volume) const noexcept
+{
+    // Descend from the best (lowest) ask prices to the worst ones
+    const LevelNode* level_ptr = _asks.root();
+    while (level_ptr != nullptr)
+    {
+        uint64_t better = (level_ptr->left != nullptr) ? level_ptr->left->SubtreeVolume : 0;
+        if ((level_ptr->left != nullptr) && (volume <= better))
+            level_ptr = level_ptr->left;
+        else
+        {
+            volume -= better;
+            if (volume <= level_ptr->TotalVolume)
+                return level_ptr;
+            volume -= level_ptr->TotalVolume;
+            level_ptr = level_ptr->right;
+        }
+    }
 
     return nullptr;
 }
 
+Auction OrderBook::GetAuction() const noexcept
+{
+    Auction auction;
+
+    // Auction is possible only for the crossed order book
+    if ((_best_bid == nullptr) || (_best_ask == nullptr) || (_best_bid->Price < _best_ask->Price))
+        return auction;
+
+    price_t lowest_price = _best_ask->Price;
+    price_t highest_price = _best_bid->Price;
+
+    // Accumulate the crossed bids volume and find the lowest crossed bid price level
+    uint64_t bid_volume = 0;
+    const LevelNode* bid_ptr = _best_bid;
+    for (const LevelNode* level_ptr = _best_bid; (level_ptr != nullptr) && (level_ptr->Price >= lowest_price); level_ptr = GetNextLevel(level_ptr))
+    {
+        bid_volume += level_ptr->TotalVolume - level_ptr->AONVolume;
+        bid_ptr = level_ptr;
+    }
+
+    uint64_t ask_volume = 0;
+    const LevelNode* ask_ptr = _best_ask;
+
+    // Travel through crossed price levels in the ascending price order
+    while ((bid_ptr != nullptr) || (ask_ptr != nullptr))
+    {
+        // Find the next candidate price
+        price_t price = ((ask_ptr != nullptr) && ((bid_ptr == nullptr) || (ask_ptr->Price <= bid_ptr->Price))) ? ask_ptr->Price : bid_ptr->Price;
+
+        // Asks volume at the candidate price includes all asks with lower or equal prices
+        if ((ask_ptr != nullptr) && (ask_ptr->Price == price))
+        {
+            ask_volume += ask_ptr->TotalVolume - ask_ptr->AONVolume;
+            ask_ptr = GetNextLevel(ask_ptr);
+            if ((ask_ptr != nullptr) && (ask_ptr->Price > highest_price))
+                ask_ptr = nullptr;
+        }
+
+        // Calculate the executable volume and the imbalance at the candidate price
+        uint64_t volume = std::min(bid_volume, ask_volume);
+        int64_t imbalance = (int64_t)bid_volume - (int64_t)ask_volume;
+        int64_t best_imbalance = auction.Imbalance();
+
+        // Choose the best equilibrium price
+        bool better = (volume > auction.Volume);
+        if ((volume > 0) && (volume == auction.Volume))
+        {
+            if (std::abs(imbalance) < std::abs(best_imbalance))
+                better = true;
+            else if ((std::abs(imbalance) == std::abs(best_imbalance)) && (imbalance > 0))
+                better = true;
+        }
+        if (better)
+        {
+            auction.Price = price;
+            auction.Volume = volume;
+            auction.BidVolume = bid_volume;
+            auction.AskVolume = ask_volume;
+        }
+
+        // Bids volume at higher prices excludes bids with the candidate price
+        if ((bid_ptr != nullptr) && (bid_ptr->Price == price))
+        {
+            bid_volume -= bid_ptr->TotalVolume - bid_ptr->AONVolume;
+
+            Levels::const_iterator it(&_bids, bid_ptr);
+            ++it;
+            bid_ptr = it.operator->();
+        }
+    }
+
+    return auction;
+}
+
+void OrderBook::EnableDepth(size_t levels)
+{
+    _bid_depth.Reset(levels);
+    _ask_depth.Reset(levels);
+
+    // Fill bids depth from the best bid price level
+    for (auto it = _bids.rbegin(); (it != _bids.rend()) && (_bid_depth.size() < levels); ++it)
+        _bid_depth.Append(*it);
+
+    // Fill asks depth from the best ask price level
+    for (auto it = _asks.begin(); (it != _asks.end()) && (_ask_depth.size() < levels); ++it)
+        _ask_depth.Append(*it);
+}
+
+void OrderBook::DisableDepth()
+{
+    _bid_depth.Reset(0);
+    _ask_depth.Reset(0);
+}
+
+void OrderBook::EnableBBO()
+{
+    // Create the best bid and offer block once, readers might already keep it
+    if (!_bbo)
+        _bbo = std::make_unique<BBOBlock>();
+
+    PublishBBO();
+}
+
+void OrderBook::PublishBBO() const noexcept
+{
+    if (!_bbo)
+        return;
+
+    BBO bbo;
+    if (_best_bid != nullptr)
+    {
+        bbo.BidPrice = _best_bid->Price;
+        bbo.BidVolume = _best_bid->TotalVolume;
+        bbo.BidOrders = _best_bid->Orders;
+    }
+    if (_best_ask != nullptr)
+    {
+        bbo.AskPrice = _best_ask->Price;
+        bbo.AskVolume = _best_ask->TotalVolume;
+        bbo.AskOrders = _best_ask->Orders;
+    }
+
+    _bbo->Publish(bbo);
+}
+
+void OrderBook::RefillDepth(Depth& depth)
+{
+    const Levels& levels = depth.IsBid() ? _bids : _asks;
+
+    // Check if there are price levels out of the depth
+    if (levels.size() <= depth.size())
+        return;
+
+    // Append the next price level after the worst one in the depth
+    LevelNode* level_ptr = nullptr;
+    if (depth.empty())
+        level_ptr = depth.IsBid() ? _best_bid : _best_ask;
+    else
+    {
+        price_t price = depth.prices()[depth.size() - 1];
+        level_ptr = GetNextLevel((LevelNode*)(depth.IsBid() ? GetBid(price) : GetAsk(price)));
+    }
+    if (level_ptr != nullptr)
+        depth.Append(*level_ptr);
+}
+
 LevelUpdate OrderBook::AddOrder(OrderNode* order_ptr)
 {
     // Find the price level for the order
@@ -147,14 +456,35 @@ LevelUpdate OrderBook::AddOrder(OrderNode* order_ptr)
     level_ptr->OrderList.push_back(*order_ptr);
     ++level_ptr->Orders;
 
+    // Update the price level 'All-Or-None' orders
+    if (order_ptr->IsAON())
+    {
+        level_ptr->AONVolume += order_ptr->LeavesQuantity;
+        ++level_ptr->AONOrders;
+    }
+
+    // Update the order book revision
+    ++_revision;
+
+    // Update the price levels subtree aggregates
+    if (update == UpdateType::ADD)
+        RebuildSubtreePath(level_ptr);
+    else
+        UpdateSubtreePath(level_ptr);
+
     // Cache the price level in the given order
     order_ptr->Level = level_ptr;
 
     // Price level was changed. Return top of the book modification flag.
-    return LevelUpdate(update, *order_ptr->Level, (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask)));
+    LevelUpdate level_update(update, *order_ptr->Level, (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask)));
+
+    // Update the price levels depth
+    UpdateDepth(level_update);
+
+    return level_update;
 }
 
-LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible)
+LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, quantity_t quantity, quantity_t hidden, quantity_t visible)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
@@ -164,6 +494,14 @@ LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint
     level_ptr->HiddenVolume -= hidden;
     level_ptr->VisibleVolume -= visible;
 
+    // Update the price level 'All-Or-None' orders
+    if (order_ptr->IsAON())
+    {
+        level_ptr->AONVolume -= quantity;
+        if (order_ptr->LeavesQuantity == 0)
+            --level_ptr->AONOrders;
+    }
+
     // Unlink the empty order from the orders list of the price level
     if (order_ptr->LeavesQuantity == 0)
     {
@@ -171,6 +509,9 @@ LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint
         --level_ptr->Orders;
     }
 
+    // Update the order book revision
+    ++_revision;
+
     Level level(*level_ptr);
 
     // Delete the empty price level
@@ -181,9 +522,19 @@ LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint
         order_ptr->Level = DeleteLevel(order_ptr);
         update = UpdateType::DELETE;
     }
+    else
+    {
+        // Update the price levels subtree aggregates
+        UpdateSubtreePath(level_ptr);
+    }
 
     // Price level was changed. Return top of the book modification flag.
-    return LevelUpdate(update, level, ((order_ptr->Level == nullptr) || (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask))));
+    LevelUpdate level_update(update, level, ((order_ptr->Level == nullptr) || (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask))));
+
+    // Update the price levels depth
+    UpdateDepth(level_update);
+
+    return level_update;
 }
 
 LevelUpdate OrderBook::DeleteOrder(OrderNode* order_ptr)
@@ -196,10 +547,20 @@ LevelUpdate OrderBook::DeleteOrder(OrderNode* order_ptr)
     level_ptr->HiddenVolume -= order_ptr->HiddenQuantity();
     level_ptr->VisibleVolume -= order_ptr->VisibleQuantity();
 
+    // Update the price level 'All-Or-None' orders
+    if (order_ptr->IsAON())
+    {
+        level_ptr->AONVolume -= order_ptr->LeavesQuantity;
+        --level_ptr->AONOrders;
+    }
+
     // Unlink the empty order from the orders list of the price level
     level_ptr->OrderList.pop_current(*order_ptr);
     --level_ptr->Orders;
 
+    // Update the order book revision
+    ++_revision;
+
     Level level(*level_ptr);
 
     // Delete the empty price level
@@ -210,9 +571,132 @@ LevelUpdate OrderBook::DeleteOrder(OrderNode* order_ptr)
         order_ptr->Level = DeleteLevel(order_ptr);
         update = UpdateType::DELETE;
     }
+    else
+    {
+        // Update the price levels subtree aggregates
+        UpdateSubtreePath(level_ptr);
+    }
+
+    // Price level was changed. Return top of the book modification flag.
+    LevelUpdate level_update(update, level, ((order_ptr->Level == nullptr) || (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask))));
+
+    // Update the price levels depth
+    UpdateDepth(level_update);
+
+    return level_update;
+}
+
+std::pair<LevelUpdate, LevelUpdate> OrderBook::ReplaceOrder(OrderNode* order_ptr, quantity_t quantity)
+{
+    // Find the price level for the order
+    LevelNode* level_ptr = order_ptr->Level;
+    bool top = (level_ptr == (order_ptr->IsBuy() ? _best_bid : _best_ask));
+
+    // Remove the previous order volume from the price level
+    level_ptr->TotalVolume -= order_ptr->LeavesQuantity;
+    level_ptr->HiddenVolume -= order_ptr->HiddenQuantity();
+    level_ptr->VisibleVolume -= order_ptr->VisibleQuantity();
+    if (order_ptr->IsAON())
+        level_ptr->AONVolume -= order_ptr->LeavesQuantity;
+
+    // Price level without the previous order as it is seen after the order delete
+    Level deleted(*level_ptr);
+    --deleted.Orders;
+
+    // Replace the order quantity
+    order_ptr->Quantity = quantity;
+    order_ptr->ExecutedQuantity = 0;
+    order_ptr->LeavesQuantity = quantity;
+
+    // Add the new order volume to the price level
+    level_ptr->TotalVolume += order_ptr->LeavesQuantity;
+    level_ptr->HiddenVolume += order_ptr->HiddenQuantity();
+    level_ptr->VisibleVolume += order_ptr->VisibleQuantity();
+    if (order_ptr->IsAON())
+        level_ptr->AONVolume += order_ptr->LeavesQuantity;
+
+    // Move the order to the end of the orders list of the price level (time priority is lost)
+    level_ptr->OrderList.pop_current(*order_ptr);
+    level_ptr->OrderList.push_back(*order_ptr);
+
+    // Update the order book revision
+    ++_revision;
+
+    // Update the price levels subtree aggregates
+    UpdateSubtreePath(level_ptr);
+
+    // Price level was changed. Return top of the book modification flag.
+    LevelUpdate level_update(UpdateType::UPDATE, *level_ptr, top);
+
+    // Update the price levels depth
+    UpdateDepth(level_update);
+
+    return std::make_pair(LevelUpdate(UpdateType::UPDATE, deleted, top), level_update);
+}
+
+LevelUpdate OrderBook::DeleteLevelOrders(LevelNode* level_ptr, OrderNodeList& orders)
+{
+    OrderNode* last_order_ptr = nullptr;
+
+    // Unlink all orders of the price level in a single pass
+    OrderNode* order_ptr = level_ptr->OrderList.front();
+    while (order_ptr != nullptr)
+    {
+        OrderNode* next_order_ptr = order_ptr->next;
+
+        // Update the price level volume
+        level_ptr->TotalVolume -= order_ptr->LeavesQuantity;
+        level_ptr->HiddenVolume -= order_ptr->HiddenQuantity();
+        level_ptr->VisibleVolume -= order_ptr->VisibleQuantity();
+
+        // Update the price level 'All-Or-None' orders
+        if (order_ptr->IsAON())
+        {
+            level_ptr->AONVolume -= order_ptr->LeavesQuantity;
+            --level_ptr->AONOrders;
+        }
+
+        // Move the order from the orders list of the price level into the given list
+        level_ptr->OrderList.pop_current(*order_ptr);
+        --level_ptr->Orders;
+        orders.push_back(*order_ptr);
+
+        last_order_ptr = order_ptr;
+        order_ptr = next_order_ptr;
+    }
+
+    // Price level was not changed
+    if (last_order_ptr == nullptr)
+        return LevelUpdate(UpdateType::NONE, Level(*level_ptr), false);
+
+    // Update the order book revision
+    ++_revision;
+
+    Level level(*level_ptr);
+
+    // Delete the empty price level
+    UpdateType update = UpdateType::UPDATE;
+    bool top = (level_ptr == (level_ptr->IsBid() ? _best_bid : _best_ask));
+    if (level_ptr->TotalVolume == 0)
+    {
+        // Delete the price level using the last unlinked order
+        DeleteLevel(last_order_ptr);
+        update = UpdateType::DELETE;
+        top = true;
+    }
+    else
+    {
+        // Update the price levels subtree aggregates
+        UpdateSubtreePath(level_ptr);
+    }
 
     // Price level was changed. Return top of the book modification flag.
-    return LevelUpdate(update, level, ((order_ptr->Level == nullptr) || (order_ptr->Level == (order_ptr->IsBuy() ? _best_bid : _best_ask))));
+    LevelUpdate level_update(update, level, top);
+
+    // Update the price levels depth
+    UpdateDepth(level_update);
+
+    return level_update;
 }
 
 LevelNode* OrderBook::AddStopLevel(OrderNode* order_ptr)
@@ -272,7 +756,7 @@ LevelNode* OrderBook::DeleteStopLevel(OrderNode* order_ptr)
     }
 
     // Release the price level
-    _manager._level_pool.Release(level_ptr);
+    _manager.ReleaseLevel(level_ptr);
 
     return nullptr;
 }
@@ -299,7 +783,7 @@ void OrderBook::AddStopOrder(OrderNode* order_ptr)
     order_ptr->Level = level_ptr;
 }
 
-void OrderBook::ReduceStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible)
+void OrderBook::ReduceStopOrder(OrderNode* order_ptr, quantity_t quantity, quantity_t hidden, quantity_t visible)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
@@ -348,42 +832,70 @@ void OrderBook::DeleteStopOrder(OrderNode* order_ptr)
 
 LevelNode* OrderBook::AddTrailingStopLevel(OrderNode* order_ptr)
 {
-    LevelNode* level_ptr = nullptr;
+    // Create a new price level for orders with the same trailing distance and step
+    LevelNode* level_ptr = _manager._level_pool.Create(order_ptr->IsBuy() ? LevelType::ASK : LevelType::BID, order_ptr->StopPrice, order_ptr->TrailingDistance, order_ptr->TrailingStep);
 
-    if (order_ptr->IsBuy())
-    {
-        // Create a new price level
-        level_ptr = _manager._level_pool.Create(LevelType::ASK, order_ptr->StopPrice);
+    // Insert the price level into the trailing stop orders collection
+    return LinkTrailingStopLevel(level_ptr);
+}
 
-        // Insert the price level into the trailing buy stop orders collection
-        _trailing_buy_stop.insert(*level_ptr);
+LevelNode* OrderBook::DeleteTrailingStopLevel(OrderNode* order_ptr)
+{
+    // Find the price level for the order
+    LevelNode* level_ptr = order_ptr->Level;
 
-        // Update the best trailing buy stop order price level
-        if ((_best_trailing_buy_stop == nullptr) || (level_ptr->Price < _best_trailing_buy_stop->Price))
+    // Erase the price level from the trailing stop orders collection
+    UnlinkTrailingStopLevel(level_ptr);
+
+    // Release the price level
+    _manager.ReleaseLevel(level_ptr);
+
+    return nullptr;
+}
+
+LevelNode* OrderBook::LinkTrailingStopLevel(LevelNode* level_ptr)
+{
+    // Trailing buy stop orders are kept in ask price levels
+    Levels& levels = level_ptr->IsAsk() ? _trailing_buy_stop : _trailing_sell_stop;
+
+    // Insert the price level into the trailing stop orders collection
+    auto result = levels.insert(*level_ptr);
+    if (!result.second)
+    {
+        LevelNode* existing_ptr = result.first.operator->();
+
+        // Merge the smaller price level into the bigger one, orders of the existing price level go first
+        if (existing_ptr->Orders >= level_ptr->Orders)
+        {
+            MergeTrailingStopLevel(level_ptr, existing_ptr, false);
+            _manager.ReleaseLevel(level_ptr);
+            return existing_ptr;
+        }
+
+        MergeTrailingStopLevel(existing_ptr, level_ptr, true);
+        UnlinkTrailingStopLevel(existing_ptr);
+        _manager.ReleaseLevel(existing_ptr);
+        levels.insert(*level_ptr);
+    }
+
+    // Update the best trailing stop order price level
+    if (level_ptr->IsAsk())
+    {
+        if ((_best_trailing_buy_stop == nullptr) || (*level_ptr < *_best_trailing_buy_stop))
             _best_trailing_buy_stop = level_ptr;
     }
     else
     {
-        // Create a new price level
-        level_ptr = _manager._level_pool.Create(LevelType::BID, order_ptr->StopPrice);
-
-        // Insert the price level into the trailing sell stop orders collection
-        _trailing_sell_stop.insert(*level_ptr);
-
-        // Update the best trailing sell stop order price level
-        if ((_best_trailing_sell_stop == nullptr) || (level_ptr->Price > _best_trailing_sell_stop->Price))
+        if ((_best_trailing_sell_stop == nullptr) || (*level_ptr > *_best_trailing_sell_stop))
             _best_trailing_sell_stop = level_ptr;
     }
 
     return level_ptr;
 }
 
-LevelNode* OrderBook::DeleteTrailingStopLevel(OrderNode* order_ptr)
+void OrderBook::UnlinkTrailingStopLevel(LevelNode* level_ptr)
 {
-    // Find the price level for the order
-    LevelNode* level_ptr = order_ptr->Level;
-
-    if (order_ptr->IsBuy())
+    if (level_ptr->IsAsk())
     {
         // Update the best trailing buy stop order price level
         if (level_ptr == _best_trailing_buy_stop)
@@ -401,17 +913,40 @@ LevelNode* OrderBook::DeleteTrailingStopLevel(OrderNode* order_ptr)
         // Erase the price level from the trailing sell stop orders collection
         _trailing_sell_stop.erase(Levels::iterator(&_trailing_sell_stop, level_ptr));
     }
+}
 
-    // Release the price level
-    _manager._level_pool.Release(level_ptr);
+void OrderBook::MergeTrailingStopLevel(LevelNode* level_ptr, LevelNode* target_ptr, bool front)
+{
+    // Move orders of the price level to the front or to the back of the target price level
+    OrderNode* order_ptr;
+    while ((order_ptr = (front ? level_ptr->OrderList.pop_back() : level_ptr->OrderList.pop_front())) != nullptr)
+    {
+        if (front)
+            target_ptr->OrderList.push_front(*order_ptr);
+        else
+            target_ptr->OrderList.push_back(*order_ptr);
 
-    return nullptr;
+        // Cache the target price level in the moved order
+        order_ptr->Level = target_ptr;
+    }
+
+    // Update the target price level volume
+    target_ptr->TotalVolume += level_ptr->TotalVolume;
+    target_ptr->HiddenVolume += level_ptr->HiddenVolume;
+    target_ptr->VisibleVolume += level_ptr->VisibleVolume;
+    target_ptr->Orders += level_ptr->Orders;
+
+    // Clear the price level volume
+    level_ptr->TotalVolume = 0;
+    level_ptr->HiddenVolume = 0;
+    level_ptr->VisibleVolume = 0;
+    level_ptr->Orders = 0;
 }
 
 void OrderBook::AddTrailingStopOrder(OrderNode* order_ptr)
 {
     // Find the price level for the order
-    LevelNode* level_ptr = order_ptr->IsBuy() ? (LevelNode*)GetTrailingBuyStopLevel(order_ptr->StopPrice) : (LevelNode*)GetTrailingSellStopLevel(order_ptr->StopPrice);
+    LevelNode* level_ptr = GetTrailingStopLevel(order_ptr);
 
     // Create a new price level if no one found
     if (level_ptr == nullptr)
@@ -430,11 +965,14 @@ void OrderBook::AddTrailingStopOrder(OrderNode* order_ptr)
     order_ptr->Level = level_ptr;
 }
 
-void OrderBook::ReduceTrailingStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible)
+void OrderBook::ReduceTrailingStopOrder(OrderNode* order_ptr, quantity_t quantity, quantity_t hidden, quantity_t visible)
 {
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
+    // Materialize the stop price of the order
+    MaterializeTrailingStopOrder(*order_ptr, *level_ptr);
+
     // Update the price level volume
     level_ptr->TotalVolume -= quantity;
     level_ptr->HiddenVolume -= hidden;
@@ -460,6 +998,9 @@ void OrderBook::DeleteTrailingStopOrder(OrderNode* order_ptr)
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
+    // Materialize the stop price of the order
+    MaterializeTrailingStopOrder(*order_ptr, *level_ptr);
+
     // Update the price level volume
     level_ptr->TotalVolume -= order_ptr->LeavesQuantity;
     level_ptr->HiddenVolume -= order_ptr->HiddenQuantity();
@@ -477,12 +1018,106 @@ void OrderBook::DeleteTrailingStopOrder(OrderNode* order_ptr)
     }
 }
 
-uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcept
+quantity_t OrderBook::CalculateMatchingChain(const LevelNode* level_ptr, price_t price, quantity_t volume) const noexcept
+{
+    const OrderNode* order_ptr = level_ptr->OrderList.front();
+    volume_t available = 0;
+
+    // Travel through price levels
+    while (level_ptr != nullptr)
+    {
+        // Check the arbitrage bid/ask prices
+        bool arbitrage = level_ptr->IsBid() ? (price <= level_ptr->Price) : (price >= level_ptr->Price);
+        if (!arbitrage)
+            return 0;
+
+        // Price level without 'All-Or-None' orders is consumed without the orders walk
+        if (level_ptr->AONOrders == 0)
+        {
+            volume_t need = volume - available;
+
+            // Matching is possible, return the chain size
+            if (level_ptr->TotalVolume >= need)
+                return volume;
+
+            available += level_ptr->TotalVolume;
+            order_ptr = nullptr;
+        }
+
+        // Travel through orders at current price levels
+        while (order_ptr != nullptr)
+        {
+            quantity_t need = (quantity_t)(volume - available);
+            quantity_t quantity = order_ptr->IsAON() ? order_ptr->LeavesQuantity : std::min(order_ptr->LeavesQuantity, need);
+            available += quantity;
+
+            // Matching is possible, return the chain size
+            if (volume == available)
+                return volume;
+
+            // Matching is not possible
+            if (volume < available)
+                return 0;
+
+            // Take the next order
+            order_ptr = order_ptr->next;
+        }
+
+        // Switch to the next price level
+        if (order_ptr == nullptr)
+        {
+            level_ptr = GetNextLevel(level_ptr);
+            if (level_ptr != nullptr)
+                order_ptr = level_ptr->OrderList.front();
+        }
+    }
+
+    // Matching is not available
+    return 0;
+}
+
+void OrderBook::ActivateStopLevel(LevelNode* level_ptr, OrderNodeList& orders)
+{
+    // Find the first order of the price level
+    OrderNode* first_order_ptr = level_ptr->OrderList.front();
+    assert((first_order_ptr != nullptr) && "Stop price level must contain orders!");
+
+    // Move all orders of the price level into the given list
+    OrderNode* order_ptr;
+    while ((order_ptr = level_ptr->OrderList.pop_front()) != nullptr)
+    {
+        // Materialize the stop price of the trailing stop order
+        MaterializeTrailingStopOrder(*order_ptr, *level_ptr);
+
+        // Clear the price level cache in the order (the first one is required to delete the price level)
+        if (order_ptr != first_order_ptr)
+            order_ptr->Level = nullptr;
+
+        orders.push_back(*order_ptr);
+    }
+
+    // Delete the empty price level and clear the price level cache in the first order
+    if (first_order_ptr->IsTrailingStop() || first_order_ptr->IsTrailingStopLimit())
+        first_order_ptr->Level = DeleteTrailingStopLevel(first_order_ptr);
+    else
+        first_order_ptr->Level = DeleteStopLevel(first_order_ptr);
+}
+
+price_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcept
+{
+    return CalculateTrailingStopPrice(order.IsBuy(), order.StopPrice, order.TrailingDistance, order.TrailingStep);
+}
+
+price_t OrderBook::CalculateTrailingStopPrice(const LevelNode& level) const noexcept
+{
+    // Trailing buy stop orders are kept in ask price levels
+    return CalculateTrailingStopPrice(level.IsAsk(), level.Price, level.TrailingDistance, level.TrailingStep);
+}
+
+price_t OrderBook::CalculateTrailingStopPrice(bool buy, price_t stop_price, int64_t trailing_distance, int64_t trailing_step) const noexcept
 {
     // Get the current market price
-    uint64_t market_price = order.IsBuy() ? GetMarketTrailingStopPriceAsk() : GetMarketTrailingStopPriceBid();
-    int64_t trailing_distance = order.TrailingDistance;
-    int64_t trailing_step = order.TrailingStep;
+    price_t market_price = buy ? GetMarketTrailingStopPriceAsk() : GetMarketTrailingStopPriceBid();
 
     // Convert percentage trailing values into absolute ones
     if (trailing_distance < 0)
@@ -491,12 +1126,12 @@ uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcep
         trailing_step = (int64_t)((-trailing_step * market_price) / 10000);
     }
 
-    uint64_t old_price = order.StopPrice;
+    price_t old_price = stop_price;
 
-    if (order.IsBuy())
+    if (buy)
     {
         // Calculate a new stop price
-        uint64_t new_price = (market_price < (std::numeric_limits<uint64_t>::max() - trailing_distance)) ? (market_price + trailing_distance) : std::numeric_limits<uint64_t>::max();
+        price_t new_price = (market_price < (std::numeric_limits<price_t>::max() - trailing_distance)) ? (market_price + trailing_distance) : std::numeric_limits<price_t>::max();
 
         // If the new price is better and we get through the trailing step
         if (new_price < old_price)
@@ -506,7 +1141,7 @@ uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcep
     else
     {
         // Calculate a new stop price
-        uint64_t new_price = (market_price > (uint64_t)trailing_distance) ? (market_price - trailing_distance) : 0;
+        price_t new_price = (market_price > (uint64_t)trailing_distance) ? (market_price - trailing_distance) : 0;
 
         // If the new price is better and we get through the trailing step
         if (new_price > old_price)
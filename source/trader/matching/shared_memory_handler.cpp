@@ -0,0 +1,113 @@
+/*!
+    \file shared_memory_handler.cpp
+    \brief Shared memory market handler implementation
+    \author Ivan Shynkarenka
+    \date 18.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/shared_memory_handler.h"
+
+namespace CppTrader {
+namespace Matching {
+
+namespace {
+
+// Shared memory block is aligned to the cache line inside
+const size_t ALIGNMENT = 64;
+
+void* Align(void* ptr)
+{
+    return (void*)(((uintptr_t)ptr + ALIGNMENT - 1) & ~(uintptr_t)(ALIGNMENT - 1));
+}
+
+} // namespace
+
+SharedMemoryHandler::SharedMemoryHandler(const std::string& name, size_t capacity)
+    : _shared_memory(name, MarketEventRing::Size(capacity) + ALIGNMENT),
+      _ring(Align(_shared_memory.ptr()), capacity)
+{
+}
+
+bool SharedMemoryHandler::PublishSnapshot(const MarketManager& market)
+{
+    // Calculate the snapshot size in events
+    size_t count = 0;
+    size_t size = 2 + market.orders().size();
+    for (auto order_book_ptr : market.order_books())
+    {
+        if (order_book_ptr != nullptr)
+        {
+            ++count;
+            size += 1 + order_book_ptr->bids().size() + order_book_ptr->asks().size();
+        }
+    }
+
+    // Snapshot must fit into the ring, otherwise consumers overrun it
+    if (size > _ring.capacity())
+        return false;
+
+    // Acknowledge all snapshot requests before the snapshot begins
+    _ring.AcknowledgeSnapshot();
+
+    _ring.Publish(MarketEvent::FromType(MarketEventType::SNAPSHOT_BEGIN, count));
+
+    for (auto order_book_ptr : market.order_books())
+    {
+        if (order_book_ptr == nullptr)
+            continue;
+
+        const OrderBook& order_book = *order_book_ptr;
+
+        _ring.Publish(MarketEvent::FromBook(MarketEventType::SNAPSHOT_BOOK, order_book, order_book.bids().size() + order_book.asks().size()));
+
+        // Publish bid price levels from the best to the worst one
+        for (auto it = order_book.bids().rbegin(); it != order_book.bids().rend(); ++it)
+            _ring.Publish(MarketEvent::FromLevel(MarketEventType::SNAPSHOT_LEVEL, order_book, *it, (&*it == order_book.best_bid())));
+
+        // Publish ask price levels from the best to the worst one
+        for (auto it = order_book.asks().begin(); it != order_book.asks().end(); ++it)
+            _ring.Publish(MarketEvent::FromLevel(MarketEventType::SNAPSHOT_LEVEL, order_book, *it, (&*it == order_book.best_ask())));
+
+        // Publish limit, stop and trailing stop orders
+        PublishSnapshotOrders(order_book.bids());
+        PublishSnapshotOrders(order_book.asks());
+        PublishSnapshotOrders(order_book.buy_stop());
+        PublishSnapshotOrders(order_book.sell_stop());
+        PublishSnapshotOrders(order_book.trailing_buy_stop());
+        PublishSnapshotOrders(order_book.trailing_sell_stop());
+
+        // Publish orders of the current batch
+        for (const OrderNode* order_ptr = order_book.batch_orders().front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+            _ring.Publish(MarketEvent::FromOrder(MarketEventType::SNAPSHOT_ORDER, *order_ptr, order_ptr->ExecutedQuantity));
+    }
+
+    _ring.Publish(MarketEvent::FromType(MarketEventType::SNAPSHOT_END));
+
+    return true;
+}
+
+void SharedMemoryHandler::PublishSnapshotOrders(const OrderBook::Levels& levels)
+{
+    // Publish orders of each price level in the order of their priority
+    for (const auto& level : levels)
+    {
+        for (const OrderNode* order_ptr = level.OrderList.front(); order_ptr != nullptr; order_ptr = order_ptr->next)
+        {
+            // Materialize the stop price of the trailing stop order
+            Order order = *order_ptr;
+            OrderBook::MaterializeTrailingStopOrder(order, level);
+
+            _ring.Publish(MarketEvent::FromOrder(MarketEventType::SNAPSHOT_ORDER, order, order_ptr->ExecutedQuantity));
+        }
+    }
+}
+
+SharedMemoryReader::SharedMemoryReader(const std::string& name, size_t capacity)
+    : _shared_memory(name, MarketEventRing::Size(capacity) + ALIGNMENT),
+      _reader(Align(_shared_memory.ptr()), capacity)
+{
+}
+
+} // namespace Matching
+} // namespace CppTrader
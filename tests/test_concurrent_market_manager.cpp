@@ -0,0 +1,143 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/concurrent_market_manager.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+namespace {
+
+class CountingMarketHandler : public MarketHandler
+{
+public:
+    std::atomic<uint64_t> add_orders{0};
+    std::atomic<uint64_t> delete_orders{0};
+    std::atomic<uint64_t> executions{0};
+
+protected:
+    void onAddOrder(const Order& order) override { ++add_orders; }
+    void onDeleteOrder(const Order& order) override { ++delete_orders; }
+    void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { ++executions; }
+};
+
+} // namespace
+
+TEST_CASE("Concurrent market manager", "[CppTrader][Matching]")
+{
+    CountingMarketHandler handler;
+    ConcurrentMarketManager market(handler, 16, 4);
+    market.EnableMatching();
+    REQUIRE(market.IsMatchingEnabled());
+
+    // Prepare symbols & order books
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        const char symbol_name[8] = "test";
+        Symbol symbol = { i, symbol_name };
+        REQUIRE(market.AddOrderBook(symbol) == ErrorCode::OK);
+        REQUIRE(market.AddOrderBook(symbol) == ErrorCode::ORDER_BOOK_DUPLICATE);
+    }
+
+    // Order Ids are unique across all order books
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 0, 10, 10)) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 1, 10, 10)) == ErrorCode::ORDER_DUPLICATE);
+    REQUIRE(market.AddOrder(Order::SellLimit(2, 1, 20, 10)) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::BuyLimit(3, 5, 10, 10)) == ErrorCode::ORDER_BOOK_NOT_FOUND);
+
+    // Order operations are routed by order Id
+    REQUIRE(market.ReduceOrder(1, 5) == ErrorCode::OK);
+    uint64_t leaves = 0;
+    REQUIRE(market.VisitOrder(1, [&](const Order& order) { leaves = order.LeavesQuantity; }) == ErrorCode::OK);
+    REQUIRE(leaves == 5);
+    REQUIRE(market.ReplaceOrder(2, 3, 21, 7) == ErrorCode::OK);
+    REQUIRE(market.DeleteOrder(2) == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(market.ReplaceOrder(3, 1, 21, 7) == ErrorCode::ORDER_DUPLICATE);
+    REQUIRE(market.ModifyOrder(3, 22, 8) == ErrorCode::OK);
+    size_t asks = 0;
+    REQUIRE(market.VisitOrderBook(1, [&](const OrderBook& order_book) { asks = order_book.asks().size(); }) == ErrorCode::OK);
+    REQUIRE(asks == 1);
+
+    // Executed orders are not routed any more
+    REQUIRE(market.AddOrder(Order::SellLimit(4, 0, 10, 5)) == ErrorCode::OK);
+    REQUIRE(market.DeleteOrder(1) == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(market.DeleteOrder(4) == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 1, 10, 10)) == ErrorCode::OK);
+
+    // Mass-cancel erases routes of deleted orders
+    Order owned = Order::BuyLimit(5, 0, 9, 10);
+    owned.OwnerId = 7;
+    REQUIRE(market.AddOrder(owned) == ErrorCode::OK);
+    REQUIRE(market.DeleteOwnerOrders(7) == ErrorCode::OK);
+    REQUIRE(market.DeleteOrder(5) == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(market.DeleteOrders(1) == ErrorCode::OK);
+    REQUIRE(market.DeleteOrder(1) == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(market.DeleteOrder(3) == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(market.AddOrder(Order::BuyLimit(3, 0, 10, 10)) == ErrorCode::OK);
+
+    // Deleted order book erases routes of its orders
+    REQUIRE(market.DeleteOrderBook(0) == ErrorCode::OK);
+    REQUIRE(market.DeleteOrderBook(0) == ErrorCode::ORDER_BOOK_NOT_FOUND);
+    REQUIRE(market.DeleteOrder(3) == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(market.AddOrder(Order::BuyLimit(3, 1, 10, 10)) == ErrorCode::OK);
+}
+
+TEST_CASE("Concurrent market manager threads", "[CppTrader][Matching]")
+{
+    const uint32_t symbols = 4;
+    const uint64_t count = 2000;
+
+    CountingMarketHandler handler;
+    ConcurrentMarketManager market(handler, symbols);
+    market.EnableMatching();
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        const char symbol_name[8] = "test";
+        Symbol symbol = { i, symbol_name };
+        market.AddOrderBook(symbol);
+    }
+
+    // Each thread trades its own symbol and looks up orders of other ones
+    std::atomic<uint64_t> errors(0);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        threads.emplace_back([&, i]()
+        {
+            uint64_t base = (i + 1) * 1000000;
+            for (uint64_t j = 0; j < count; ++j)
+            {
+                uint64_t id = base + j * 3;
+                if (market.AddOrder(Order::BuyLimit(id, i, 100, 10)) != ErrorCode::OK)
+                    ++errors;
+                if (market.AddOrder(Order::SellLimit(id + 1, i, 100, 4)) != ErrorCode::OK)
+                    ++errors;
+                if (market.ModifyOrder(id, 99, 6) != ErrorCode::OK)
+                    ++errors;
+                if (market.AddOrder(Order::SellLimit(id + 2, i, 99, 6)) != ErrorCode::OK)
+                    ++errors;
+                // Order of another symbol might be already executed
+                market.VisitOrder(((i + 1) % symbols + 1) * 1000000 + j * 3, [](const Order& order) {});
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(errors == 0);
+    REQUIRE(handler.add_orders == (symbols * count * 3));
+    REQUIRE(handler.delete_orders == (symbols * count * 3));
+    REQUIRE(handler.executions == (symbols * count * 4));
+    for (uint32_t i = 0; i < symbols; ++i)
+    {
+        size_t levels = 1;
+        market.VisitOrderBook(i, [&](const OrderBook& order_book) { levels = order_book.bids().size() + order_book.asks().size(); });
+        REQUIRE(levels == 0);
+    }
+}
@@ -0,0 +1,96 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/conflation_handler.h"
+#include "trader/matching/market_manager.h"
+
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+namespace {
+
+class TestConflationHandler : public ConflationHandler
+{
+public:
+    using ConflationHandler::ConflationHandler;
+
+    std::vector<MarketEvent> events;
+
+protected:
+    void onConflatedEvent(const MarketEvent& event) override { events.push_back(event); }
+};
+
+} // namespace
+
+TEST_CASE("Conflation handler", "[CppTrader][Matching]")
+{
+    TestConflationHandler handler(1000);
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Publish the net state of many level updates
+    for (uint64_t i = 1; i <= 10; ++i)
+        market.AddOrder(Order::BuyLimit(i, 0, 10, 1));
+    market.AddOrder(Order::SellLimit(11, 0, 20, 5));
+    REQUIRE(handler.dirty() == 1);
+    REQUIRE(handler.Flush(500) == 0);
+    REQUIRE(handler.Flush(1000) == 3);
+    REQUIRE(handler.dirty() == 0);
+    REQUIRE(handler.events.size() == 3);
+    REQUIRE(handler.events[0].Type == MarketEventType::ADD_ORDER_BOOK);
+    REQUIRE(handler.events[1].Type == MarketEventType::ADD_LEVEL);
+    REQUIRE(handler.events[1].Side == OrderSide::BUY);
+    REQUIRE(handler.events[1].Price == 10);
+    REQUIRE(handler.events[1].Quantity == 10);
+    REQUIRE(handler.events[1].Value == 10);
+    REQUIRE(handler.events[2].Type == MarketEventType::ADD_LEVEL);
+    REQUIRE(handler.events[2].Side == OrderSide::SELL);
+    REQUIRE(handler.events[2].Quantity == 5);
+    handler.events.clear();
+
+    // Changes cancelled out inside the interval are never published
+    market.AddOrder(Order::BuyLimit(12, 0, 11, 1));
+    market.DeleteOrder(12);
+    market.AddOrder(Order::BuyLimit(13, 0, 10, 1));
+    market.DeleteOrder(13);
+    REQUIRE(handler.dirty() == 1);
+    REQUIRE(handler.Flush() == 0);
+    REQUIRE(handler.events.empty());
+
+    // Publish updated and deleted price levels
+    market.DeleteOrder(1);
+    market.ReduceOrder(2, 1);
+    market.DeleteOrder(11);
+    REQUIRE(handler.Flush() == 2);
+    REQUIRE(handler.events.size() == 2);
+    REQUIRE(handler.events[0].Type == MarketEventType::UPDATE_LEVEL);
+    REQUIRE(handler.events[0].Quantity == 8);
+    REQUIRE(handler.events[0].Value == 8);
+    REQUIRE(handler.events[1].Type == MarketEventType::DELETE_LEVEL);
+    REQUIRE(handler.events[1].Price == 20);
+    handler.events.clear();
+
+    // Publish the order book deletion without its price levels
+    market.DeleteOrderBook(0);
+    REQUIRE(handler.Flush() == 1);
+    REQUIRE(handler.events.size() == 1);
+    REQUIRE(handler.events[0].Type == MarketEventType::DELETE_ORDER_BOOK);
+    handler.events.clear();
+
+    // Order book added and deleted inside the interval is never published
+    market.AddOrderBook(symbol);
+    market.AddOrder(Order::SellLimit(14, 0, 30, 1));
+    market.DeleteOrderBook(0);
+    REQUIRE(handler.Flush() == 0);
+    REQUIRE(handler.events.empty());
+}
@@ -0,0 +1,225 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_manager.h"
+
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+TEST_CASE("Epoch manager", "[CppTrader][Matching]")
+{
+    EpochManager epochs(2);
+    REQUIRE(epochs.readers() == 2);
+
+    size_t reader1 = epochs.RegisterReader();
+    size_t reader2 = epochs.RegisterReader();
+    REQUIRE(reader1 != EpochManager::INVALID_READER);
+    REQUIRE(reader2 != EpochManager::INVALID_READER);
+    REQUIRE(epochs.RegisterReader() == EpochManager::INVALID_READER);
+
+    // Without active readers all retired nodes could be recycled
+    uint64_t epoch = epochs.epoch();
+    REQUIRE(epochs.Synchronize() > epoch);
+    REQUIRE(epochs.epoch() == (epoch + 1));
+
+    // Active reader keeps its epoch observed
+    epoch = epochs.epoch();
+    epochs.Enter(reader1);
+    REQUIRE(epochs.Synchronize() == epoch);
+    REQUIRE(epochs.epoch() == (epoch + 1));
+    {
+        EpochGuard guard(epochs, reader2);
+        REQUIRE(epochs.Synchronize() == epoch);
+        REQUIRE(epochs.epoch() == (epoch + 1));
+    }
+    epochs.Leave(reader1);
+    REQUIRE(epochs.Synchronize() > (epoch + 1));
+
+    // Free reader slot could be registered again
+    epochs.UnregisterReader(reader2);
+    REQUIRE(epochs.RegisterReader() == reader2);
+}
+
+TEST_CASE("Market manager epoch-based reclamation", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableMatching();
+    REQUIRE(!market.IsReclamationEnabled());
+    market.EnableReclamation(4, 1000000);
+    REQUIRE(market.IsReclamationEnabled());
+    EpochManager& epochs = *market.epochs();
+
+    // Prepare symbol & order book
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.AddOrder(Order::BuyLimit(1, 0, 10, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 11, 20));
+
+    size_t reader = epochs.RegisterReader();
+    REQUIRE(reader != EpochManager::INVALID_READER);
+
+    // Deleted order and price level are retired while the reader is active
+    epochs.Enter(reader);
+    const Order* order_ptr = market.GetOrder(2);
+    const Level* level_ptr = market.GetOrderBook(0)->best_bid();
+    REQUIRE(level_ptr->Price == 11);
+    market.DeleteOrder(2);
+    for (uint64_t i = 3; i < 100; ++i)
+        market.AddOrder(Order::BuyLimit(i, 0, 20 + i, 1));
+    REQUIRE(market.Reclaim() == 0);
+    REQUIRE(order_ptr->Id == 2);
+    REQUIRE(order_ptr->Price == 11);
+    REQUIRE(level_ptr->Price == 11);
+    epochs.Leave(reader);
+
+    // Retired nodes are recycled after the reader leaves
+    REQUIRE(market.Reclaim() == 2);
+    REQUIRE(market.Reclaim() == 0);
+
+    // Deleted order book is retired with its price levels
+    epochs.Enter(reader);
+    const OrderBook* order_book_ptr = market.GetOrderBook(0);
+    market.DeleteOrderBook(0);
+    REQUIRE(market.GetOrderBook(0) == nullptr);
+    REQUIRE(order_book_ptr->symbol().Id == 0);
+    REQUIRE(market.Reclaim() == 0);
+    epochs.Leave(reader);
+    REQUIRE(market.Reclaim() > 0);
+    epochs.UnregisterReader(reader);
+}
+
+TEST_CASE("Market manager reclamation with a stalled reader", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableReclamation(4, 4);
+    EpochManager& epochs = *market.epochs();
+
+    // Prepare symbol & order book
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    for (uint64_t i = 1; i <= 20; ++i)
+        market.AddOrder(Order::BuyLimit(i, 0, 10, 1));
+
+    size_t reader = epochs.RegisterReader();
+
+    // Stalled reader keeps all retired orders
+    epochs.Enter(reader);
+    for (uint64_t i = 1; i <= 10; ++i)
+        market.DeleteOrder(i);
+    epochs.Leave(reader);
+
+    // Automatic reclamation is re-armed after the non-productive one instead of running on each retirement
+    market.DeleteOrder(11);
+    REQUIRE(market.Reclaim() == 11);
+
+    // Automatic reclamation is triggered again after the threshold retirements
+    for (uint64_t i = 12; i <= 15; ++i)
+        market.DeleteOrder(i);
+    REQUIRE(market.Reclaim() == 0);
+
+    epochs.UnregisterReader(reader);
+}
+
+TEST_CASE("Market manager best bid and offer readers", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableReclamation(4, 16);
+    EpochManager& epochs = *market.epochs();
+
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+
+    // Reader thread reads the best bid and offer block of the order book deleted concurrently
+    std::atomic<const BBOBlock*> shared(nullptr);
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> errors(0);
+    std::thread reader([&]()
+    {
+        size_t reader = epochs.RegisterReader();
+        while (!stop.load())
+        {
+            EpochGuard guard(epochs, reader);
+            const BBOBlock* block = shared.load();
+            if ((block != nullptr) && (block->Read().BidVolume > 10))
+                ++errors;
+        }
+        epochs.UnregisterReader(reader);
+    });
+
+    for (uint64_t i = 1; i <= 1000; ++i)
+    {
+        market.AddOrderBook(symbol);
+        market.EnableOrderBookBBO(0);
+        market.AddOrder(Order::BuyLimit(i, 0, 10, 10));
+        shared.store(market.GetOrderBook(0)->bbo());
+        shared.store(nullptr);
+        market.DeleteOrderBook(0);
+    }
+
+    stop = true;
+    reader.join();
+    REQUIRE(errors == 0);
+}
+
+TEST_CASE("Epoch manager reader threads", "[CppTrader][Matching]")
+{
+    EpochManager epochs(4);
+
+    // Writer recycles the node only when no reader could observe it
+    std::atomic<std::atomic<uint64_t>*> shared(new std::atomic<uint64_t>(0));
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> errors(0);
+
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        readers.emplace_back([&]()
+        {
+            size_t reader = epochs.RegisterReader();
+            while (!stop.load())
+            {
+                EpochGuard guard(epochs, reader);
+                const std::atomic<uint64_t>* value_ptr = shared.load();
+                if (value_ptr->load() == 0xDEADDEADDEADDEADull)
+                    ++errors;
+            }
+            epochs.UnregisterReader(reader);
+        });
+    }
+
+    std::deque<std::pair<uint64_t, std::atomic<uint64_t>*>> retired;
+    for (uint64_t i = 1; i <= 10000; ++i)
+    {
+        std::atomic<uint64_t>* old_ptr = shared.exchange(new std::atomic<uint64_t>(i));
+        retired.emplace_back(epochs.epoch(), old_ptr);
+        uint64_t oldest = epochs.Synchronize();
+        while (!retired.empty() && (retired.front().first < oldest))
+        {
+            retired.front().second->store(0xDEADDEADDEADDEADull);
+            delete retired.front().second;
+            retired.pop_front();
+        }
+    }
+
+    stop = true;
+    for (auto& thread : readers)
+        thread.join();
+
+    for (const auto& node : retired)
+        delete node.second;
+    delete shared.load();
+
+    REQUIRE(errors == 0);
+}
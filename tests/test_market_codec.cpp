@@ -0,0 +1,306 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_codec.h"
+#include "trader/matching/market_manager.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+namespace {
+
+class TestMarketEncoder : public MarketEncoder
+{
+public:
+    using MarketEncoder::MarketEncoder;
+
+    std::vector<uint8_t> stream;
+    size_t frames = 0;
+
+protected:
+    void onEncodedFrame(const void* buffer, size_t size) override
+    {
+        const uint8_t* data = (const uint8_t*)buffer;
+        stream.insert(stream.end(), data, data + size);
+        ++frames;
+    }
+};
+
+class TestMarketDecoder : public MarketDecoder
+{
+public:
+    std::vector<MarketEvent> events;
+
+protected:
+    void onDecodedEvent(const MarketEvent& event) override { events.push_back(event); }
+};
+
+class TestMarketEventHandler : public MarketEventHandler<TestMarketEventHandler>
+{
+public:
+    std::vector<MarketEvent> events;
+    size_t book_updates = 0;
+
+    void onMarketEvent(const MarketEvent& event) { events.push_back(event); }
+
+protected:
+    void onUpdateOrderBook(const OrderBook& order_book, bool top) override
+    {
+        MarketEventHandler<TestMarketEventHandler>::onUpdateOrderBook(order_book, top);
+        ++book_updates;
+    }
+};
+
+size_t Count(const std::vector<MarketEvent>& events, MarketEventType type)
+{
+    size_t count = 0;
+    for (const auto& event : events)
+        if (event.Type == type)
+            ++count;
+    return count;
+}
+
+bool Equal(const MarketEvent& event1, const MarketEvent& event2)
+{
+    return std::memcmp(&event1, &event2, sizeof(MarketEvent)) == 0;
+}
+
+} // namespace
+
+TEST_CASE("Market codec", "[CppTrader][Matching]")
+{
+    TestMarketEncoder encoder(64);
+
+    // Encode market events of different types and symbols
+    std::vector<MarketEvent> events;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        MarketEvent event = MarketEvent::FromType((MarketEventType)(1 + (i % (uint64_t)MarketEventType::UPDATE_AUCTION)));
+        event.Side = (i % 3) ? OrderSide::BUY : OrderSide::SELL;
+        event.SymbolId = (uint32_t)(i % 7);
+        switch (event.Type)
+        {
+            case MarketEventType::ADD_ORDER_BOOK:
+            case MarketEventType::DELETE_ORDER_BOOK:
+            case MarketEventType::SNAPSHOT_END:
+                break;
+            case MarketEventType::ADD_LEVEL:
+            case MarketEventType::UPDATE_LEVEL:
+            case MarketEventType::DELETE_LEVEL:
+            case MarketEventType::SNAPSHOT_LEVEL:
+                event.Top = (i % 2) != 0;
+                event.Price = 1000 + (i * 37) % 100;
+                event.Quantity = 500 + i;
+                event.Visible = 100 + i;
+                event.Value = i % 10;
+                break;
+            case MarketEventType::ADD_ORDER:
+            case MarketEventType::UPDATE_ORDER:
+            case MarketEventType::DELETE_ORDER:
+            case MarketEventType::SNAPSHOT_ORDER:
+            case MarketEventType::REPLACE_ORDER:
+                event.Id = 1000000 + i * 3;
+                event.Price = 1000 - (i * 13) % 100;
+                event.Quantity = i;
+                event.Visible = i / 2;
+                event.Value = (event.Type == MarketEventType::REPLACE_ORDER) ? (1000000 + i) : i * 2;
+                break;
+            case MarketEventType::EXECUTE_ORDER:
+                event.Id = 2000000 - i;
+                event.Price = 0xFFFFFFFFFFFFFFFFull - i;
+                event.Quantity = i;
+                event.Value = i * 5;
+                break;
+            case MarketEventType::DELETE_ORDERS:
+                event.Quantity = 1000 * i;
+                event.Value = i;
+                break;
+            case MarketEventType::ADD_SYMBOL:
+            case MarketEventType::DELETE_SYMBOL:
+                event.Value = 0x0074736574000000ull + i;
+                break;
+            case MarketEventType::UPDATE_AUCTION:
+                event.Price = 1000 + i;
+                event.Quantity = 10 * i;
+                event.Visible = 10 * i + (i % 4);
+                event.Value = 10 * i + (i % 5);
+                break;
+            default:
+                event.Value = i;
+                break;
+        }
+        events.push_back(event);
+        encoder.Encode(event);
+    }
+    encoder.Flush();
+    REQUIRE(encoder.sequence() == 100);
+    REQUIRE(encoder.frames > 1);
+    REQUIRE(encoder.bytes() == encoder.stream.size());
+    REQUIRE(encoder.stream.size() < (events.size() * sizeof(MarketEvent) / 3));
+
+    // Decode the stream in small chunks
+    TestMarketDecoder decoder;
+    size_t offset = 0;
+    for (size_t end = 0; end <= encoder.stream.size(); end += 7)
+        offset += decoder.Decode(encoder.stream.data() + offset, end - offset);
+    offset += decoder.Decode(encoder.stream.data() + offset, encoder.stream.size() - offset);
+    REQUIRE(offset == encoder.stream.size());
+    REQUIRE(decoder.sequence() == 100);
+    REQUIRE(decoder.gaps() == 0);
+    REQUIRE(decoder.events.size() == events.size());
+    for (size_t i = 0; i < events.size(); ++i)
+        REQUIRE(Equal(decoder.events[i], events[i]));
+}
+
+TEST_CASE("Market codec order book rebuild", "[CppTrader][Matching]")
+{
+    TestMarketEncoder encoder(256);
+    MarketManager market(encoder);
+    market.EnableMatching();
+
+    // Prepare symbols & order books
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        const char symbol_name[8] = "test";
+        Symbol symbol = { i, symbol_name };
+        market.AddSymbol(symbol);
+        market.AddOrderBook(symbol);
+    }
+
+    // Run the market session
+    uint64_t id = 1;
+    for (uint64_t i = 0; i < 300; ++i)
+    {
+        uint32_t symbol = (uint32_t)(i % 3);
+        market.AddOrder(Order::BuyLimit(id++, symbol, 100 - (i % 10), 10 + (i % 7)));
+        market.AddOrder(Order::SellLimit(id++, symbol, 101 + (i % 10), 10 + (i % 5)));
+        if ((i % 11) == 0)
+            market.AddOrder(Order::SellLimit(id++, symbol, 95, 30));
+        if ((i % 13) == 0)
+            market.DeleteOrder(id - 2);
+        if (((i % 17) == 0) && (market.GetOrder(id - 1) != nullptr))
+        {
+            market.ReplaceOrder(id - 1, id, 105, 3);
+            ++id;
+        }
+    }
+    market.DeleteOrders(1, OrderSide::BUY, 95, 98);
+    market.DeleteOrders(2);
+    encoder.Flush();
+
+    // Rebuild order books from the encoded stream
+    TestMarketDecoder decoder;
+    REQUIRE(decoder.Decode(encoder.stream.data(), encoder.stream.size()) == encoder.stream.size());
+    REQUIRE(decoder.gaps() == 0);
+    REQUIRE(decoder.sequence() == encoder.sequence());
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        const OrderBook* order_book_ptr = market.GetOrderBook(i);
+        const DecodedOrderBook* decoded_ptr = decoder.GetOrderBook(i);
+        REQUIRE(order_book_ptr != nullptr);
+        REQUIRE(decoded_ptr != nullptr);
+        REQUIRE(decoded_ptr->Bids.size() == order_book_ptr->bids().size());
+        REQUIRE(decoded_ptr->Asks.size() == order_book_ptr->asks().size());
+        for (const auto& level : order_book_ptr->bids())
+        {
+            auto it = decoded_ptr->Bids.find(level.Price);
+            REQUIRE(it != decoded_ptr->Bids.end());
+            REQUIRE(it->second.Volume == level.TotalVolume);
+            REQUIRE(it->second.Visible == level.VisibleVolume);
+            REQUIRE(it->second.Orders == level.Orders);
+        }
+        for (const auto& level : order_book_ptr->asks())
+        {
+            auto it = decoded_ptr->Asks.find(level.Price);
+            REQUIRE(it != decoded_ptr->Asks.end());
+            REQUIRE(it->second.Volume == level.TotalVolume);
+        }
+        size_t orders = 0;
+        for (const auto& level : order_book_ptr->bids())
+            orders += level.Orders;
+        for (const auto& level : order_book_ptr->asks())
+            orders += level.Orders;
+        REQUIRE(decoded_ptr->Orders.size() == orders);
+        for (const auto& order : decoded_ptr->Orders)
+            REQUIRE(market.GetOrder(order.first) != nullptr);
+    }
+    REQUIRE(decoder.GetOrderBook(2)->Orders.empty());
+}
+
+TEST_CASE("Market codec symbols and auction", "[CppTrader][Matching]")
+{
+    TestMarketEncoder encoder(256);
+    MarketManager market(encoder);
+
+    // Prepare symbol & order book in the call auction mode
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 1, symbol_name };
+    REQUIRE(market.AddSymbol(symbol) == ErrorCode::OK);
+    REQUIRE(market.AddOrderBook(symbol) == ErrorCode::OK);
+    REQUIRE(market.EnableOrderBookAuction(1) == ErrorCode::OK);
+
+    // Collect crossed orders
+    market.AddOrder(Order::BuyLimit(1, 1, 105, 20));
+    market.AddOrder(Order::BuyLimit(2, 1, 100, 30));
+    market.AddOrder(Order::SellLimit(3, 1, 95, 15));
+    market.AddOrder(Order::SellLimit(4, 1, 100, 10));
+    encoder.Flush();
+
+    // Decode symbol and auction events
+    TestMarketDecoder decoder;
+    REQUIRE(decoder.Decode(encoder.stream.data(), encoder.stream.size()) == encoder.stream.size());
+    REQUIRE(decoder.gaps() == 0);
+    REQUIRE(Count(decoder.events, MarketEventType::ADD_SYMBOL) == 1);
+    REQUIRE(Count(decoder.events, MarketEventType::UPDATE_AUCTION) == 5);
+    REQUIRE(decoder.events[0].Type == MarketEventType::ADD_SYMBOL);
+    REQUIRE(decoder.events[0].SymbolId == 1);
+    REQUIRE(std::memcmp(&decoder.events[0].Value, symbol_name, sizeof(symbol_name)) == 0);
+
+    // Check the decoded indicative auction state
+    Auction auction = market.GetOrderBook(1)->GetAuction();
+    const DecodedOrderBook* decoded_ptr = decoder.GetOrderBook(1);
+    REQUIRE(decoded_ptr != nullptr);
+    REQUIRE(auction.Volume > 0);
+    REQUIRE(decoded_ptr->Auction.Price == auction.Price);
+    REQUIRE(decoded_ptr->Auction.Volume == auction.Volume);
+    REQUIRE(decoded_ptr->Auction.BidVolume == auction.BidVolume);
+    REQUIRE(decoded_ptr->Auction.AskVolume == auction.AskVolume);
+
+    // Delete the symbol
+    REQUIRE(market.DeleteOrderBook(1) == ErrorCode::OK);
+    REQUIRE(market.DeleteSymbol(1) == ErrorCode::OK);
+    encoder.Flush();
+    decoder.events.clear();
+    REQUIRE(decoder.Decode(encoder.stream.data(), encoder.stream.size()) > 0);
+    REQUIRE(Count(decoder.events, MarketEventType::DELETE_SYMBOL) == 1);
+}
+
+TEST_CASE("Market event handler drops order book updates", "[CppTrader][Matching]")
+{
+    TestMarketEventHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Each order book update is already represented by the price level event
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 100, 20));
+    market.AddOrder(Order::SellLimit(3, 0, 101, 10));
+    market.AddOrder(Order::SellLimit(4, 0, 100, 15));
+    market.DeleteOrder(2);
+    size_t levels = Count(handler.events, MarketEventType::ADD_LEVEL) + Count(handler.events, MarketEventType::UPDATE_LEVEL) + Count(handler.events, MarketEventType::DELETE_LEVEL);
+    REQUIRE(handler.book_updates > 0);
+    REQUIRE(handler.book_updates == levels);
+    REQUIRE(Count(handler.events, MarketEventType::NONE) == 0);
+}
@@ -0,0 +1,124 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_command_queue.h"
+
+#include <thread>
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+TEST_CASE("Market command queue", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    MarketCommandQueue queue(4, 2, 2, 8);
+    REQUIRE(queue.capacity() == 4);
+    REQUIRE(queue.producers() == 2);
+
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Producer in-flight commands are limited with its completion ring
+    REQUIRE(queue.Enqueue(0, MarketCommand::AddOrder(Order::BuyLimit(1, 0, 10, 10), 100)));
+    REQUIRE(queue.Enqueue(0, MarketCommand::AddOrder(Order::BuyLimit(1, 0, 10, 10), 101)));
+    REQUIRE(!queue.Enqueue(0, MarketCommand::ReduceOrder(1, 5, 102)));
+
+    // Commands ring capacity is shared by all producers
+    REQUIRE(queue.Enqueue(1, MarketCommand::ReduceOrder(1, 5, 200)));
+    REQUIRE(queue.Enqueue(1, MarketCommand::ExecuteOrder(1, 0, 2, 201)));
+
+    MarketCompletion completion;
+    REQUIRE(!queue.Dequeue(0, completion));
+
+    // Partial drain applies commands in the enqueue order
+    REQUIRE(queue.Drain(market, 3) == 3);
+    REQUIRE(queue.Drain(market) == 1);
+    REQUIRE(queue.Drain(market) == 0);
+
+    REQUIRE(queue.Dequeue(0, completion));
+    REQUIRE((completion.Tag == 100 && completion.Id == 1 && completion.Result == ErrorCode::OK));
+    REQUIRE(queue.Dequeue(0, completion));
+    REQUIRE((completion.Tag == 101 && completion.Result == ErrorCode::ORDER_DUPLICATE));
+    REQUIRE(!queue.Dequeue(0, completion));
+    REQUIRE(queue.Dequeue(1, completion));
+    REQUIRE((completion.Tag == 200 && completion.Type == MarketCommandType::REDUCE_ORDER && completion.Result == ErrorCode::OK));
+    REQUIRE(queue.Dequeue(1, completion));
+    REQUIRE((completion.Tag == 201 && completion.Result == ErrorCode::OK));
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 3);
+
+    // Invalid commands are completed with errors instead of being applied
+    REQUIRE(queue.Enqueue(0, MarketCommand::AddOrder(Order::BuyLimit(2, 5, 10, 10))));
+    REQUIRE(queue.Enqueue(0, MarketCommand::DeleteOrder(3)));
+    REQUIRE(queue.Enqueue(1, MarketCommand::ReplaceOrder(1, 4, 11, 5)));
+    REQUIRE(queue.Enqueue(1, MarketCommand::ModifyOrder(4, 12, 6)));
+    REQUIRE(queue.Drain(market) == 4);
+    REQUIRE((queue.Dequeue(0, completion) && completion.Result == ErrorCode::ORDER_BOOK_NOT_FOUND));
+    REQUIRE((queue.Dequeue(0, completion) && completion.Result == ErrorCode::ORDER_NOT_FOUND));
+    REQUIRE((queue.Dequeue(1, completion) && completion.Result == ErrorCode::OK));
+    REQUIRE((queue.Dequeue(1, completion) && completion.Result == ErrorCode::OK));
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(4)->Price == 12);
+}
+
+TEST_CASE("Market command queue with concurrent producers", "[CppTrader][Matching]")
+{
+    const size_t producers = 4;
+    const uint64_t commands = 10000;
+
+    MarketManager market;
+    MarketCommandQueue queue(1024, producers, 64);
+
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Each producer adds and deletes its own orders
+    std::vector<uint64_t> failures(producers, 0);
+    std::vector<std::thread> threads;
+    for (size_t producer = 0; producer < producers; ++producer)
+    {
+        threads.emplace_back([&queue, &failures, producer, commands]()
+        {
+            uint64_t sent = 0;
+            uint64_t completed = 0;
+            uint64_t next = 0;
+            MarketCompletion completion;
+            while (completed < (2 * commands))
+            {
+                if (sent < (2 * commands))
+                {
+                    uint64_t id = 1 + producer + producers * (sent / 2);
+                    MarketCommand command = ((sent % 2) == 0)
+                        ? MarketCommand::AddOrder(Order::BuyLimit(id, 0, 10 + (id % 16), 10), sent)
+                        : MarketCommand::DeleteOrder(id, sent);
+                    if (queue.Enqueue(producer, command))
+                        ++sent;
+                }
+                while (queue.Dequeue(producer, completion))
+                {
+                    if ((completion.Tag != next++) || (completion.Result != ErrorCode::OK))
+                        ++failures[producer];
+                    ++completed;
+                }
+            }
+        });
+    }
+
+    // Market manager thread drains until all completions are delivered
+    uint64_t applied = 0;
+    while (applied < (producers * 2 * commands))
+        applied += queue.Drain(market);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t producer = 0; producer < producers; ++producer)
+        REQUIRE(failures[producer] == 0);
+    REQUIRE(market.GetOrderBook(0)->bids().empty());
+}
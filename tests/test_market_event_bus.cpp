@@ -0,0 +1,109 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_event_bus.h"
+#include "trader/matching/market_manager.h"
+
+#include <thread>
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+TEST_CASE("Market event bus", "[CppTrader][Matching]")
+{
+    MarketEventBus bus(8);
+    MarketEventBusConsumer& journal = bus.AddConsumer();
+    MarketEventBusConsumer& publisher = bus.AddConsumer({ &journal });
+    REQUIRE(bus.consumers().size() == 2);
+
+    std::vector<uint64_t> values;
+    auto handler = [&values](const MarketEvent& event) { values.push_back(event.Value); };
+
+    // Dependent consumer waits for its dependencies
+    for (uint64_t i = 1; i <= 5; ++i)
+        bus.Publish(MarketEvent::FromType(MarketEventType::ADD_ORDER, i));
+    REQUIRE(bus.sequence() == 5);
+    REQUIRE(journal.available() == 5);
+    REQUIRE(publisher.available() == 0);
+    REQUIRE(publisher.Poll(handler) == 0);
+
+    // Consume the batch with the limit
+    REQUIRE(journal.Poll(handler, 3) == 3);
+    REQUIRE(journal.sequence() == 3);
+    REQUIRE(publisher.available() == 3);
+    REQUIRE(publisher.Poll(handler) == 3);
+    REQUIRE(journal.Poll(handler) == 2);
+    REQUIRE(publisher.Poll(handler) == 2);
+    REQUIRE(values == std::vector<uint64_t>({ 1, 2, 3, 1, 2, 3, 4, 5, 4, 5 }));
+    REQUIRE(journal.Poll(handler) == 0);
+
+    // Market manager publishes market events into the bus
+    MarketEventBus market_bus(64);
+    MarketEventBusConsumer& consumer = market_bus.AddConsumer();
+    MarketManager market(market_bus);
+    market.EnableMatching();
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.AddOrder(Order::BuyLimit(1, 0, 99, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 99, 4));
+    std::vector<MarketEventType> types;
+    consumer.Poll([&types](const MarketEvent& event) { types.push_back(event.Type); });
+    std::vector<MarketEventType> expected = {
+        MarketEventType::ADD_SYMBOL, MarketEventType::ADD_ORDER_BOOK,
+        MarketEventType::ADD_ORDER, MarketEventType::ADD_LEVEL,
+        MarketEventType::ADD_ORDER,
+        MarketEventType::EXECUTE_ORDER, MarketEventType::UPDATE_ORDER, MarketEventType::UPDATE_LEVEL,
+        MarketEventType::EXECUTE_ORDER, MarketEventType::DELETE_ORDER
+    };
+    REQUIRE(types == expected);
+}
+
+TEST_CASE("Market event bus consumer threads", "[CppTrader][Matching]")
+{
+    const uint64_t count = 100000;
+
+    // Small ring makes the publisher wait for the slowest consumer
+    MarketEventBus bus(16);
+    MarketEventBusConsumer& first = bus.AddConsumer();
+    MarketEventBusConsumer& second = bus.AddConsumer();
+    MarketEventBusConsumer& third = bus.AddConsumer({ &first, &second });
+
+    std::vector<std::thread> threads;
+    std::vector<uint64_t> sums(3, 0);
+    std::vector<int> ordered(3, 1);
+    MarketEventBusConsumer* consumers[3] = { &first, &second, &third };
+    for (size_t i = 0; i < 3; ++i)
+    {
+        threads.emplace_back([&, i]()
+        {
+            MarketEventBusConsumer& consumer = *consumers[i];
+            uint64_t expected = 1;
+            while (consumer.sequence() < count)
+            {
+                consumer.Poll([&](const MarketEvent& event)
+                {
+                    if (event.Value != expected++)
+                        ordered[i] = 0;
+                    sums[i] += event.Value;
+                });
+            }
+        });
+    }
+
+    for (uint64_t i = 1; i <= count; ++i)
+        bus.Publish(MarketEvent::FromType(MarketEventType::ADD_ORDER, i));
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        REQUIRE(ordered[i] == 1);
+        REQUIRE(sums[i] == (count * (count + 1) / 2));
+    }
+}
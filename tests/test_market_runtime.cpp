@@ -0,0 +1,78 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_command_queue.h"
+#include "trader/matching/market_runtime.h"
+
+#include <thread>
+
+using namespace CppTrader::Matching;
+
+TEST_CASE("Market runtime", "[CppTrader][Matching]")
+{
+    const uint64_t orders = 10000;
+
+    MarketManager market;
+    MarketCommandQueue queue(1024, 1, 256);
+
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    MarketRuntime runtime;
+    REQUIRE(!runtime.running());
+    REQUIRE(runtime.priority() == 1);
+
+    // Gateway thread enqueues commands and takes their completions
+    std::atomic<uint64_t> completed(0);
+    uint64_t sent = 0;
+    size_t gateway = runtime.AddThread("gateway", MarketRuntime::ANY_CORE, [&]()
+    {
+        size_t work = 0;
+        if ((sent < (2 * orders)) && queue.Enqueue(0, ((sent % 2) == 0) ? MarketCommand::AddOrder(Order::BuyLimit(1 + sent / 2, 0, 10, 10)) : MarketCommand::DeleteOrder(1 + sent / 2)))
+        {
+            ++sent;
+            ++work;
+        }
+        MarketCompletion completion;
+        while (queue.Dequeue(0, completion))
+        {
+            if (completion.Result == ErrorCode::OK)
+                completed.fetch_add(1, std::memory_order_release);
+            ++work;
+        }
+        return work;
+    });
+
+    // Engine thread is pinned to the first core
+    size_t engine = runtime.AddThread("engine", 0, [&]() { return queue.Drain(market); });
+    REQUIRE(runtime.threads() == 2);
+
+    REQUIRE(runtime.Start());
+    REQUIRE(!runtime.Start());
+    while (completed.load(std::memory_order_acquire) < (2 * orders))
+        std::this_thread::yield();
+
+    // Statistics of the idle engine thread are published while the runtime is running
+    while (runtime.stats(engine).Work < (2 * orders))
+        std::this_thread::yield();
+    REQUIRE(runtime.running());
+    REQUIRE(runtime.Stop());
+    REQUIRE(!runtime.Stop());
+
+    RuntimeStats stats = runtime.stats(engine);
+    REQUIRE(stats.Work == (2 * orders));
+    REQUIRE(stats.BusyLoops > 0);
+    REQUIRE(stats.Loops == (stats.BusyLoops + stats.IdleLoops));
+    REQUIRE(!stats.Realtime);
+    REQUIRE(runtime.stats(gateway).Work >= (4 * orders));
+    REQUIRE(!runtime.stats(gateway).Pinned);
+    REQUIRE(market.GetOrderBook(0)->bids().empty());
+
+    // Invalid real-time priority is rejected
+    REQUIRE(!MarketRuntime::SetRealtime(1000));
+}
@@ -0,0 +1,160 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_sequencer.h"
+
+#include <thread>
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+namespace {
+
+class RecordingMarketSequencer : public MarketSequencer
+{
+public:
+    using MarketSequencer::MarketSequencer;
+
+    std::vector<uint64_t> tags;
+    std::vector<ErrorCode> results;
+    std::vector<std::vector<uint8_t>> journal;
+
+protected:
+    void onSequencedCommand(uint64_t sequence, size_t stream, const MarketCommand& command, ErrorCode result) override
+    {
+        REQUIRE(sequence == tags.size());
+        REQUIRE(stream == command.Producer);
+        tags.push_back(command.Tag);
+        results.push_back(result);
+    }
+
+    void onMergeJournal(const void* buffer, size_t size) override
+    {
+        const uint8_t* data = (const uint8_t*)buffer;
+        journal.emplace_back(data, data + size);
+    }
+};
+
+void PrepareMarket(MarketManager& market)
+{
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+}
+
+} // namespace
+
+TEST_CASE("Market sequencer", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    PrepareMarket(market);
+
+    RecordingMarketSequencer sequencer(2, MergePolicy::TIMESTAMP, 4, 8);
+    REQUIRE(sequencer.streams() == 2);
+    REQUIRE(sequencer.policy() == MergePolicy::TIMESTAMP);
+
+    // Streams are merged by command timestamps
+    REQUIRE(sequencer.Enqueue(0, MarketCommand::AddOrder(Order::BuyLimit(1, 0, 10, 10), 1), 100));
+    REQUIRE(sequencer.Enqueue(0, MarketCommand::DeleteOrder(2, 3), 300));
+    REQUIRE(sequencer.Enqueue(1, MarketCommand::AddOrder(Order::BuyLimit(2, 0, 11, 10), 2), 200));
+    REQUIRE(sequencer.Enqueue(1, MarketCommand::ReduceOrder(1, 5, 4), 300));
+    REQUIRE(sequencer.Enqueue(1, MarketCommand::ReduceOrder(1, 2, 5), 400));
+    REQUIRE(sequencer.Enqueue(1, MarketCommand::DeleteOrder(2, 6), 500));
+    REQUIRE(!sequencer.Enqueue(1, MarketCommand::DeleteOrder(2, 7), 600));
+
+    REQUIRE(sequencer.Sequence(market) == 6);
+    REQUIRE(sequencer.sequence() == 6);
+    REQUIRE(sequencer.Sequence(market) == 0);
+    REQUIRE(sequencer.tags == std::vector<uint64_t>({ 1, 2, 3, 4, 5, 6 }));
+    REQUIRE(sequencer.results.back() == ErrorCode::ORDER_NOT_FOUND);
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 3);
+
+    // Merge journal contains (stream, count) runs of the batch
+    REQUIRE(sequencer.journal.size() == 1);
+    REQUIRE(sequencer.journal[0] == std::vector<uint8_t>({ 0, 1, 1, 1, 0, 1, 1, 3 }));
+
+    // Malformed journal is rejected
+    const uint8_t malformed[] = { 5, 1 };
+    REQUIRE(!sequencer.Replay(malformed, sizeof(malformed)));
+    REQUIRE(!sequencer.replaying());
+}
+
+TEST_CASE("Market sequencer replay", "[CppTrader][Matching]")
+{
+    const size_t streams = 3;
+    const uint64_t orders = 2000;
+
+    // Each stream adds, reduces and deletes its own orders in the shared price range
+    auto command = [](size_t stream, uint64_t index)
+    {
+        uint64_t id = 1 + stream + streams * (index / 3);
+        uint64_t tag = (stream << 32) | index;
+        switch (index % 3)
+        {
+            case 0:
+                return ((id % 2) == 0)
+                    ? MarketCommand::AddOrder(Order::BuyLimit(id, 0, 100 + (id % 7), 10), tag)
+                    : MarketCommand::AddOrder(Order::SellLimit(id, 0, 100 + (id % 7), 10), tag);
+            case 1:
+                return MarketCommand::ReduceOrder(id, 1, tag);
+            default:
+                return MarketCommand::DeleteOrder(id, tag);
+        }
+    };
+
+    // Live run merges concurrent gateway streams in arrival order
+    MarketManager live_market;
+    PrepareMarket(live_market);
+    live_market.EnableMatching();
+    RecordingMarketSequencer live(streams, MergePolicy::ARRIVAL, 256, 16);
+
+    std::vector<std::thread> threads;
+    for (size_t stream = 0; stream < streams; ++stream)
+    {
+        threads.emplace_back([&live, &command, stream, orders]()
+        {
+            for (uint64_t index = 0; index < (3 * orders); )
+                if (live.Enqueue(stream, command(stream, index)))
+                    ++index;
+        });
+    }
+
+    while (live.sequence() < (streams * 3 * orders))
+        live.Sequence(live_market);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    // Replay the same streams with the recorded merge journal
+    MarketManager replay_market;
+    PrepareMarket(replay_market);
+    replay_market.EnableMatching();
+    RecordingMarketSequencer replay(streams, MergePolicy::ARRIVAL, 8 * 1024, 64);
+
+    for (size_t stream = 0; stream < streams; ++stream)
+        for (uint64_t index = 0; index < (3 * orders); ++index)
+            REQUIRE(replay.Enqueue(stream, command(stream, index)));
+    for (const auto& buffer : live.journal)
+        REQUIRE(replay.Replay(buffer.data(), buffer.size()));
+    REQUIRE(replay.replaying());
+
+    while (replay.Sequence(replay_market) > 0);
+    REQUIRE(!replay.replaying());
+
+    REQUIRE(replay.sequence() == live.sequence());
+    REQUIRE(replay.tags == live.tags);
+    REQUIRE(replay.results == live.results);
+    REQUIRE(replay_market.GetOrderBook(0)->bids().size() == live_market.GetOrderBook(0)->bids().size());
+    REQUIRE(replay_market.GetOrderBook(0)->asks().size() == live_market.GetOrderBook(0)->asks().size());
+
+    // Sequencer continues with live merging after the journal is over
+    REQUIRE(replay.Enqueue(1, MarketCommand::AddOrder(Order::BuyLimit(1000000, 0, 50, 10), 42)));
+    REQUIRE(replay.Sequence(replay_market) == 1);
+    REQUIRE(replay.sequence() == (live.sequence() + 1));
+    REQUIRE(replay.tags.back() == 42);
+    REQUIRE(replay_market.GetOrder(1000000) != nullptr);
+}
@@ -6,6 +6,10 @@
 
 #include "trader/matching/market_manager.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace CppCommon;
 using namespace CppTrader::Matching;
 
@@ -79,6 +83,30 @@ std::pair<int, int> BookStopOrders(const OrderBook* order_book_ptr)
     return std::make_pair(buy_orders, sell_orders);
 }
 
+bool BookDepthValid(const OrderBook* order_book_ptr)
+{
+    if (order_book_ptr == nullptr)
+        return false;
+
+    const Depth& bid_depth = order_book_ptr->bid_depth();
+    size_t bid_index = 0;
+    for (auto it = order_book_ptr->bids().rbegin(); (it != order_book_ptr->bids().rend()) && (bid_index < bid_depth.capacity()); ++it, ++bid_index)
+        if ((bid_index >= bid_depth.size()) || (bid_depth.prices()[bid_index] != it->Price) || (bid_depth.total_volumes()[bid_index] != it->TotalVolume) || (bid_depth.visible_volumes()[bid_index] != it->VisibleVolume) || (bid_depth.orders()[bid_index] != it->Orders))
+            return false;
+    if (bid_index != bid_depth.size())
+        return false;
+
+    const Depth& ask_depth = order_book_ptr->ask_depth();
+    size_t ask_index = 0;
+    for (auto it = order_book_ptr->asks().begin(); (it != order_book_ptr->asks().end()) && (ask_index < ask_depth.capacity()); ++it, ++ask_index)
+        if ((ask_index >= ask_depth.size()) || (ask_depth.prices()[ask_index] != it->Price) || (ask_depth.total_volumes()[ask_index] != it->TotalVolume) || (ask_depth.visible_volumes()[ask_index] != it->VisibleVolume) || (ask_depth.orders()[ask_index] != it->Orders))
+            return false;
+    if (ask_index != ask_depth.size())
+        return false;
+
+    return true;
+}
+
 std::pair<int, int> BookStopVolume(const OrderBook* order_book_ptr)
 {
     if (order_book_ptr == nullptr)
@@ -394,6 +422,41 @@ TEST_CASE("Automatic matching - 'All-Or-None' limit order complex matching", "[C
     REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
 }
 
+TEST_CASE("Automatic matching - 'All-Or-None' limit order parked at the top of the book", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Park huge 'All-Or-None' order at the top of the book
+    market.AddOrder(Order::BuyLimit(1, 0, 20, 100, OrderTimeInForce::AON));
+    for (uint64_t i = 2; i < 7; ++i)
+        market.AddOrder(Order::SellLimit(i, 0, 20, 10));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 5));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(100, 50));
+
+    // Not enough volume to fill the 'All-Or-None' order
+    market.AddOrder(Order::SellLimit(7, 0, 20, 30, OrderTimeInForce::AON));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 6));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(100, 80));
+
+    // Manual matching without any order book changes
+    market.Match();
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 6));
+
+    // Automatic matching 'All-Or-None' order
+    market.AddOrder(Order::SellLimit(8, 0, 20, 20));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+}
+
 TEST_CASE("Automatic matching - 'Hidden' limit order", "[CppTrader][Matching]")
 {
     MarketManager market;
@@ -630,6 +693,179 @@ TEST_CASE("Automatic matching - trailing stop order", "[CppTrader][Matching]")
     REQUIRE(market.GetOrder(5)->StopPrice == 190);
 }
 
+TEST_CASE("Automatic matching - many trailing stop orders", "[CppTrader][Matching]")
+{
+    class TrailingHandler : public MarketHandler
+    {
+    public:
+        size_t updates = 0;
+
+    protected:
+        void onUpdateOrder(const Order& order) override { if (order.IsTrailingStop()) ++updates; }
+    };
+
+    TrailingHandler handler;
+    MarketManager market(handler);
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Create the market with last prices
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 20));
+    market.AddOrder(Order::SellLimit(2, 0, 200, 20));
+    market.AddOrder(Order::SellMarket(3, 0, 10));
+    market.AddOrder(Order::BuyMarket(4, 0, 10));
+
+    // Add trailing sell stop orders with different distances
+    for (uint64_t i = 0; i < 20; ++i)
+        market.AddOrder(Order::TrailingSellStop(10 + i, 0, 0, 10, 10 + (int64_t)(i % 5)));
+    for (uint64_t i = 0; i < 20; ++i)
+        REQUIRE(market.GetOrder(10 + i)->StopPrice == 90 - (i % 5));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 20));
+
+    // Move the market best bid price level
+    market.ModifyOrder(1, 150, 20);
+    for (uint64_t i = 0; i < 20; ++i)
+        REQUIRE(market.GetOrder(10 + i)->StopPrice == 140 - (i % 5));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 20));
+    REQUIRE(BookStopVolume(market.GetOrderBook(0)) == std::make_pair(0, 200));
+
+    // Trailing stop orders are grouped into one price level per trailing distance
+    REQUIRE(market.GetOrderBook(0)->trailing_sell_stop().size() == 5);
+
+    // Market moves reprice trailing stop price levels without updating each order
+    REQUIRE(handler.updates == 0);
+
+    // Market moves in the wrong direction do not reprice trailing stop orders
+    market.ModifyOrder(1, 145, 20);
+    market.ModifyOrder(1, 151, 20);
+    REQUIRE(handler.updates == 0);
+    for (uint64_t i = 0; i < 20; ++i)
+        REQUIRE(market.GetOrder(10 + i)->StopPrice == 141 - (i % 5));
+    REQUIRE(market.GetOrderBook(0)->trailing_sell_stop().size() == 5);
+}
+
+TEST_CASE("Automatic matching - trailing stop price levels merge", "[CppTrader][Matching]")
+{
+    class TrailingHandler : public MarketHandler
+    {
+    public:
+        size_t updates = 0;
+        std::vector<std::pair<uint64_t, uint64_t>> activated;
+
+    protected:
+        void onUpdateOrder(const Order& order) override
+        {
+            if (order.IsTrailingStopLimit())
+                ++updates;
+            else if (order.IsLimit() && (order.Id >= 10))
+                activated.emplace_back(order.Id, order.Price);
+        }
+    };
+
+    TrailingHandler handler;
+    MarketManager market(handler);
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Create the market with last prices
+    market.AddOrder(Order::BuyLimit(1, 0, 150, 20));
+    market.AddOrder(Order::SellLimit(2, 0, 200, 20));
+    market.AddOrder(Order::SellMarket(3, 0, 10));
+    market.AddOrder(Order::BuyMarket(4, 0, 10));
+
+    // Add trailing sell stop-limit orders with the same trailing distance and different initial stop prices
+    market.AddOrder(Order::TrailingSellStopLimit(10, 0, 140, 135, 10, 10));
+    market.AddOrder(Order::TrailingSellStopLimit(11, 0, 145, 140, 10, 10));
+    REQUIRE(market.GetOrder(10)->StopPrice == 140);
+    REQUIRE(market.GetOrder(11)->StopPrice == 145);
+    REQUIRE(market.GetOrderBook(0)->trailing_sell_stop().size() == 2);
+
+    // Move the market up, both price levels are repriced to the same stop price and merged
+    market.ModifyOrder(1, 160, 20);
+    REQUIRE(market.GetOrderBook(0)->trailing_sell_stop().size() == 1);
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 2));
+    REQUIRE(BookStopVolume(market.GetOrderBook(0)) == std::make_pair(0, 20));
+    REQUIRE(market.GetOrder(10)->StopPrice == 150);
+    REQUIRE(market.GetOrder(10)->Price == 145);
+    REQUIRE(market.GetOrder(11)->StopPrice == 150);
+    REQUIRE(market.GetOrder(11)->Price == 145);
+    REQUIRE(handler.updates == 0);
+
+    // Activate trailing stop-limit orders with their materialized limit prices
+    market.ModifyOrder(1, 100, 20);
+    REQUIRE(market.GetOrderBook(0)->trailing_sell_stop().size() == 0);
+    REQUIRE(handler.activated.size() == 2);
+    REQUIRE(handler.activated[0].first == 11);
+    REQUIRE(handler.activated[1].first == 10);
+    REQUIRE(handler.activated[0].second == 145);
+    REQUIRE(handler.activated[1].second == 145);
+}
+
+TEST_CASE("Automatic matching - stop orders cascade", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Add limit orders
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 99, 10));
+    market.AddOrder(Order::BuyLimit(3, 0, 98, 10));
+    market.AddOrder(Order::BuyLimit(4, 0, 97, 10));
+    market.AddOrder(Order::BuyLimit(5, 0, 96, 10));
+    market.AddOrder(Order::BuyLimit(6, 0, 95, 10));
+    market.AddOrder(Order::BuyLimit(7, 0, 90, 100));
+
+    // Add sell stop orders at several stop price levels
+    market.AddOrder(Order::SellStop(10, 0, 99, 10));
+    market.AddOrder(Order::SellStop(11, 0, 99, 10));
+    market.AddOrder(Order::SellStop(12, 0, 99, 10));
+    market.AddOrder(Order::SellStop(13, 0, 96, 10));
+    market.AddOrder(Order::SellStop(14, 0, 96, 10));
+    market.AddOrder(Order::SellStop(15, 0, 50, 10));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(7, 0));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 6));
+    REQUIRE(BookStopVolume(market.GetOrderBook(0)) == std::make_pair(0, 60));
+
+    // Market prices do not reach stop price levels
+    market.AddOrder(Order::SellLimit(20, 0, 110, 10));
+    market.AddOrder(Order::BuyLimit(21, 0, 100, 10));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(8, 1));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 6));
+    REQUIRE(BookStopVolume(market.GetOrderBook(0)) == std::make_pair(0, 60));
+
+    // Automatic matching with market order activates stop orders in cascade
+    market.AddOrder(Order::SellMarket(22, 0, 20));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(100, 10));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 1));
+    REQUIRE(BookStopVolume(market.GetOrderBook(0)) == std::make_pair(0, 10));
+    for (uint64_t id = 10; id <= 14; ++id)
+        REQUIRE(market.GetOrder(id) == nullptr);
+    REQUIRE(market.GetOrder(15) != nullptr);
+}
+
 TEST_CASE("In-Flight Mitigation", "[CppTrader][Matching]")
 {
     MarketManager market;
@@ -713,3 +949,1233 @@ TEST_CASE("Manual matching", "[CppTrader][Matching]")
     REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 4));
     REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(60, 65));
 }
+
+TEST_CASE("Price and quantity types narrowing", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Unlimited max visible quantity and slippage are saturated
+    Order order = Order::BuyLimit(1, 0, 10, 10);
+    REQUIRE(!order.IsIceberg());
+    REQUIRE(!order.IsSlippage());
+    REQUIRE(SaturatePrice(std::numeric_limits<uint64_t>::max()) == std::numeric_limits<price_t>::max());
+    REQUIRE(SaturateQuantity(std::numeric_limits<uint64_t>::max()) == std::numeric_limits<quantity_t>::max());
+
+    // Regular values are valid
+    REQUIRE(IsValidPrice(std::numeric_limits<uint32_t>::max() - 1));
+    REQUIRE(IsValidQuantity(std::numeric_limits<uint32_t>::max() - 1));
+    REQUIRE(market.AddOrder(order) == ErrorCode::OK);
+    REQUIRE(market.ModifyOrder(1, 20, 20) == ErrorCode::OK);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(20, 0));
+}
+
+TEST_CASE("Price level volume aggregates", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    REQUIRE(market.EnableOrderBookDepth(0, 4) == ErrorCode::OK);
+    REQUIRE(market.EnableOrderBookBBO(0) == ErrorCode::OK);
+
+    // Level volumes exceed the largest order quantity even with compact types
+    const uint64_t quantity = std::numeric_limits<uint32_t>::max() - 1;
+    for (uint64_t id = 1; id <= 3; ++id)
+        REQUIRE(market.AddOrder(Order::BuyLimit(id, 0, 10, quantity)) == ErrorCode::OK);
+    const OrderBook* order_book_ptr = market.GetOrderBook(0);
+    REQUIRE(order_book_ptr->best_bid()->TotalVolume == (3 * quantity));
+    REQUIRE(order_book_ptr->best_bid()->VisibleVolume == (3 * quantity));
+    REQUIRE(order_book_ptr->GetCumulativeBidVolume(10) == (3 * quantity));
+    REQUIRE(order_book_ptr->bid_depth().total_volumes()[0] == (3 * quantity));
+    REQUIRE(order_book_ptr->bbo()->Read().BidVolume == (3 * quantity));
+
+    // Matching chains are calculated over 64-bit level volumes
+    REQUIRE(market.AddOrder(Order::SellLimit(4, 0, 10, quantity, OrderTimeInForce::AON)) == ErrorCode::OK);
+    REQUIRE(order_book_ptr->best_bid()->TotalVolume == (2 * quantity));
+    REQUIRE(market.AddOrder(Order::SellLimit(5, 0, 10, quantity, OrderTimeInForce::FOK)) == ErrorCode::OK);
+    REQUIRE(order_book_ptr->best_bid()->TotalVolume == quantity);
+    REQUIRE(order_book_ptr->bbo()->Read().BidVolume == quantity);
+}
+
+TEST_CASE("Order book depth", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Add some orders before enabling the depth
+    market.AddOrder(Order::BuyLimit(1, 0, 10, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 20, 10));
+    market.AddOrder(Order::SellLimit(3, 0, 30, 10));
+    REQUIRE(!market.GetOrderBook(0)->bid_depth());
+    REQUIRE(market.EnableOrderBookDepth(0, 4) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->bid_depth().size() == 2);
+    REQUIRE(market.GetOrderBook(0)->ask_depth().size() == 1);
+    REQUIRE(BookDepthValid(market.GetOrderBook(0)));
+
+    // Perform pseudo-random operations and validate the depth after each one
+    uint64_t seed = 1;
+    uint64_t id = 4;
+    for (int i = 0; i < 2000; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t random = seed >> 33;
+        uint64_t price = 10 + (random % 16);
+        uint64_t quantity = 1 + ((random >> 8) % 10);
+        uint64_t target = 1 + ((random >> 16) % (id - 1));
+        switch (random % 5)
+        {
+            case 0:
+                market.AddOrder(Order::BuyLimit(id++, 0, price, quantity, OrderTimeInForce::GTC, quantity / 2));
+                break;
+            case 1:
+                market.AddOrder(Order::SellLimit(id++, 0, price + 10, quantity));
+                break;
+            case 2:
+                if (market.GetOrder(target) != nullptr)
+                    market.ReduceOrder(target, 1);
+                break;
+            case 3:
+                if (market.GetOrder(target) != nullptr)
+                    market.DeleteOrder(target);
+                break;
+            case 4:
+                market.AddOrder(Order::Market(id++, 0, ((random >> 4) & 1) ? OrderSide::BUY : OrderSide::SELL, quantity));
+                break;
+        }
+        REQUIRE(BookDepthValid(market.GetOrderBook(0)));
+    }
+
+    // Copy the depth
+    price_t prices[4];
+    volume_t volumes[4];
+    size_t count = market.GetOrderBook(0)->bid_depth().Copy(prices, volumes, nullptr, nullptr, 4);
+    REQUIRE(count == market.GetOrderBook(0)->bid_depth().size());
+    for (size_t i = 0; i < count; ++i)
+        REQUIRE(market.GetOrderBook(0)->GetBid(prices[i])->TotalVolume == volumes[i]);
+
+    // Disable the depth
+    REQUIRE(market.DisableOrderBookDepth(0) == ErrorCode::OK);
+    REQUIRE(!market.GetOrderBook(0)->bid_depth());
+    REQUIRE(market.GetOrderBook(0)->bid_depth().empty());
+}
+
+TEST_CASE("Order book cumulative volume", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Perform pseudo-random operations and validate cumulative volumes after each one
+    uint64_t seed = 7;
+    uint64_t id = 1;
+    for (int i = 0; i < 3000; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t random = seed >> 33;
+        uint64_t price = 10 + (random % 40);
+        uint64_t quantity = 1 + ((random >> 8) % 10);
+        switch (random % 4)
+        {
+            case 0:
+                market.AddOrder(Order::BuyLimit(id++, 0, price, quantity));
+                break;
+            case 1:
+                market.AddOrder(Order::SellLimit(id++, 0, price + 30, quantity));
+                break;
+            case 2:
+            case 3:
+            {
+                uint64_t target = (id > 1) ? (1 + ((random >> 16) % (id - 1))) : 1;
+                if (market.GetOrder(target) != nullptr)
+                {
+                    if (random & 0x100)
+                        market.ReduceOrder(target, 1);
+                    else
+                        market.DeleteOrder(target);
+                }
+                break;
+            }
+        }
+
+        const OrderBook* order_book_ptr = market.GetOrderBook(0);
+        for (price_t p = 5; p < 85; p += 3)
+        {
+            uint64_t bid_volume = 0;
+            size_t bid_orders = 0;
+            for (const auto& bid : order_book_ptr->bids())
+            {
+                if (bid.Price >= p)
+                {
+                    bid_volume += bid.TotalVolume;
+                    bid_orders += bid.Orders;
+                }
+            }
+            REQUIRE(order_book_ptr->GetCumulativeBidVolume(p) == bid_volume);
+            REQUIRE(order_book_ptr->GetCumulativeBidOrders(p) == bid_orders);
+
+            uint64_t ask_volume = 0;
+            size_t ask_orders = 0;
+            for (const auto& ask : order_book_ptr->asks())
+            {
+                if (ask.Price <= p)
+                {
+                    ask_volume += ask.TotalVolume;
+                    ask_orders += ask.Orders;
+                }
+            }
+            REQUIRE(order_book_ptr->GetCumulativeAskVolume(p) == ask_volume);
+            REQUIRE(order_book_ptr->GetCumulativeAskOrders(p) == ask_orders);
+        }
+
+        for (uint64_t volume = 1; volume < 200; volume += 7)
+        {
+            const LevelNode* bid_ptr = nullptr;
+            uint64_t bid_volume = 0;
+            for (auto it = order_book_ptr->bids().rbegin(); it != order_book_ptr->bids().rend(); ++it)
+            {
+                bid_volume += it->TotalVolume;
+                if (bid_volume >= volume)
+                {
+                    bid_ptr = it.operator->();
+                    break;
+                }
+            }
+            REQUIRE(order_book_ptr->GetBidForVolume(volume) == bid_ptr);
+
+            const LevelNode* ask_ptr = nullptr;
+            uint64_t ask_volume = 0;
+            for (const auto& ask : order_book_ptr->asks())
+            {
+                ask_volume += ask.TotalVolume;
+                if (ask_volume >= volume)
+                {
+                    ask_ptr = &ask;
+                    break;
+                }
+            }
+            REQUIRE(order_book_ptr->GetAskForVolume(volume) == ask_ptr);
+        }
+    }
+}
+
+TEST_CASE("Order book sweep simulation", "[CppTrader][Matching]")
+{
+    class ExecutionHandler : public MarketHandler
+    {
+    public:
+        uint64_t id = 0;
+        uint64_t quantity = 0;
+        uint64_t notional = 0;
+
+    protected:
+        void onExecuteOrder(const Order& order, uint64_t price, uint64_t qty) override
+        {
+            if (order.Id == id)
+            {
+                quantity += qty;
+                notional += price * qty;
+            }
+        }
+    };
+
+    ExecutionHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Empty order book
+    Sweep sweep = market.SimulateOrder(Order::BuyMarket(1, 0, 10));
+    REQUIRE(sweep.Quantity == 0);
+    REQUIRE(sweep.Leftover == 10);
+    REQUIRE(!sweep.Fillable);
+
+    // Add limit orders with hidden and 'All-Or-None' volume
+    market.AddOrder(Order::SellLimit(1, 0, 10, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 10, 20, OrderTimeInForce::GTC, 5));
+    market.AddOrder(Order::SellLimit(3, 0, 20, 30));
+    market.AddOrder(Order::SellLimit(4, 0, 30, 40, OrderTimeInForce::AON));
+    market.AddOrder(Order::SellLimit(5, 0, 30, 10));
+
+    // Simulate market order and collect matched price levels
+    size_t levels = 0;
+    sweep = market.GetOrderBook(0)->SimulateOrder(Order::BuyMarket(10, 0, 50), [&levels](const LevelNode& level, price_t price, uint64_t quantity)
+    {
+        REQUIRE(level.Price == price);
+        REQUIRE(quantity == ((levels++ == 0) ? 30 : 20));
+    });
+    REQUIRE(levels == 2);
+    REQUIRE(sweep.Levels == 2);
+    REQUIRE(sweep.Quantity == 50);
+    REQUIRE(sweep.Leftover == 0);
+    REQUIRE(sweep.Notional == 30 * 10 + 20 * 20);
+    REQUIRE(sweep.BestPrice == 10);
+    REQUIRE(sweep.WorstPrice == 20);
+    REQUIRE(sweep.AveragePrice() == 14.0);
+    REQUIRE(sweep.Fillable);
+
+    // Resting 'All-Or-None' order stops the matching
+    sweep = market.SimulateOrder(Order::BuyLimit(10, 0, 30, 80, OrderTimeInForce::IOC));
+    REQUIRE(sweep.Quantity == 60);
+    REQUIRE(sweep.Leftover == 20);
+    REQUIRE(!sweep.Fillable);
+    sweep = market.SimulateOrder(Order::BuyLimit(10, 0, 30, 100, OrderTimeInForce::FOK));
+    REQUIRE(sweep.Quantity == 100);
+    REQUIRE(sweep.Notional == 30 * 100);
+    REQUIRE(sweep.Fillable);
+    sweep = market.SimulateOrder(Order::BuyLimit(10, 0, 30, 115, OrderTimeInForce::FOK));
+    REQUIRE(sweep.Quantity == 0);
+    REQUIRE(sweep.Leftover == 115);
+    REQUIRE(!sweep.Fillable);
+
+    // Simulation does not change the order book
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 5));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 110));
+
+    // Compare simulations with the real matching of pseudo-random orders
+    uint64_t seed = 3;
+    uint64_t id = 100;
+    for (int i = 0; i < 3000; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t random = seed >> 33;
+        uint64_t price = 10 + (random % 20);
+        uint64_t quantity = 1 + ((random >> 8) % 20);
+        OrderSide side = ((random >> 5) & 1) ? OrderSide::BUY : OrderSide::SELL;
+        switch (random % 6)
+        {
+            case 0:
+                market.AddOrder(Order::BuyLimit(id++, 0, price, quantity, OrderTimeInForce::GTC, quantity / 3));
+                break;
+            case 1:
+                market.AddOrder(Order::SellLimit(id++, 0, price + 15, quantity, OrderTimeInForce::GTC, quantity / 3));
+                break;
+            case 2:
+                market.AddOrder(Order::Limit(id++, 0, side, side == OrderSide::BUY ? price : price + 15, quantity, OrderTimeInForce::AON));
+                break;
+            default:
+            {
+                static const OrderTimeInForce tifs[] = { OrderTimeInForce::IOC, OrderTimeInForce::FOK };
+                Order order = ((random >> 6) & 1) ?
+                    Order::Market(id++, 0, side, quantity * 3, (random >> 7) % 5) :
+                    Order::Limit(id++, 0, side, price + 8, quantity * 3, tifs[(random >> 7) & 1]);
+
+                // Simulate the order
+                sweep = market.SimulateOrder(order);
+                REQUIRE(sweep.Quantity + sweep.Leftover == order.Quantity);
+
+                // Execute the order
+                handler.id = order.Id;
+                handler.quantity = 0;
+                handler.notional = 0;
+                market.AddOrder(order);
+                REQUIRE(handler.quantity == sweep.Quantity);
+                REQUIRE(handler.notional == sweep.Notional);
+                break;
+            }
+        }
+    }
+}
+
+TEST_CASE("Call auction", "[CppTrader][Matching]")
+{
+    class AuctionHandler : public MarketHandler
+    {
+    public:
+        size_t updates = 0;
+        Auction auction;
+        uint64_t executed = 0;
+
+    protected:
+        void onUpdateAuction(const OrderBook& order_book, const Auction& indicative) override { ++updates; auction = indicative; }
+        void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { executed += quantity; }
+    };
+
+    AuctionHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable the call auction mode
+    REQUIRE(market.EnableOrderBookAuction(0) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->IsAuction());
+    REQUIRE(handler.updates == 1);
+    REQUIRE(handler.auction.Volume == 0);
+
+    // Collect crossed orders without matching
+    market.AddOrder(Order::BuyLimit(1, 0, 110, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 105, 20));
+    market.AddOrder(Order::BuyLimit(3, 0, 100, 30));
+    market.AddOrder(Order::BuyLimit(4, 0, 105, 50, OrderTimeInForce::AON));
+    market.AddOrder(Order::SellLimit(5, 0, 95, 15));
+    market.AddOrder(Order::SellLimit(6, 0, 100, 10));
+    market.AddOrder(Order::SellLimit(7, 0, 105, 20));
+    market.AddOrder(Order::SellLimit(8, 0, 115, 10));
+    market.AddOrder(Order::BuyMarket(9, 0, 100));
+    REQUIRE(handler.executed == 0);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(4, 4));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(110, 55));
+
+    // Check the indicative auction state
+    Auction auction = market.GetOrderBook(0)->GetAuction();
+    REQUIRE(auction.Price == 105);
+    REQUIRE(auction.Volume == 30);
+    REQUIRE(auction.BidVolume == 30);
+    REQUIRE(auction.AskVolume == 45);
+    REQUIRE(auction.Imbalance() == -15);
+    REQUIRE(handler.updates == 9);
+    REQUIRE(handler.auction.Price == auction.Price);
+    REQUIRE(handler.auction.Volume == auction.Volume);
+
+    // Manual matching skips the order book in the call auction mode
+    market.Match();
+    REQUIRE(handler.executed == 0);
+
+    // Uncross the order book
+    REQUIRE(market.UncrossOrderBook(0) == ErrorCode::OK);
+    REQUIRE(!market.GetOrderBook(0)->IsAuction());
+    REQUIRE(handler.executed == 2 * 30);
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(2) == nullptr);
+    REQUIRE(market.GetOrder(5) == nullptr);
+    REQUIRE(market.GetOrder(6) == nullptr);
+    REQUIRE(market.GetOrder(7)->LeavesQuantity == 15);
+    REQUIRE(market.GetOrder(7)->ExecutedQuantity == 5);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(2, 2));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(80, 25));
+
+    // Continuous matching is resumed after the uncross
+    market.AddOrder(Order::SellLimit(10, 0, 100, 35));
+    REQUIRE(handler.executed == 2 * 30 + 2 * 50);
+    REQUIRE(market.GetOrder(4) == nullptr);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+    REQUIRE(handler.updates == 9);
+}
+
+TEST_CASE("Batch auction", "[CppTrader][Matching]")
+{
+    class BatchHandler : public MarketHandler
+    {
+    public:
+        uint64_t executed = 0;
+        uint64_t price = 0;
+
+    protected:
+        void onExecuteOrder(const Order& order, uint64_t execution_price, uint64_t quantity) override { executed += quantity; price = execution_price; }
+    };
+
+    BatchHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable the batch auction mode
+    REQUIRE(market.EnableOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->IsBatch());
+
+    // Accumulate orders of the first batch
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 99, 5));
+    market.AddOrder(Order::SellLimit(3, 0, 101, 5));
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 10);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+
+    // Match the first batch at the uniform clearing price
+    REQUIRE(market.MatchOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(handler.executed == 2 * 5);
+    REQUIRE(handler.price == 100);
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 5);
+    REQUIRE(market.GetOrder(2) == nullptr);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(5, 5));
+
+    // Match the second batch with the resting orders
+    market.AddOrder(Order::SellLimit(4, 0, 100, 3));
+    market.AddOrder(Order::BuyLimit(5, 0, 98, 10));
+    REQUIRE(handler.executed == 2 * 5);
+    REQUIRE(market.MatchOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(handler.executed == 2 * 5 + 2 * 3);
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 2);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(2, 1));
+
+    // Empty batch changes nothing
+    REQUIRE(market.MatchOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(handler.executed == 2 * 5 + 2 * 3);
+
+    // Disable the batch auction mode with the pending batch
+    market.AddOrder(Order::SellLimit(6, 0, 100, 1));
+    REQUIRE(market.DisableOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(!market.GetOrderBook(0)->IsBatch());
+    REQUIRE(handler.executed == 2 * 5 + 2 * 3 + 2 * 1);
+
+    // Continuous matching is resumed
+    market.AddOrder(Order::SellLimit(7, 0, 100, 1));
+    REQUIRE(handler.executed == 2 * 5 + 2 * 3 + 2 * 1 + 2 * 1);
+    REQUIRE(market.GetOrder(1) == nullptr);
+}
+
+TEST_CASE("Batch auction orders", "[CppTrader][Matching]")
+{
+    class BatchHandler : public MarketHandler
+    {
+    public:
+        uint64_t added = 0;
+        uint64_t deleted = 0;
+        uint64_t executed = 0;
+
+    protected:
+        void onAddOrder(const Order& order) override { ++added; }
+        void onDeleteOrder(const Order& order) override { ++deleted; }
+        void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { executed += quantity; }
+    };
+
+    BatchHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    REQUIRE(market.EnableOrderBookBatch(0) == ErrorCode::OK);
+
+    // Duplicate orders of the current batch are rejected
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 0, 100, 10)) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::BuyLimit(1, 0, 101, 10)) == ErrorCode::ORDER_DUPLICATE);
+    REQUIRE(market.GetOrder(1)->Price == 100);
+    REQUIRE(handler.added == 2);
+    REQUIRE(handler.deleted == 1);
+
+    // Orders which could not be priced or partially filled by the auction are rejected
+    REQUIRE(market.AddOrder(Order::BuyMarket(2, 0, 10)) == ErrorCode::ORDER_TYPE_INVALID);
+    REQUIRE(market.AddOrder(Order::SellLimit(2, 0, 100, 10, OrderTimeInForce::FOK)) == ErrorCode::ORDER_PARAMETER_INVALID);
+    REQUIRE(market.AddOrder(Order::SellLimit(2, 0, 100, 10, OrderTimeInForce::AON)) == ErrorCode::ORDER_PARAMETER_INVALID);
+    REQUIRE(market.GetOrder(2) == nullptr);
+
+    // Orders of the current batch could be changed before the batch is matched
+    REQUIRE(market.AddOrder(Order::SellLimit(3, 0, 105, 20)) == ErrorCode::OK);
+    REQUIRE(market.ReduceOrder(3, 5) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(3)->LeavesQuantity == 15);
+    REQUIRE(market.ModifyOrder(3, 100, 8) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(3)->Price == 100);
+    REQUIRE(market.GetOrder(3)->LeavesQuantity == 8);
+    REQUIRE(market.ReplaceOrder(3, 4, 101, 6) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(3) == nullptr);
+    REQUIRE(market.GetOrder(4)->Price == 101);
+    REQUIRE(market.GetOrder(4)->LeavesQuantity == 6);
+    REQUIRE(market.DeleteOrder(4) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(4) == nullptr);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+
+    // 'Immediate-Or-Cancel' orders take part in the uncross and their remaining parts are deleted
+    REQUIRE(market.AddOrder(Order::SellLimit(5, 0, 100, 4)) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::SellLimit(6, 0, 99, 20, OrderTimeInForce::IOC)) == ErrorCode::OK);
+    REQUIRE(market.MatchOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(handler.executed == 2 * 10);
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(6) == nullptr);
+    REQUIRE(market.GetOrder(5)->LeavesQuantity == 4);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 1));
+
+    // Stop orders are activated after the uncross
+    REQUIRE(market.AddOrder(Order::BuyLimit(7, 0, 90, 10)) == ErrorCode::OK);
+    REQUIRE(market.MatchOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(market.AddOrder(Order::SellStop(8, 0, 95, 5)) == ErrorCode::OK);
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 1));
+    REQUIRE(handler.executed == 2 * 10);
+    REQUIRE(market.MatchOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(handler.executed == 2 * 10 + 2 * 5);
+    REQUIRE(market.GetOrder(8) == nullptr);
+    REQUIRE(market.GetOrder(7)->LeavesQuantity == 5);
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+
+    // Mass-cancel deletes orders of the current batch as well
+    REQUIRE(market.AddOrder(Order::BuyLimit(9, 0, 80, 5)) == ErrorCode::OK);
+    REQUIRE((handler.added - handler.deleted) == market.orders().size());
+    REQUIRE(market.DeleteOrders(0) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(9) == nullptr);
+    REQUIRE(market.orders().empty());
+    REQUIRE(handler.added == handler.deleted);
+}
+
+TEST_CASE("Call and batch auction modes", "[CppTrader][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Crossed order book without the automatic matching
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 99, 10));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+
+    // Call and batch auction modes are exclusive
+    REQUIRE(market.EnableOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(market.EnableOrderBookAuction(0) == ErrorCode::ORDER_BOOK_MODE_INVALID);
+    REQUIRE(!market.GetOrderBook(0)->IsAuction());
+
+    // Manual matching skips the order book in the batch auction mode
+    market.Match();
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+    REQUIRE(market.DisableOrderBookBatch(0) == ErrorCode::OK);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+
+    market.AddOrder(Order::BuyLimit(3, 0, 100, 10));
+    REQUIRE(market.EnableOrderBookAuction(0) == ErrorCode::OK);
+    REQUIRE(market.EnableOrderBookBatch(0) == ErrorCode::ORDER_BOOK_MODE_INVALID);
+    REQUIRE(!market.GetOrderBook(0)->IsBatch());
+
+    // Manual matching skips the order book in the call auction mode
+    market.AddOrder(Order::SellLimit(4, 0, 99, 10));
+    market.Match();
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+    REQUIRE(market.UncrossOrderBook(0) == ErrorCode::OK);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+}
+
+TEST_CASE("Allocation policies", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableMatching();
+
+    // Prepare symbols & order books
+    const char name[8] = "test";
+    for (uint32_t id = 0; id < 3; ++id)
+    {
+        Symbol symbol = { id, name };
+        market.AddSymbol(symbol);
+        market.AddOrderBook(symbol);
+    }
+
+    // Pro-rata allocation
+    REQUIRE(market.SetOrderBookAllocation(0, Allocation(AllocationType::PRO_RATA)) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->allocation().Type == AllocationType::PRO_RATA);
+    market.AddOrder(Order::SellLimit(1, 0, 100, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 100, 30));
+    market.AddOrder(Order::SellLimit(3, 0, 100, 60));
+    market.AddOrder(Order::BuyLimit(4, 0, 100, 50));
+    REQUIRE(market.GetOrder(1)->ExecutedQuantity == 5);
+    REQUIRE(market.GetOrder(2)->ExecutedQuantity == 15);
+    REQUIRE(market.GetOrder(3)->ExecutedQuantity == 30);
+    REQUIRE(market.GetOrder(4) == nullptr);
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 50));
+
+    // Pro-rata allocation with the top order priority and the minimal allocation
+    REQUIRE(market.SetOrderBookAllocation(1, Allocation(AllocationType::PRO_RATA, true, 5)) == ErrorCode::OK);
+    market.AddOrder(Order::SellLimit(11, 1, 100, 10));
+    market.AddOrder(Order::SellLimit(12, 1, 100, 20));
+    market.AddOrder(Order::SellLimit(13, 1, 100, 70));
+    market.AddOrder(Order::SellLimit(14, 1, 100, 5));
+    market.AddOrder(Order::BuyLimit(15, 1, 100, 40));
+    REQUIRE(market.GetOrder(11) == nullptr);
+    REQUIRE(market.GetOrder(12)->ExecutedQuantity == 7);
+    REQUIRE(market.GetOrder(13)->ExecutedQuantity == 23);
+    REQUIRE(market.GetOrder(14)->ExecutedQuantity == 0);
+    REQUIRE(BookVolume(market.GetOrderBook(1)) == std::make_pair(0, 65));
+
+    // Size priority allocation
+    REQUIRE(market.SetOrderBookAllocation(2, Allocation(AllocationType::SIZE_PRIORITY)) == ErrorCode::OK);
+    market.AddOrder(Order::SellLimit(21, 2, 100, 10));
+    market.AddOrder(Order::SellLimit(22, 2, 100, 30));
+    market.AddOrder(Order::SellLimit(23, 2, 100, 30));
+    market.AddOrder(Order::SellLimit(24, 2, 100, 20));
+    market.AddOrder(Order::BuyLimit(25, 2, 100, 45));
+    REQUIRE(market.GetOrder(21)->ExecutedQuantity == 0);
+    REQUIRE(market.GetOrder(22) == nullptr);
+    REQUIRE(market.GetOrder(23)->ExecutedQuantity == 15);
+    REQUIRE(market.GetOrder(24)->ExecutedQuantity == 0);
+
+    // Price level volume less than the order quantity is filled completely
+    market.AddOrder(Order::BuyLimit(26, 2, 100, 100));
+    REQUIRE(BookOrders(market.GetOrderBook(2)) == std::make_pair(1, 0));
+    REQUIRE(BookVolume(market.GetOrderBook(2)) == std::make_pair(55, 0));
+}
+
+TEST_CASE("Pro-rata largest remainder allocation", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    REQUIRE(market.SetOrderBookAllocation(0, Allocation(AllocationType::PRO_RATA)) == ErrorCode::OK);
+
+    // Rounding residual goes to the largest remainder instead of the first order
+    market.AddOrder(Order::SellLimit(1, 0, 100, 70));
+    market.AddOrder(Order::SellLimit(2, 0, 100, 25));
+    market.AddOrder(Order::SellLimit(3, 0, 100, 5));
+    market.AddOrder(Order::BuyLimit(4, 0, 100, 33));
+    REQUIRE(market.GetOrder(1)->ExecutedQuantity == 23);
+    REQUIRE(market.GetOrder(2)->ExecutedQuantity == 8);
+    REQUIRE(market.GetOrder(3)->ExecutedQuantity == 2);
+
+    // Equal remainders are allocated in the time priority
+    market.AddOrder(Order::SellLimit(11, 0, 101, 10));
+    market.AddOrder(Order::SellLimit(12, 0, 101, 10));
+    market.AddOrder(Order::SellLimit(13, 0, 101, 10));
+    market.AddOrder(Order::BuyLimit(14, 0, 100, 67));
+    market.AddOrder(Order::BuyLimit(15, 0, 101, 10));
+    REQUIRE(market.GetOrder(11)->ExecutedQuantity == 4);
+    REQUIRE(market.GetOrder(12)->ExecutedQuantity == 3);
+    REQUIRE(market.GetOrder(13)->ExecutedQuantity == 3);
+
+#if !defined(CPPTRADER_COMPACT_TYPES)
+    // Huge quantities are allocated exactly without the multiplication overflow
+    const uint64_t huge = 10000000000000ull;
+    market.AddOrder(Order::SellLimit(21, 0, 102, huge));
+    market.AddOrder(Order::SellLimit(22, 0, 102, huge));
+    market.AddOrder(Order::SellLimit(23, 0, 102, huge));
+    market.AddOrder(Order::BuyLimit(24, 0, 101, 20));
+    market.AddOrder(Order::BuyLimit(25, 0, 102, huge + 1));
+    REQUIRE(market.GetOrder(21)->ExecutedQuantity == 3333333333334ull);
+    REQUIRE(market.GetOrder(22)->ExecutedQuantity == 3333333333334ull);
+    REQUIRE(market.GetOrder(23)->ExecutedQuantity == 3333333333333ull);
+#endif
+}
+
+TEST_CASE("Mass quote", "[CppTrader][Matching]")
+{
+    class QuoteHandler : public MarketHandler
+    {
+    public:
+        size_t book_updates = 0;
+        size_t level_updates = 0;
+        size_t added_levels = 0;
+        size_t deleted_levels = 0;
+        uint64_t executed = 0;
+
+    protected:
+        void onUpdateOrderBook(const OrderBook& order_book, bool top) override { ++book_updates; }
+        void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; ++added_levels; }
+        void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; }
+        void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; ++deleted_levels; }
+        void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { executed += quantity; }
+    };
+
+    QuoteHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Add the quotes ladder
+    Quote ladder[] = { Quote::Buy(1, 99, 10), Quote::Buy(2, 98, 20), Quote::Sell(3, 101, 10), Quote::Sell(4, 102, 20) };
+    REQUIRE(market.MassQuote(0, ladder, 4) == ErrorCode::OK);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(2, 2));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(30, 30));
+    REQUIRE(handler.level_updates == 4);
+    REQUIRE(handler.book_updates == 1);
+
+    // Competing order at the same price level as the first quote
+    market.AddOrder(Order::BuyLimit(10, 0, 99, 5));
+    REQUIRE(handler.book_updates == 2);
+
+    // Refresh the quotes ladder
+    Quote refresh[] = { Quote::Buy(1, 99, 8), Quote::Buy(2, 97, 20), Quote::Cancel(3), Quote::Sell(4, 102, 30), Quote::Sell(5, 103, 10) };
+    REQUIRE(market.MassQuote(0, refresh, 5) == ErrorCode::OK);
+    REQUIRE(handler.book_updates == 3);
+    REQUIRE(market.GetOrder(3) == nullptr);
+
+    // Each changed price level is published once with its net change
+    REQUIRE(handler.level_updates == 5 + 6);
+    REQUIRE(handler.added_levels == 4 + 2);
+    REQUIRE(handler.deleted_levels == 2);
+    REQUIRE(market.GetOrder(2)->Price == 97);
+    REQUIRE(market.GetOrder(4)->LeavesQuantity == 30);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 2));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(33, 40));
+
+    // Reduced quote keeps its time priority
+    REQUIRE(market.GetOrderBook(0)->GetBid(99)->OrderList.front()->Id == 1);
+
+    // Invalid ladder is not applied at all
+    Quote invalid[] = { Quote::Buy(1, 99, 1), Quote::Sell(2, 97, 20) };
+    REQUIRE(market.MassQuote(0, invalid, 2) == ErrorCode::ORDER_PARAMETER_INVALID);
+    REQUIRE(market.GetOrder(1)->LeavesQuantity == 8);
+    Quote duplicate[] = { Quote::Buy(6, 90, 1), Quote::Buy(6, 91, 1) };
+    REQUIRE(market.MassQuote(0, duplicate, 2) == ErrorCode::ORDER_DUPLICATE);
+    REQUIRE(market.GetOrder(6) == nullptr);
+    Quote unordered_duplicate[] = { Quote::Buy(6, 90, 1), Quote::Buy(11, 91, 1), Quote::Sell(12, 110, 1), Quote::Buy(6, 92, 1) };
+    REQUIRE(market.MassQuote(0, unordered_duplicate, 4) == ErrorCode::ORDER_DUPLICATE);
+    REQUIRE(market.GetOrder(11) == nullptr);
+
+    // Price level deleted and added again in the same ladder is published as the update
+    Quote requote[] = { Quote::Cancel(2), Quote::Buy(9, 97, 20) };
+    REQUIRE(market.MassQuote(0, requote, 2) == ErrorCode::OK);
+    REQUIRE(handler.level_updates == 5 + 6 + 1);
+    REQUIRE(handler.added_levels == 4 + 2);
+    REQUIRE(handler.deleted_levels == 2);
+    REQUIRE(market.GetOrderBook(0)->GetBid(97)->OrderList.front()->Id == 9);
+
+    // Crossing quotes are matched once after the whole ladder is replaced
+    Quote crossing[] = { Quote::Sell(7, 99, 20), Quote::Buy(8, 90, 10) };
+    REQUIRE(market.MassQuote(0, crossing, 2) == ErrorCode::OK);
+    REQUIRE(handler.executed == 2 * 13);
+    REQUIRE(market.GetOrder(7)->LeavesQuantity == 7);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(2, 3));
+}
+
+TEST_CASE("Mass cancel", "[CppTrader][Matching]")
+{
+    class CancelHandler : public MarketHandler
+    {
+    public:
+        size_t book_updates = 0;
+        size_t deleted_order = 0;
+        size_t deleted_orders = 0;
+        size_t deleted_summaries = 0;
+        uint64_t deleted_volume = 0;
+
+    protected:
+        void onUpdateOrderBook(const OrderBook& order_book, bool top) override { ++book_updates; }
+        void onDeleteOrder(const Order& order) override { ++deleted_order; }
+        void onDeleteOrders(const OrderBook& order_book, size_t orders, uint64_t volume) override { ++deleted_summaries; deleted_orders += orders; deleted_volume += volume; }
+    };
+
+    CancelHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbols & order books
+    const char name1[8] = "test1";
+    const char name2[8] = "test2";
+    Symbol symbol1 = { 0, name1 };
+    Symbol symbol2 = { 1, name2 };
+    market.AddSymbol(symbol1);
+    market.AddSymbol(symbol2);
+    market.AddOrderBook(symbol1);
+    market.AddOrderBook(symbol2);
+
+    auto add = [&market](Order order, uint32_t owner) { order.OwnerId = owner; return market.AddOrder(order); };
+
+    // Add orders of two owners
+    REQUIRE(add(Order::BuyLimit(1, 0, 99, 10), 1) == ErrorCode::OK);
+    REQUIRE(add(Order::BuyLimit(2, 0, 99, 10), 2) == ErrorCode::OK);
+    REQUIRE(add(Order::BuyLimit(3, 0, 98, 10), 1) == ErrorCode::OK);
+    REQUIRE(add(Order::SellLimit(4, 0, 101, 10), 1) == ErrorCode::OK);
+    REQUIRE(add(Order::SellLimit(5, 0, 102, 10), 2) == ErrorCode::OK);
+    REQUIRE(add(Order::SellLimit(6, 0, 103, 10), 2) == ErrorCode::OK);
+    REQUIRE(add(Order::BuyStop(7, 0, 110, 10), 1) == ErrorCode::OK);
+    REQUIRE(add(Order::SellStop(8, 0, 90, 10), 2) == ErrorCode::OK);
+    REQUIRE(add(Order::BuyLimit(11, 1, 50, 10), 1) == ErrorCode::OK);
+    REQUIRE(add(Order::SellLimit(12, 1, 60, 10), 2) == ErrorCode::OK);
+    handler.book_updates = 0;
+
+    // Cancel-on-disconnect of the first owner
+    REQUIRE(market.DeleteOwnerOrders(1) == ErrorCode::OK);
+    REQUIRE(handler.deleted_summaries == 2);
+    REQUIRE(handler.deleted_orders == 5);
+    REQUIRE(handler.deleted_volume == 50);
+    REQUIRE(handler.deleted_order == 5);
+    REQUIRE(handler.book_updates == 2);
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(7) == nullptr);
+    REQUIRE(market.GetOrder(11) == nullptr);
+    REQUIRE(market.GetOrderBook(0)->GetBid(98) == nullptr);
+    REQUIRE(market.GetOrderBook(0)->GetBid(99)->TotalVolume == 10);
+    REQUIRE(market.GetOrderBook(0)->GetBid(99)->Orders == 1);
+    REQUIRE(market.GetOrderBook(0)->buy_stop().empty());
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 2));
+    REQUIRE(BookOrders(market.GetOrderBook(1)) == std::make_pair(0, 1));
+
+    // Cancel by side and price range
+    REQUIRE(market.DeleteOrders(0, OrderSide::SELL, 103, 103) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(6) == nullptr);
+    REQUIRE(market.GetOrder(8) != nullptr);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+    REQUIRE(market.DeleteOrders(0, OrderSide::SELL, 0, 100) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(8) == nullptr);
+    REQUIRE(market.GetOrderBook(0)->sell_stop().empty());
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+    REQUIRE(handler.deleted_summaries == 4);
+
+    // Empty selection does not produce any updates
+    REQUIRE(market.DeleteOrders(0, OrderSide::BUY, 0, 50) == ErrorCode::OK);
+    REQUIRE(handler.deleted_summaries == 4);
+
+    // Cancel by symbol
+    REQUIRE(market.DeleteOrders(0) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->empty());
+    REQUIRE(market.GetOrder(2) == nullptr);
+    REQUIRE(market.GetOrder(5) == nullptr);
+    REQUIRE(handler.deleted_orders == 9);
+    REQUIRE(handler.deleted_order == 9);
+
+    // Deleted order book releases all its orders
+    REQUIRE(market.DeleteOrderBook(1) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(12) == nullptr);
+    REQUIRE(handler.deleted_orders == 10);
+    REQUIRE(add(Order::BuyLimit(12, 0, 99, 10), 2) == ErrorCode::OK);
+    REQUIRE(handler.deleted_order == 10);
+}
+
+TEST_CASE("Owner orders index", "[CppTrader][Matching]")
+{
+    class OwnerHandler : public MarketHandler
+    {
+    public:
+        size_t deleted_owner1 = 0;
+        size_t deleted_owner2 = 0;
+
+    protected:
+        void onDeleteOrder(const Order& order) override { if (order.OwnerId == 1) ++deleted_owner1; else if (order.OwnerId == 2) ++deleted_owner2; }
+    };
+
+    OwnerHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbols & order books
+    const char name1[8] = "test1";
+    const char name2[8] = "test2";
+    Symbol symbol1 = { 0, name1 };
+    Symbol symbol2 = { 1, name2 };
+    market.AddSymbol(symbol1);
+    market.AddSymbol(symbol2);
+    market.AddOrderBook(symbol1);
+    market.AddOrderBook(symbol2);
+
+    auto add = [&market](Order order, uint32_t owner) { order.OwnerId = owner; return market.AddOrder(order); };
+
+    // Add orders of the first owner into both order books
+    for (uint64_t id = 1; id <= 20; ++id)
+        REQUIRE(add(Order::BuyLimit(id, (uint32_t)(id % 2), 90 + id, 10), 1) == ErrorCode::OK);
+    REQUIRE(add(Order::SellStop(21, 0, 50, 10), 1) == ErrorCode::OK);
+    REQUIRE(add(Order::TrailingSellStop(22, 1, 50, 10, 50, 1), 1) == ErrorCode::OK);
+
+    // Add orders of the second owner and orders without the owner
+    REQUIRE(add(Order::BuyLimit(31, 0, 80, 10), 2) == ErrorCode::OK);
+    REQUIRE(add(Order::SellLimit(32, 1, 300, 10), 2) == ErrorCode::OK);
+    REQUIRE(add(Order::BuyLimit(33, 0, 80, 10), 0) == ErrorCode::OK);
+
+    // Delete, replace (reported as the delete and the add) and execute some orders of the first owner
+    REQUIRE(market.DeleteOrder(3) == ErrorCode::OK);
+    REQUIRE(market.DeleteOrder(20) == ErrorCode::OK);
+    REQUIRE(market.ReplaceOrder(5, 40, 91, 10) == ErrorCode::OK);
+    REQUIRE(add(Order::SellLimit(34, 1, 107, 20), 2) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(17) == nullptr);
+    REQUIRE(market.GetOrder(19) == nullptr);
+    REQUIRE(handler.deleted_owner1 == 5);
+    REQUIRE(handler.deleted_owner2 == 1);
+
+    // Cancel-on-disconnect of the first owner deletes all its remaining orders one by one
+    REQUIRE(market.DeleteOwnerOrders(1) == ErrorCode::OK);
+    REQUIRE(handler.deleted_owner1 == 5 + 18);
+    REQUIRE(handler.deleted_owner2 == 1);
+    REQUIRE(market.orders().size() == 3);
+    REQUIRE(market.GetOrder(31) != nullptr);
+    REQUIRE(market.GetOrder(32) != nullptr);
+    REQUIRE(market.GetOrder(33) != nullptr);
+    REQUIRE(market.GetOrder(40) == nullptr);
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(2, 0));
+    REQUIRE(BookOrders(market.GetOrderBook(1)) == std::make_pair(0, 1));
+
+    // Repeated cancel-on-disconnect does nothing
+    REQUIRE(market.DeleteOwnerOrders(1) == ErrorCode::OK);
+    REQUIRE(handler.deleted_owner1 == 5 + 18);
+
+    // Owner orders are indexed again after the mass cancel
+    REQUIRE(add(Order::BuyLimit(1, 1, 90, 10), 1) == ErrorCode::OK);
+    REQUIRE(market.DeleteOwnerOrders(1) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.DeleteOwnerOrders(2) == ErrorCode::OK);
+    REQUIRE(handler.deleted_owner2 == 1 + 2);
+    REQUIRE(market.orders().size() == 1);
+}
+
+TEST_CASE("Replace order", "[CppTrader][Matching]")
+{
+    class ReplaceHandler : public MarketHandler
+    {
+    public:
+        size_t level_updates = 0;
+        size_t added_orders = 0;
+        size_t replaced_orders = 0;
+        size_t deleted_orders = 0;
+        uint64_t replaced_id = 0;
+        uint64_t executed = 0;
+
+    protected:
+        void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; }
+        void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; }
+        void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; }
+        void onAddOrder(const Order& order) override { ++added_orders; }
+        void onReplaceOrder(const Order& old_order, const Order& order) override { ++replaced_orders; replaced_id = old_order.Id; }
+        void onDeleteOrder(const Order& order) override { ++deleted_orders; }
+        void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { executed += quantity; }
+    };
+
+    ReplaceHandler handler;
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Add orders
+    market.AddOrder(Order::BuyLimit(1, 0, 99, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 99, 20));
+    market.AddOrder(Order::BuyLimit(3, 0, 98, 5));
+    market.AddOrder(Order::SellLimit(4, 0, 101, 10));
+    handler.level_updates = 0;
+    handler.added_orders = 0;
+
+    // Replace the order at the same price level in place
+    const LevelNode* level_ptr = market.GetOrderBook(0)->GetBid(99);
+    REQUIRE(market.ReplaceOrder(1, 11, 99, 15) == ErrorCode::OK);
+    REQUIRE(market.GetOrder(1) == nullptr);
+    REQUIRE(market.GetOrder(11)->LeavesQuantity == 15);
+    REQUIRE(market.GetOrderBook(0)->GetBid(99) == level_ptr);
+    REQUIRE(level_ptr->TotalVolume == 35);
+    REQUIRE(level_ptr->Orders == 2);
+    REQUIRE(level_ptr->OrderList.front()->Id == 2);
+    REQUIRE(level_ptr->OrderList.front()->next->Id == 11);
+    REQUIRE(handler.level_updates == 2);
+    REQUIRE(handler.replaced_orders == 1);
+    REQUIRE(handler.replaced_id == 1);
+    REQUIRE(handler.added_orders == 0);
+    REQUIRE(handler.deleted_orders == 0);
+
+    // Duplicate new order Id does not change the order
+    REQUIRE(market.ReplaceOrder(11, 2, 99, 5) == ErrorCode::ORDER_DUPLICATE);
+    REQUIRE(market.GetOrder(11)->LeavesQuantity == 15);
+    REQUIRE(handler.replaced_orders == 1);
+
+    // Replace the order with a new price level
+    REQUIRE(market.ReplaceOrder(3, 13, 97, 7) == ErrorCode::OK);
+    REQUIRE(market.GetOrderBook(0)->GetBid(98) == nullptr);
+    REQUIRE(market.GetOrderBook(0)->GetBid(97)->TotalVolume == 7);
+    REQUIRE(handler.level_updates == 4);
+    REQUIRE(handler.replaced_orders == 2);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(3, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(42, 10));
+
+    // Replace the order with the crossing price
+    REQUIRE(market.ReplaceOrder(13, 14, 101, 4) == ErrorCode::OK);
+    REQUIRE(handler.executed == 2 * 4);
+    REQUIRE(handler.deleted_orders == 1);
+    REQUIRE(market.GetOrder(14) == nullptr);
+    REQUIRE(market.GetOrder(4)->LeavesQuantity == 6);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(2, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(35, 6));
+}
+
+TEST_CASE("Replace order with the default handler", "[CppTrader][Matching]")
+{
+    class OrdersHandler : public MarketHandler
+    {
+    public:
+        std::vector<std::pair<uint64_t, uint64_t>> added;
+        std::vector<std::pair<uint64_t, uint64_t>> deleted;
+        size_t level_updates = 0;
+
+    protected:
+        void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; }
+        void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; }
+        void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override { ++level_updates; }
+        void onAddOrder(const Order& order) override { added.emplace_back(order.Id, order.LeavesQuantity); }
+        void onDeleteOrder(const Order& order) override { deleted.emplace_back(order.Id, order.LeavesQuantity); }
+    };
+
+    OrdersHandler handler;
+    MarketManager market(handler);
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.AddOrder(Order::BuyLimit(1, 0, 99, 10));
+    handler.added.clear();
+    handler.level_updates = 0;
+
+    // Replace is reported as the delete of the old order and the add of the new one
+    REQUIRE(market.ReplaceOrder(1, 2, 99, 15) == ErrorCode::OK);
+    REQUIRE(handler.deleted == std::vector<std::pair<uint64_t, uint64_t>>{ { 1, 10 } });
+    REQUIRE(handler.added == std::vector<std::pair<uint64_t, uint64_t>>{ { 2, 15 } });
+    REQUIRE(handler.level_updates == 2);
+
+    REQUIRE(market.ReplaceOrder(2, 3, 98, 5) == ErrorCode::OK);
+    REQUIRE(handler.deleted.back() == std::make_pair((uint64_t)2, (uint64_t)15));
+    REQUIRE(handler.added.back() == std::make_pair((uint64_t)3, (uint64_t)5));
+    REQUIRE(handler.level_updates == 4);
+}
+
+TEST_CASE("Order book best bid and offer", "[CppTrader][Matching]")
+{
+    MarketManager market;
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    REQUIRE(market.GetOrderBook(0)->bbo() == nullptr);
+
+    // Enable the best bid and offer block with the existing orders
+    market.AddOrder(Order::BuyLimit(1, 0, 99, 10));
+    REQUIRE(market.EnableOrderBookBBO(0) == ErrorCode::OK);
+    const BBOBlock* block = market.GetOrderBook(0)->bbo();
+    REQUIRE(block != nullptr);
+    BBO bbo = block->Read();
+    REQUIRE(bbo.IsBid());
+    REQUIRE(!bbo.IsAsk());
+    REQUIRE(bbo.BidPrice == 99);
+    REQUIRE(bbo.BidVolume == 10);
+    REQUIRE(bbo.BidOrders == 1);
+
+    // Top of the book updates are published
+    market.AddOrder(Order::BuyLimit(2, 0, 99, 20));
+    market.AddOrder(Order::SellLimit(3, 0, 101, 5));
+    bbo = block->Read();
+    REQUIRE(bbo.BidVolume == 30);
+    REQUIRE(bbo.BidOrders == 2);
+    REQUIRE(bbo.AskPrice == 101);
+    REQUIRE(bbo.AskVolume == 5);
+
+    // Updates below the top of the book are not published
+    uint64_t version = block->version();
+    market.AddOrder(Order::BuyLimit(4, 0, 98, 10));
+    REQUIRE(block->version() == version);
+
+    // Executions are published
+    market.AddOrder(Order::SellLimit(5, 0, 99, 25));
+    REQUIRE(block->TryRead(bbo));
+    REQUIRE(bbo.BidPrice == 99);
+    REQUIRE(bbo.BidVolume == 5);
+    REQUIRE(bbo.BidOrders == 1);
+
+    // Concurrent readers always get a consistent snapshot
+    std::atomic<bool> done(false);
+    std::atomic<size_t> inconsistent(0);
+    auto reader = [&]()
+    {
+        while (!done.load(std::memory_order_acquire))
+        {
+            BBO snapshot = block->Read();
+            if (snapshot.AskVolume != snapshot.AskPrice)
+                ++inconsistent;
+        }
+    };
+    market.DeleteOrder(3);
+    std::thread reader1(reader);
+    std::thread reader2(reader);
+    uint64_t id = 100;
+    for (uint64_t price = 1000; price > 200; --price)
+    {
+        // Each new best ask price level has the volume equal to its price
+        market.AddOrder(Order::SellLimit(++id, 0, price, price));
+        if (id > 101)
+            market.DeleteOrder(id - 1);
+    }
+    done.store(true, std::memory_order_release);
+    reader1.join();
+    reader2.join();
+    REQUIRE(inconsistent == 0);
+    bbo = block->Read();
+    REQUIRE(bbo.AskPrice == 201);
+    REQUIRE(bbo.AskVolume == 201);
+}
+
+TEST_CASE("Node links of different market managers", "[CppTrader][Matching]")
+{
+    MarketManager market1;
+    MarketManager market2;
+
+    // Prepare symbols & order books
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market1.AddSymbol(symbol);
+    market1.AddOrderBook(symbol);
+    market2.AddSymbol(symbol);
+    market2.AddOrderBook(symbol);
+
+    // Each market manager allocates nodes of the same shape in the same order
+    market1.AddOrder(Order::BuyLimit(1, 0, 10, 100));
+    market2.AddOrder(Order::BuyLimit(1, 0, 20, 200));
+    market1.AddOrder(Order::BuyLimit(2, 0, 10, 110));
+    market2.AddOrder(Order::BuyLimit(2, 0, 20, 220));
+
+    const OrderBook* order_book1 = market1.GetOrderBook(0);
+    const OrderBook* order_book2 = market2.GetOrderBook(0);
+    const OrderNode* order1 = static_cast<const OrderNode*>(market1.GetOrder(2));
+    const OrderNode* order2 = static_cast<const OrderNode*>(market2.GetOrder(2));
+#if defined(CPPTRADER_COMPACT_LINKS)
+    REQUIRE(order1->Handle == order2->Handle);
+#endif
+
+    // Node links are resolved into nodes of the selected market manager
+    for (int i = 0; i < 2; ++i)
+    {
+        MarketManager::NodeScope scope1(market1);
+        REQUIRE(order_book1->best_bid()->Price == 10);
+        REQUIRE(order_book1->best_bid()->OrderList.back() == order1);
+        REQUIRE(order1->Level->Price == 10);
+        {
+            MarketManager::NodeScope scope2(market2);
+            REQUIRE(order_book2->best_bid()->Price == 20);
+            REQUIRE(order_book2->best_bid()->OrderList.back() == order2);
+            REQUIRE(order2->Level->Price == 20);
+        }
+        REQUIRE(order_book1->best_bid()->OrderList.front()->Quantity == 100);
+    }
+
+    // The last called market manager leaves its nodes selected
+    market2.DeleteOrder(1);
+    REQUIRE(order_book2->best_bid()->OrderList.front() == order2);
+    REQUIRE(BookOrders(order_book2) == std::make_pair(1, 0));
+    REQUIRE(market1.GetOrderBook(0) == order_book1);
+    REQUIRE(BookOrders(order_book1) == std::make_pair(2, 0));
+}
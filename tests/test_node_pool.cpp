@@ -0,0 +1,215 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/compact_bintree_avl.h"
+#include "trader/matching/compact_list.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+namespace {
+
+struct TestNode : public CompactList<TestNode>::Node, public CompactBinTreeAVL<TestNode>::Node
+{
+    uint32_t Handle;
+    int Value;
+
+    explicit TestNode(int value) noexcept : Value(value) {}
+
+    friend bool operator<(const TestNode& node1, const TestNode& node2) noexcept
+    { return node1.Value < node2.Value; }
+};
+
+void CheckTree(const TestNode* node, int& height)
+{
+    height = 0;
+    if (node == nullptr)
+        return;
+
+    // Check links and the AVL balance of the subtree
+    if (node->left != nullptr)
+        REQUIRE(((node->left->parent == node) && (node->left->Value < node->Value)));
+    if (node->right != nullptr)
+        REQUIRE(((node->right->parent == node) && (node->right->Value > node->Value)));
+    int left, right;
+    CheckTree(node->left, left);
+    CheckTree(node->right, right);
+    REQUIRE(std::abs(left - right) <= 1);
+    REQUIRE(node->height == (1 + std::max(left, right)));
+    height = 1 + std::max(left, right);
+}
+
+} // namespace
+
+TEST_CASE("Compact node pool", "[CppTrader][Matching]")
+{
+    NodePool<TestNode> pool;
+    NodePool<TestNode>::Scope scope(pool);
+    REQUIRE(NodePool<TestNode>::current() == &pool);
+
+    // Nodes are addressed with non-zero 32-bit handles
+    TestNode* node1 = pool.Create(1);
+    TestNode* node2 = pool.Create(2);
+    REQUIRE(node1->Handle != 0);
+    REQUIRE(node2->Handle != node1->Handle);
+    REQUIRE(NodePool<TestNode>::Pointer(node1->Handle) == node1);
+    REQUIRE(NodePool<TestNode>::Pointer(0) == nullptr);
+    REQUIRE(pool.allocated() == 2);
+
+    // Compact pointers behave as plain pointers
+    CompactPtr<TestNode> ptr;
+    REQUIRE(ptr == nullptr);
+    ptr = node2;
+    REQUIRE(ptr == node2);
+    REQUIRE(ptr->Value == 2);
+    REQUIRE(ptr.handle() == node2->Handle);
+    REQUIRE(sizeof(ptr) == sizeof(uint32_t));
+
+    // Released nodes are recycled
+    uint32_t handle = node1->Handle;
+    pool.Release(node1);
+    TestNode* node3 = pool.Create(3);
+    REQUIRE(node3->Handle == handle);
+    REQUIRE(node3->Value == 3);
+
+    pool.Release(node2);
+    pool.Release(node3);
+    REQUIRE(pool.allocated() == 0);
+}
+
+TEST_CASE("Compact list", "[CppTrader][Matching]")
+{
+    NodePool<TestNode> pool;
+    NodePool<TestNode>::Scope scope(pool);
+    CompactList<TestNode> list;
+    REQUIRE(list.empty());
+
+    TestNode* node1 = pool.Create(1);
+    TestNode* node2 = pool.Create(2);
+    TestNode* node3 = pool.Create(3);
+    TestNode* node4 = pool.Create(4);
+
+    list.push_back(*node2);
+    list.push_front(*node1);
+    list.push_back(*node4);
+    list.push_prev(*node4, *node3);
+    REQUIRE(list.size() == 4);
+    REQUIRE(sizeof(list) == (sizeof(size_t) + 2 * sizeof(uint32_t)));
+
+    int expected = 1;
+    for (const auto& node : list)
+        REQUIRE(node.Value == expected++);
+
+    REQUIRE(list.pop_current(*node2) == node2);
+    REQUIRE(list.front()->next == node3);
+    REQUIRE(list.pop_front() == node1);
+    REQUIRE(list.pop_back() == node4);
+    REQUIRE((list.front() == node3) && (list.back() == node3));
+    REQUIRE(list.pop_front() == node3);
+    REQUIRE(list.empty());
+
+    pool.Release(node1);
+    pool.Release(node2);
+    pool.Release(node3);
+    pool.Release(node4);
+}
+
+TEST_CASE("Compact AVL binary tree", "[CppTrader][Matching]")
+{
+    NodePool<TestNode> pool;
+    NodePool<TestNode>::Scope scope(pool);
+    CompactBinTreeAVL<TestNode> tree;
+    std::set<int> values;
+    std::vector<TestNode*> nodes;
+
+    // Random inserts and erases are checked against the reference set
+    std::mt19937 generator(42);
+    for (int i = 0; i < 5000; ++i)
+    {
+        int value = (int)(generator() % 1000);
+        if ((generator() % 3) != 0)
+        {
+            TestNode* node = pool.Create(value);
+            if (tree.insert(*node).second)
+            {
+                REQUIRE(values.insert(value).second);
+                nodes.push_back(node);
+            }
+            else
+            {
+                REQUIRE(values.count(value) == 1);
+                pool.Release(node);
+            }
+        }
+        else
+        {
+            TestNode key(value);
+            TestNode* node = tree.erase(key);
+            REQUIRE((node != nullptr) == (values.erase(value) == 1));
+            if (node != nullptr)
+            {
+                nodes.erase(std::find(nodes.begin(), nodes.end(), node));
+                pool.Release(node);
+            }
+        }
+    }
+
+    REQUIRE(tree.size() == values.size());
+    int height;
+    CheckTree(tree.root(), height);
+    REQUIRE(height > 0);
+
+    // Forward, reverse and bound iterations follow the key order
+    auto it = values.begin();
+    for (const auto& node : tree)
+        REQUIRE(node.Value == *it++);
+    auto rit = values.rbegin();
+    for (auto tree_rit = tree.rbegin(); tree_rit != tree.rend(); ++tree_rit)
+        REQUIRE(tree_rit->Value == *rit++);
+    TestNode key(500);
+    REQUIRE(tree.lower_bound(key)->Value == *values.lower_bound(500));
+    REQUIRE(tree.upper_bound(key)->Value == *values.upper_bound(500));
+
+    for (auto node : nodes)
+        pool.Release(node);
+}
+
+TEST_CASE("Compact node pool handles do not alias between pools", "[CppTrader][Matching]")
+{
+    NodePool<TestNode> pool1;
+    NodePool<TestNode> pool2;
+
+    // Each pool addresses its own nodes with the same handles
+    TestNode* node1 = pool1.Create(1);
+    TestNode* node2 = pool2.Create(2);
+    REQUIRE(node1->Handle == node2->Handle);
+    REQUIRE(pool1.Resolve(node1->Handle) == node1);
+    REQUIRE(pool2.Resolve(node2->Handle) == node2);
+
+    // Compact pointers are resolved against the selected pool, nested scopes restore the previous one
+    CompactPtr<TestNode> ptr;
+    {
+        NodePool<TestNode>::Scope scope1(pool1);
+        ptr = node1;
+        REQUIRE(ptr->Value == 1);
+        {
+            NodePool<TestNode>::Scope scope2(pool2);
+            REQUIRE(ptr->Value == 2);
+        }
+        REQUIRE(ptr->Value == 1);
+    }
+
+    // The outermost scope leaves its pool current
+    REQUIRE(NodePool<TestNode>::current() == &pool1);
+
+    pool1.Release(node1);
+    pool2.Release(node2);
+}
@@ -0,0 +1,153 @@
+//
+// Created by Ivan Shynkarenka on 18.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/shared_memory_handler.h"
+
+#include <map>
+#include <vector>
+
+using namespace CppTrader::Matching;
+
+TEST_CASE("Market event ring", "[CppTrader][Matching]")
+{
+    struct alignas(64) CacheLine { uint8_t data[64]; };
+
+    const size_t capacity = 8;
+    std::vector<CacheLine> memory(MarketEventRing::Size(capacity) / sizeof(CacheLine) + 1);
+
+    MarketEventRing ring(memory.data(), capacity);
+    MarketEventRingReader reader(memory.data(), capacity);
+    REQUIRE(reader.valid());
+    REQUIRE(reader.synchronized());
+
+    MarketEvent event;
+    REQUIRE(reader.Read(event) == MarketEventRingStatus::EMPTY);
+
+    // Read published events
+    for (uint64_t i = 1; i <= 5; ++i)
+        ring.Publish(MarketEvent::FromType(MarketEventType::ADD_ORDER, i));
+    for (uint64_t i = 1; i <= 5; ++i)
+    {
+        REQUIRE(reader.Read(event) == MarketEventRingStatus::OK);
+        REQUIRE(event.Type == MarketEventType::ADD_ORDER);
+        REQUIRE(event.Value == i);
+    }
+    REQUIRE(reader.Read(event) == MarketEventRingStatus::EMPTY);
+
+    // Slow reader detects the overrun
+    for (uint64_t i = 0; i < capacity + 1; ++i)
+        ring.Publish(MarketEvent::FromType(MarketEventType::UPDATE_ORDER, i));
+    REQUIRE(reader.Read(event) == MarketEventRingStatus::OVERRUN);
+    REQUIRE(reader.Read(event) == MarketEventRingStatus::OVERRUN);
+
+    // Resync requests a snapshot and skips events until the snapshot begins
+    REQUIRE(!ring.IsSnapshotRequested());
+    reader.Resync();
+    REQUIRE(!reader.synchronized());
+    REQUIRE(ring.IsSnapshotRequested());
+    ring.Publish(MarketEvent::FromType(MarketEventType::DELETE_ORDER));
+    ring.AcknowledgeSnapshot();
+    REQUIRE(!ring.IsSnapshotRequested());
+    ring.Publish(MarketEvent::FromType(MarketEventType::SNAPSHOT_BEGIN, 1));
+    ring.Publish(MarketEvent::FromType(MarketEventType::SNAPSHOT_END));
+    REQUIRE(reader.Read(event) == MarketEventRingStatus::OK);
+    REQUIRE(event.Type == MarketEventType::SNAPSHOT_BEGIN);
+    REQUIRE(reader.synchronized());
+    REQUIRE(reader.Read(event) == MarketEventRingStatus::OK);
+    REQUIRE(event.Type == MarketEventType::SNAPSHOT_END);
+    REQUIRE(reader.Read(event) == MarketEventRingStatus::EMPTY);
+
+    // Restarted producer continues the ring sequence
+    MarketEventRing restarted(memory.data(), capacity);
+    REQUIRE(restarted.sequence() == ring.sequence());
+    restarted.Publish(MarketEvent::FromType(MarketEventType::ADD_ORDER, 42));
+    REQUIRE(reader.Read(event) == MarketEventRingStatus::OK);
+    REQUIRE(event.Value == 42);
+}
+
+TEST_CASE("Shared memory handler", "[CppTrader][Matching]")
+{
+    const std::string name = "cpptrader-test-shared-memory-handler";
+    const size_t capacity = 64;
+
+    SharedMemoryHandler handler(name, capacity);
+    SharedMemoryReader reader1(name, capacity);
+    MarketManager market(handler);
+    market.EnableMatching();
+
+    // Prepare symbol & order book
+    const char symbol_name[8] = "test";
+    Symbol symbol = { 0, symbol_name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Read symbol, order book, order, level and execution events
+    market.AddOrder(Order::BuyLimit(1, 0, 99, 10));
+    market.AddOrder(Order::SellLimit(2, 0, 99, 4));
+    std::vector<MarketEventType> types;
+    MarketEvent event;
+    while (reader1.Read(event) == MarketEventRingStatus::OK)
+        types.push_back(event.Type);
+    std::vector<MarketEventType> expected = {
+        MarketEventType::ADD_SYMBOL, MarketEventType::ADD_ORDER_BOOK,
+        MarketEventType::ADD_ORDER, MarketEventType::ADD_LEVEL,
+        MarketEventType::ADD_ORDER,
+        MarketEventType::EXECUTE_ORDER, MarketEventType::UPDATE_ORDER, MarketEventType::UPDATE_LEVEL,
+        MarketEventType::EXECUTE_ORDER, MarketEventType::DELETE_ORDER
+    };
+    REQUIRE(types == expected);
+
+    // Late reader resynchronizes with the market snapshot
+    for (uint64_t i = 0; i < capacity; ++i)
+        market.AddOrder(Order::SellLimit(100 + i, 0, 101 + (i % 5), 1));
+    REQUIRE(reader1.Read(event) == MarketEventRingStatus::OVERRUN);
+    for (uint64_t id = 100; id <= 120; ++id)
+        market.DeleteOrder(id);
+    reader1.Resync();
+    SharedMemoryReader reader2(name, capacity);
+    REQUIRE(!reader2.reader().synchronized());
+    REQUIRE(handler.IsSnapshotRequested());
+    REQUIRE(handler.PublishSnapshot(market));
+    REQUIRE(!handler.IsSnapshotRequested());
+
+    // Rebuild the order book from the snapshot and following events
+    for (auto reader_ptr : { &reader1, &reader2 })
+    {
+        std::map<uint64_t, uint64_t> bids;
+        std::map<uint64_t, uint64_t> asks;
+        std::map<uint64_t, uint64_t> orders;
+        market.AddOrder(Order::BuyLimit(3, 0, 98, 7));
+        while (reader_ptr->Read(event) == MarketEventRingStatus::OK)
+        {
+            auto& levels = (event.Side == OrderSide::BUY) ? bids : asks;
+            if ((event.Type == MarketEventType::SNAPSHOT_LEVEL) || (event.Type == MarketEventType::ADD_LEVEL) || (event.Type == MarketEventType::UPDATE_LEVEL))
+                levels[event.Price] = event.Quantity;
+            else if (event.Type == MarketEventType::DELETE_LEVEL)
+                levels.erase(event.Price);
+            else if ((event.Type == MarketEventType::SNAPSHOT_ORDER) || (event.Type == MarketEventType::ADD_ORDER) || (event.Type == MarketEventType::UPDATE_ORDER))
+                orders[event.Id] = event.Quantity;
+            else if (event.Type == MarketEventType::DELETE_ORDER)
+                orders.erase(event.Id);
+        }
+        REQUIRE(orders.size() == market.orders().size());
+        REQUIRE(orders[1] == 6);
+        REQUIRE(orders[3] == 7);
+        REQUIRE(orders.count(120) == 0);
+        REQUIRE(orders[121] == 1);
+        market.DeleteOrder(3);
+        REQUIRE(bids.size() == 2);
+        REQUIRE(bids[99] == 6);
+        REQUIRE(bids[98] == 7);
+        REQUIRE(asks.size() == 5);
+        REQUIRE(asks[101] == 8);
+        REQUIRE(asks[102] == 9);
+    }
+
+    // Snapshot which exceeds the ring capacity is not published
+    SharedMemoryHandler small(name + "-small", 16);
+    REQUIRE(!small.PublishSnapshot(market));
+    REQUIRE(small.ring().sequence() == 0);
+}